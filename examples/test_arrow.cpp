@@ -0,0 +1,269 @@
+// Arrow C Data Interface: экспорт без копирования, импорт и правила release
+#undef NDEBUG
+#include "paradox/arrow.h"
+#include "test_common.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+dspirit_array sample(std::size_t n) {
+    dspirit_array values(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        values.set(k, dspirit_parts{0.5 * static_cast<double>(k), (k % 3 == 0) ? 1.0 : 0.0, 0.0,
+                                    static_cast<double>(k % 2)});
+    }
+    return values;
+}
+
+// Значение метаданных по ключу (формат спецификации, порядок байт платформы)
+std::string metadataValue(const char* metadata, const std::string& key) {
+    if (!metadata) return "";
+    auto readInt = [&metadata]() {
+        std::int32_t v;
+        std::memcpy(&v, metadata, 4);
+        metadata += 4;
+        return v;
+    };
+    const std::int32_t pairs = readInt();
+    for (std::int32_t p = 0; p < pairs; ++p) {
+        const std::int32_t keyLength = readInt();
+        const std::string k(metadata, static_cast<std::size_t>(keyLength));
+        metadata += keyLength;
+        const std::int32_t valueLength = readInt();
+        const std::string v(metadata, static_cast<std::size_t>(valueLength));
+        metadata += valueLength;
+        if (k == key) return v;
+    }
+    return "";
+}
+
+// Столбец float64, собранный вручную, со счётчиком вызовов release
+struct foreign_column {
+    std::vector<double> values;
+    const void* buffers[2] = {nullptr, nullptr};
+    int released = 0;
+};
+
+void releaseForeign(ArrowArray* array) {
+    ++static_cast<foreign_column*>(array->private_data)->released;
+    array->release = nullptr;
+}
+
+ArrowArray foreignArray(foreign_column& column, std::int64_t offset = 0) {
+    column.buffers[1] = column.values.data();
+    ArrowArray array = ArrowArray();
+    array.length = static_cast<std::int64_t>(column.values.size()) - offset;
+    array.offset = offset;
+    array.n_buffers = 2;
+    array.buffers = column.buffers;
+    array.release = releaseForeign;
+    array.private_data = &column;
+    return array;
+}
+
+ArrowSchema float64Schema(const char* name = "") {
+    ArrowSchema schema = ArrowSchema();
+    schema.format = "g";
+    schema.name = name;
+    return schema;
+}
+
+void test_export_struct() {
+    std::cout << "Testing struct export..." << std::endl;
+
+    const std::size_t n = 100;
+    const dspirit_array values = sample(n);
+    ArrowSchema schema;
+    ArrowArray array;
+    arrow::exportArray(values.view(), &schema, &array);
+
+    assert(std::strcmp(schema.format, "+s") == 0 && schema.n_children == 4);
+    assert(metadataValue(schema.metadata, "ARROW:extension:name") == arrow::EXTENSION_NAME);
+    const char* names[] = {"r", "i", "j", "level"};
+    const double* planes[] = {values.view().r, values.view().i, values.view().j, values.view().level};
+    assert(array.length == static_cast<std::int64_t>(n) && array.n_children == 4 && array.null_count == 0);
+    for (int c = 0; c < 4; ++c) {
+        assert(std::strcmp(schema.children[c]->format, "g") == 0);
+        assert(std::strcmp(schema.children[c]->name, names[c]) == 0);
+        // Без копирования: буферы - плоскости массива
+        assert(array.children[c]->buffers[1] == planes[c]);
+        assert(array.children[c]->buffers[0] == nullptr);
+    }
+
+    // Импорт обратно указывает в те же буферы
+    arrow_column column;
+    assert(arrow_column::fromArrow(&array, &schema, column) == status::ok);
+    assert(array.release == nullptr);
+    assert(column.size() == n && column.view().r == planes[0] && column.view().level == planes[3]);
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(column.view()[k], values.parts(k)));
+
+    // Перемещение столбца
+    arrow_column moved(std::move(column));
+    assert(moved.size() == n && column.size() == 0);
+
+    schema.release(&schema);
+    assert(schema.release == nullptr);
+
+    std::cout << "Struct export passed!\n" << std::endl;
+}
+
+void test_export_owned() {
+    std::cout << "Testing owned and plain export..." << std::endl;
+
+    // Массив переходит во владение ArrowArray
+    const std::size_t n = 50;
+    dspirit_array values = sample(n);
+    const double* r = values.view().r;
+    ArrowSchema schema;
+    ArrowArray array;
+    arrow::exportArray(std::move(values), &schema, &array);
+    assert(array.children[0]->buffers[1] == r);
+    {
+        arrow_column column;
+        assert(arrow_column::fromArrow(&array, &schema, column) == status::ok);
+        assert(sameParts(column.view()[7], sample(n).parts(7)));
+    }
+    schema.release(&schema);
+
+    // Только r - обычный float64
+    std::vector<double> plain = {1.0, -2.5, 3.0};
+    arrow::exportArray(const_dspirit_view{plain.data(), nullptr, nullptr, nullptr, plain.size()}, &schema, &array);
+    assert(std::strcmp(schema.format, "g") == 0 && array.n_buffers == 2 && array.buffers[1] == plain.data());
+    {
+        arrow_column column;
+        assert(arrow_column::fromArrow(&array, &schema, column) == status::ok);
+        assert(column.view().isPlain() && sameParts(column.view()[1], dspirit(-2.5).toParts()));
+    }
+    schema.release(&schema);
+
+    // Отсутствующая плоскость экспортируется нулями
+    std::vector<double> level = {1.0, 0.0, -1.0};
+    arrow::exportArray(const_dspirit_view{plain.data(), nullptr, nullptr, level.data(), plain.size()}, &schema, &array);
+    assert(std::strcmp(schema.format, "+s") == 0);
+    assert(static_cast<const double*>(array.children[1]->buffers[1])[2] == 0.0);
+    assert(array.children[3]->buffers[1] == level.data());
+    array.release(&array);
+    schema.release(&schema);
+
+    std::cout << "Owned and plain export passed!\n" << std::endl;
+}
+
+void test_import_foreign() {
+    std::cout << "Testing foreign arrays..." << std::endl;
+
+    // Смещение учитывается, release вызывается один раз - деструктором
+    foreign_column source;
+    source.values = {10.0, 20.0, 30.0, 40.0};
+    ArrowArray array = foreignArray(source, 1);
+    const ArrowSchema schema = float64Schema();
+    {
+        arrow_column column;
+        assert(arrow_column::fromArrow(&array, &schema, column) == status::ok);
+        assert(column.size() == 3 && sameParts(column.view()[0], dspirit(20.0).toParts()));
+        assert(source.released == 0);
+    }
+    assert(source.released == 1);
+
+    // Повторный импорт в тот же столбец освобождает предыдущий массив
+    foreign_column first, second;
+    first.values = {1.0};
+    second.values = {2.0};
+    ArrowArray a = foreignArray(first), b = foreignArray(second);
+    {
+        arrow_column column;
+        assert(arrow_column::fromArrow(&a, &schema, column) == status::ok);
+        assert(arrow_column::fromArrow(&b, &schema, column) == status::ok);
+        assert(first.released == 1 && second.released == 0);
+    }
+    assert(second.released == 1);
+
+    // Дочерние столбцы struct сопоставляются по именам, не по порядку
+    foreign_column planes[4];
+    ArrowArray children[4];
+    ArrowArray* childPointers[4];
+    ArrowSchema childSchemas[4];
+    ArrowSchema* childSchemaPointers[4];
+    const char* order[] = {"level", "r", "j", "i"};
+    const double values[] = {1.0, 7.0, 0.0, 2.0};
+    for (int c = 0; c < 4; ++c) {
+        planes[c].values = {values[c], values[c]};
+        children[c] = foreignArray(planes[c]);
+        childPointers[c] = &children[c];
+        childSchemas[c] = float64Schema(order[c]);
+        childSchemaPointers[c] = &childSchemas[c];
+    }
+    foreign_column parent;
+    ArrowArray structArray = foreignArray(parent);
+    structArray.length = 2;
+    structArray.n_buffers = 1;
+    structArray.n_children = 4;
+    structArray.children = childPointers;
+    ArrowSchema structSchema = ArrowSchema();
+    structSchema.format = "+s";
+    structSchema.n_children = 4;
+    structSchema.children = childSchemaPointers;
+    {
+        arrow_column column;
+        assert(arrow_column::fromArrow(&structArray, &structSchema, column) == status::ok);
+        assert(sameParts(column.view()[1], dspirit_parts{7.0, 2.0, 0.0, 1.0}));
+    }
+    assert(parent.released == 1);
+
+    std::cout << "Foreign arrays passed!\n" << std::endl;
+}
+
+void test_import_rejected() {
+    std::cout << "Testing rejected imports..." << std::endl;
+
+    foreign_column source;
+    source.values = {1.0, 2.0};
+    ArrowArray array = foreignArray(source);
+    arrow_column column;
+
+    // Другой тип
+    ArrowSchema schema = float64Schema();
+    schema.format = "f";
+    assert(arrow_column::fromArrow(&array, &schema, column) == status::invalid_argument);
+
+    // Значения null
+    schema = float64Schema();
+    array.null_count = 1;
+    assert(arrow_column::fromArrow(&array, &schema, column) == status::invalid_argument);
+    array.null_count = 0;
+
+    // Уже освобождённый массив и пустые указатели
+    ArrowArray released = array;
+    released.release = nullptr;
+    assert(arrow_column::fromArrow(&released, &schema, column) == status::invalid_argument);
+    assert(arrow_column::fromArrow(nullptr, &schema, column) == status::invalid_argument);
+
+    // При ошибке массив остаётся у вызывающего
+    assert(array.release != nullptr && source.released == 0 && column.size() == 0);
+    array.release(&array);
+    assert(source.released == 1);
+
+    std::cout << "Rejected imports passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing Arrow interface ===\n" << std::endl;
+
+    test_export_struct();
+    test_export_owned();
+    test_import_foreign();
+    test_import_rejected();
+
+    std::cout << "=== All Arrow interface tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Пакетные функции с обычным путём против поэлементных ядер
+#undef NDEBUG
+#include "paradox/dspirit_array.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+const std::size_t N = 1000;  // несколько блоков и неполный хвост
+
+// Обычные числа от 1e-300 до 1e300 обоих знаков
+std::vector<double> plainValues(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> exponent(-300.0, 300.0);
+    std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+    std::vector<double> values(N);
+    for (std::size_t k = 0; k < N; ++k) {
+        const double v = mantissa(rng) * std::pow(10.0, (k % 3 == 0) ? exponent(rng) : exponent(rng) / 100.0);
+        values[k] = (rng() & 1) ? v : -v;
+    }
+    // Точки на границах областей и переполнение
+    values[1] = -1.0;
+    values[2] = -2.5;
+    values[3] = 800.0;
+    values[4] = -800.0;
+    return values;
+}
+
+// Те же числа и вкрапления нулей, бесконечностей и подуровней
+dspirit_array mixedValues(const std::vector<double>& plain) {
+    const double super_zero = -std::numeric_limits<double>::infinity();
+    const dspirit_parts special[] = {
+        {1.0, 0.0, 0.0, -1.0}, {-1.0, 0.0, 0.0, 1.0}, {1.0, 0.0, 0.0, super_zero},
+        {2.0, 0.5, 0.25, 0.0}, {3.0, 1.0, 0.0, 1.0}, {0.5, 0.0, 2.0, -1.0}};
+    dspirit_array values(plain);
+    for (std::size_t k = 0; k < N; k += 37) values.set(k, special[(k / 37) % 6]);
+    return values;
+}
+
+template <class Batch, class Kernel>
+void checkUnary(const char* name, const_dspirit_view x, Batch batch, Kernel kernel) {
+    dspirit_array out(x.size);
+    std::vector<std::uint64_t> failed(statusWords(x.size));
+    const std::size_t count = batch(x, out.view(), failed.data());
+
+    std::size_t expected = 0;
+    for (std::size_t k = 0; k < x.size; ++k) {
+        dspirit_parts value;
+        const bool ok = (kernel(x[k], value) == status::ok);
+        const bool bit = (failed[k / 64] >> (k % 64)) & 1;
+        assert(ok != bit);
+        if (ok) {
+            if (!sameParts(out.parts(k), value)) {
+                std::cerr << name << " differs at " << k << std::endl;
+                assert(false);
+            }
+        } else {
+            ++expected;
+            assert(std::isnan(out.parts(k).r));
+        }
+    }
+    assert(count == expected);
+
+    // Результат на месте входа
+    dspirit_array inPlace(x);
+    assert(batch(inPlace.view(), inPlace.view(), nullptr) == count);
+    for (std::size_t k = 0; k < x.size; ++k) assert(sameParts(inPlace.parts(k), out.parts(k)));
+}
+
+template <class Batch, class Kernel>
+void checkBinary(const char* name, const_dspirit_view a, const_dspirit_view b, Batch batch, Kernel kernel) {
+    dspirit_array out(a.size);
+    batch(a, b, out.view());
+    for (std::size_t k = 0; k < a.size; ++k) {
+        if (!sameParts(out.parts(k), kernel(a[k], b[k]))) {
+            std::cerr << name << " differs at " << k << std::endl;
+            assert(false);
+        }
+    }
+}
+
+void check_all(const char* what, const_dspirit_view x, const_dspirit_view y) {
+    std::cout << "Testing batch functions on " << what << "..." << std::endl;
+
+    using kernel_fn = status (*)(const dspirit_parts&, dspirit_parts&) noexcept;
+    using batch_fn = std::size_t (*)(const_dspirit_view, dspirit_view, std::uint64_t*);
+    const struct {
+        const char* name;
+        batch_fn batch;
+        kernel_fn kernel;
+    } unary[] = {
+        {"sinh", batch::sinh, kernel::sinh},    {"cosh", batch::cosh, kernel::cosh},
+        {"tanh", batch::tanh, kernel::tanh},    {"cbrt", batch::cbrt, kernel::cbrt},
+        {"erf", batch::erf, kernel::erf},       {"log1p", batch::log1p, kernel::log1p},
+        {"expm1", batch::expm1, kernel::expm1}};
+    for (const auto& f : unary) checkUnary(f.name, x, f.batch, f.kernel);
+
+    using binary_fn = dspirit_parts (*)(const dspirit_parts&, const dspirit_parts&);
+    checkBinary("atan2", x, y, batch::atan2, static_cast<binary_fn>(kernel::atan2));
+    checkBinary("hypot", x, y, batch::hypot, static_cast<binary_fn>(kernel::hypot));
+
+    std::cout << "Batch functions on " << what << " passed!\n" << std::endl;
+}
+
+// Операнд-число против массива из его повторений
+void check_scalar_operand(const dspirit_array& x) {
+    std::cout << "Testing scalar operands..." << std::endl;
+
+    using array_fn = void (*)(const_dspirit_view, const_dspirit_view, dspirit_view);
+    using right_fn = void (*)(const_dspirit_view, const dspirit_parts&, dspirit_view);
+    using left_fn = void (*)(const dspirit_parts&, const_dspirit_view, dspirit_view);
+    const struct {
+        array_fn array;
+        right_fn right;
+        left_fn left;
+    } ops[] = {{batch::add, batch::add, batch::add},
+               {batch::subtract, batch::subtract, batch::subtract},
+               {batch::multiply, batch::multiply, batch::multiply},
+               {batch::divide, batch::divide, batch::divide}};
+    const dspirit scalars[] = {dspirit(2.5), dspirit::ZERO, dspirit::INF, dspirit::fromParts({1.5, 0.5, 0.0, 1.0})};
+
+    dspirit_array expected(x.size()), out(x.size());
+    for (const auto& op : ops) {
+        for (const dspirit& s : scalars) {
+            const dspirit_array repeated(x.size(), s);
+            op.array(x, repeated, expected);
+            op.right(x, s.toParts(), out);
+            for (std::size_t k = 0; k < x.size(); ++k) assert(sameParts(out.parts(k), expected.parts(k)));
+            op.array(repeated, x, expected);
+            op.left(s.toParts(), x, out);
+            for (std::size_t k = 0; k < x.size(); ++k) assert(sameParts(out.parts(k), expected.parts(k)));
+
+            // На месте входа
+            dspirit_array inPlace(x);
+            op.left(s.toParts(), inPlace, inPlace);
+            for (std::size_t k = 0; k < x.size(); ++k) assert(sameParts(inPlace.parts(k), expected.parts(k)));
+        }
+    }
+
+    std::cout << "Scalar operands passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing batch math fast path ===\n" << std::endl;
+
+    std::mt19937_64 rng(42);
+    std::vector<double> xs = plainValues(rng);
+    std::vector<double> ys = plainValues(rng);
+
+    // Только плоскость r
+    check_all("plain columns", const_dspirit_view{xs.data(), nullptr, nullptr, nullptr, N},
+              const_dspirit_view{ys.data(), nullptr, nullptr, nullptr, N});
+
+    // Все плоскости, уровни 0
+    const dspirit_array x(xs), y(ys);
+    check_all("plain arrays", x.view(), y.view());
+
+    // Блоки с нулями, бесконечностями и подуровнями
+    const dspirit_array mx = mixedValues(xs), my = mixedValues(ys);
+    check_all("mixed arrays", mx.view(), my.view());
+    check_scalar_operand(mx);
+
+    // Отношение ниже обычных чисел: |x| без поправки 1.414
+    const dspirit h = hypot(dspirit(1e300), dspirit(1e-300));
+    assert(h.toParts().r == 1e300 && h.toParts().level == 0.0);
+
+    std::cout << "=== All batch math tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Двоичный формат: чтение записанного и счётчик в блоке end
+#undef NDEBUG
+#include "paradox/binary.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace paradox;
+
+namespace {
+
+const std::size_t N = 10000;  // несколько блоков plain и full
+
+dspirit_array sample() {
+    dspirit_array values(N);
+    for (std::size_t k = 0; k < N; ++k) {
+        if (k % 1000 < 600) values.set(k, dspirit(0.25 * static_cast<double>(k) - 7.0));
+        else values.set(k, dspirit_parts{1.5, 0.5 * static_cast<double>(k), -2.0, static_cast<double>(k % 3) - 1.0});
+    }
+    return values;
+}
+
+void put32(std::string& bytes, std::size_t at, std::uint32_t v) {
+    for (int k = 0; k < 4; ++k) bytes[at + k] = static_cast<char>((v >> (8 * k)) & 0xFF);
+}
+
+std::uint32_t get32(const std::string& bytes, std::size_t at) {
+    std::uint32_t v = 0;
+    for (int k = 0; k < 4; ++k) v |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[at + k])) << (8 * k);
+    return v;
+}
+
+bool readsBack(const std::string& bytes) {
+    std::istringstream in(bytes);
+    try {
+        return readBinary(in).size() == N;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+void test_round_trip() {
+    std::cout << "Testing round trip..." << std::endl;
+
+    const dspirit_array values = sample();
+    std::ostringstream out;
+    writeBinary(out, values.view());
+    std::istringstream in(out.str());
+    const dspirit_array back = readBinary(in);
+
+    assert(back.size() == N);
+    for (std::size_t k = 0; k < N; ++k) {
+        const dspirit_parts a = values.parts(k), b = back.parts(k);
+        assert(a.r == b.r && a.i == b.i && a.j == b.j && a.level == b.level);
+    }
+
+    std::cout << "Round trip passed!\n" << std::endl;
+}
+
+void test_end_count() {
+    std::cout << "Testing end block count..." << std::endl;
+
+    const dspirit_array values = sample();
+    std::ostringstream out;
+    writeBinary(out, values.view());
+    const std::string bytes = out.str();
+
+    // Блок end - последние 16 байт: тип 3, счётчик младшими и старшими словами
+    const std::size_t end = bytes.size() - 16;
+    assert(get32(bytes, 4) == 1);  // версия
+    assert(get32(bytes, end) == 3);
+    assert(get32(bytes, end + 4) == N);
+    assert(get32(bytes, end + 12) == 0);
+    assert(readsBack(bytes));
+
+    // Старшее слово сверяется: 2^32 + N значений - не N
+    std::string wide = bytes;
+    put32(wide, end + 12, 1);
+    assert(!readsBack(wide));
+
+    // Другие версии не читаются
+    std::string v2 = bytes;
+    v2[4] = 2;
+    assert(!readsBack(v2));
+
+    std::cout << "End block count passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing binary format ===\n" << std::endl;
+
+    test_round_trip();
+    test_end_count();
+
+    std::cout << "=== All binary format tests passed! ===" << std::endl;
+    return 0;
+}
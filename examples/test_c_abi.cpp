@@ -0,0 +1,255 @@
+// C ABI: скалярные и пакетные функции против dspirit и kernel
+#undef NDEBUG
+#include "paradox/paradox_c.h"
+#include "paradox/dspirit.h"
+#include "paradox/kernel.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+dspirit_parts parts(const paradox_value& x) {
+    return {x.r, x.i, x.j, x.level};
+}
+
+dspirit toDspirit(const paradox_value& x) {
+    return dspirit::fromParts(parts(x));
+}
+
+bool sameValue(const paradox_value& a, const dspirit_parts& b) {
+    return sameParts(parts(a), b);
+}
+
+bool sameValue(const paradox_value& a, const dspirit& b) {
+    return sameValue(a, b.toParts());
+}
+
+// Уровни, подуровни, отрицательные и вне области определения
+std::vector<paradox_value> sample() {
+    std::vector<paradox_value> values;
+    for (int k = 0; k < 40; ++k) {
+        const double r = 0.375 * (k - 17);
+        dspirit_parts p = dspirit(r).toParts();
+        if (k % 5 == 1) p = dspirit::fromLevel(r == 0.0 ? 1.0 : r, (k % 3) - 1.0).toParts();
+        if (k % 7 == 2) p = {1.5, 0.5, -0.25, 0.0};
+        values.push_back({p.r, p.i, p.j, p.level});
+    }
+    return values;
+}
+
+status reference(paradox_function fn, const dspirit_parts& x, dspirit_parts& out) {
+    switch (fn) {
+    case PARADOX_SQRT: return kernel::sqrt(x, out);
+    case PARADOX_EXP: return kernel::exp(x, out);
+    case PARADOX_LOG: return kernel::log(x, out);
+    case PARADOX_SIN: return kernel::sin(x, out);
+    case PARADOX_COS: return kernel::cos(x, out);
+    case PARADOX_TAN: return kernel::tan(x, out);
+    case PARADOX_SINH: return kernel::sinh(x, out);
+    case PARADOX_COSH: return kernel::cosh(x, out);
+    case PARADOX_TANH: return kernel::tanh(x, out);
+    case PARADOX_CBRT: return kernel::cbrt(x, out);
+    case PARADOX_ERF: return kernel::erf(x, out);
+    case PARADOX_LOG1P: return kernel::log1p(x, out);
+    case PARADOX_EXPM1: return kernel::expm1(x, out);
+    case PARADOX_ABS: out = kernel::abs(x); return status::ok;
+    case PARADOX_INVERSE: out = kernel::inverse(x); return status::ok;
+    }
+    return status::invalid_argument;
+}
+
+void test_scalar() {
+    std::cout << "Testing scalar functions..." << std::endl;
+
+    assert(paradox_abi_version() == PARADOX_C_ABI_VERSION);
+    assert(sameValue(paradox_from_double(2.5), dspirit(2.5)));
+    assert(sameValue(paradox_from_double(0.0), dspirit::ZERO));
+    assert(sameValue(paradox_from_level(3.0, 2.0), dspirit::fromLevel(3.0, 2.0)));
+    assert(paradox_to_double(paradox_from_double(-4.0)) == -4.0);
+
+    const std::vector<paradox_value> x = sample();
+    for (const paradox_value& a : x) {
+        const dspirit da = toDspirit(a);
+        assert(sameValue(paradox_neg(a), -da));
+        for (const paradox_value& b : x) {
+            const dspirit db = toDspirit(b);
+            assert(sameValue(paradox_add(a, b), da + db));
+            assert(sameValue(paradox_sub(a, b), da - db));
+            assert(sameValue(paradox_mul(a, b), da * db));
+            assert(sameValue(paradox_div(a, b), da / db));
+            const int32_t c = paradox_compare(a, b);
+            assert(c == (da < db ? -1 : (db < da ? 1 : 0)));
+        }
+    }
+
+    // Функции и ошибки области определения
+    paradox_value out;
+    for (paradox_function fn = PARADOX_SQRT; fn <= PARADOX_INVERSE; ++fn) {
+        for (const paradox_value& a : x) {
+            dspirit_parts expected;
+            const status s = reference(fn, parts(a), expected);
+            assert(paradox_apply(fn, a, &out) == static_cast<paradox_status>(s));
+            if (s == status::ok) assert(sameValue(out, expected));
+        }
+    }
+    assert(paradox_apply(PARADOX_SQRT, paradox_from_double(-1.0), &out) == PARADOX_DOMAIN_ERROR);
+    assert(paradox_apply(99, x[0], &out) == PARADOX_INVALID_ARGUMENT);
+    assert(paradox_apply(PARADOX_SQRT, x[0], nullptr) == PARADOX_INVALID_ARGUMENT);
+    assert(paradox_pow(paradox_from_double(2.0), 10.0, &out) == PARADOX_OK && sameValue(out, dspirit(1024.0)));
+    assert(paradox_pow(paradox_from_double(-8.0), 1.0 / 3.0, &out) == PARADOX_DOMAIN_ERROR);
+
+    std::cout << "Scalar functions passed!\n" << std::endl;
+}
+
+void test_text() {
+    std::cout << "Testing text..." << std::endl;
+
+    paradox_value v;
+    const char text[] = "2@1";
+    assert(paradox_parse(text, std::strlen(text), &v) == PARADOX_OK && sameValue(v, dspirit::fromLevel(2.0, 1.0)));
+    assert(paradox_parse("2@1x", 4, &v) == PARADOX_INVALID_ARGUMENT);  // не целиком
+    assert(paradox_parse("", 0, &v) == PARADOX_INVALID_ARGUMENT);
+    assert(paradox_parse(nullptr, 3, &v) == PARADOX_INVALID_ARGUMENT);
+
+    // Запись и разбор обратно без потерь
+    char buffer[PARADOX_MAX_CHARS];
+    size_t length = 0;
+    const paradox_value x = {1.0 / 3.0, 0.25, -2.0, 1.0};
+    assert(paradox_format_value(x, PARADOX_FORMAT_LOSSLESS, buffer, sizeof buffer, &length) == PARADOX_OK);
+    assert(length == std::strlen(buffer));
+    assert(paradox_parse(buffer, length, &v) == PARADOX_OK && sameValue(v, parts(x)));
+    assert(paradox_format_value(x, PARADOX_FORMAT_COMPACT, buffer, sizeof buffer, nullptr) == PARADOX_OK);
+
+    // Мал буфер, неизвестный формат
+    assert(paradox_format_value(x, PARADOX_FORMAT_LOSSLESS, buffer, 3, &length) == PARADOX_INVALID_ARGUMENT);
+    assert(paradox_format_value(x, 7, buffer, sizeof buffer, &length) == PARADOX_INVALID_ARGUMENT);
+
+    std::cout << "Text passed!\n" << std::endl;
+}
+
+void test_batch() {
+    std::cout << "Testing batch entry points..." << std::endl;
+
+    const std::vector<paradox_value> a = sample();
+    std::vector<paradox_value> b(a.rbegin(), a.rend());
+    const std::vector<paradox_value> c(a.size(), paradox_from_double(0.5));
+    const size_t n = a.size();
+    std::vector<paradox_value> out(n);
+
+    // Совпадают со скалярными
+    assert(paradox_neg_n(a.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], parts(paradox_neg(a[k]))));
+    assert(paradox_add_n(a.data(), b.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], parts(paradox_add(a[k], b[k]))));
+    assert(paradox_sub_n(a.data(), b.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], parts(paradox_sub(a[k], b[k]))));
+    assert(paradox_mul_n(a.data(), b.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], parts(paradox_mul(a[k], b[k]))));
+    assert(paradox_div_n(a.data(), b.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], parts(paradox_div(a[k], b[k]))));
+    assert(paradox_fma_n(a.data(), b.data(), c.data(), out.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], fma(toDspirit(a[k]), toDspirit(b[k]), toDspirit(c[k]))));
+
+    std::vector<int8_t> order(n);
+    assert(paradox_compare_n(a.data(), b.data(), order.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(order[k] == paradox_compare(a[k], b[k]));
+
+    // Выход совпадает со входом
+    std::vector<paradox_value> in_place = a;
+    assert(paradox_mul_n(in_place.data(), b.data(), in_place.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(in_place[k], parts(paradox_mul(a[k], b[k]))));
+
+    // Функции: ошибочные элементы - NaN уровня 0 и счётчик
+    for (paradox_function fn = PARADOX_SQRT; fn <= PARADOX_INVERSE; ++fn) {
+        size_t failed = 12345;
+        const paradox_status s = paradox_apply_n(fn, a.data(), out.data(), n, &failed);
+        size_t expected_failed = 0;
+        for (size_t k = 0; k < n; ++k) {
+            paradox_value one;
+            if (paradox_apply(fn, a[k], &one) == PARADOX_OK) {
+                assert(sameValue(out[k], parts(one)));
+            } else {
+                assert(std::isnan(out[k].r) && out[k].level == 0.0);
+                ++expected_failed;
+            }
+        }
+        assert(failed == expected_failed);
+        assert(s == (expected_failed == 0 ? PARADOX_OK : PARADOX_DOMAIN_ERROR));
+    }
+    assert(paradox_apply_n(99, a.data(), out.data(), n, nullptr) == PARADOX_INVALID_ARGUMENT);
+    size_t failed = 0;
+    assert(paradox_pow_n(a.data(), 0.5, out.data(), n, &failed) == PARADOX_DOMAIN_ERROR && failed > 0);
+    assert(paradox_pow_n(a.data(), 2.0, out.data(), n, nullptr) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(out[k], pow(toDspirit(a[k]), 2.0)));
+
+    // NULL допустим только при n == 0
+    assert(paradox_add_n(nullptr, nullptr, nullptr, 0) == PARADOX_OK);
+    assert(paradox_add_n(a.data(), nullptr, out.data(), n) == PARADOX_INVALID_ARGUMENT);
+    assert(paradox_apply_n(PARADOX_EXP, nullptr, out.data(), 1, nullptr) == PARADOX_INVALID_ARGUMENT);
+
+    std::cout << "Batch entry points passed!\n" << std::endl;
+}
+
+void test_reductions_and_planes() {
+    std::cout << "Testing reductions and planes..." << std::endl;
+
+    const std::vector<paradox_value> x = sample();
+    const size_t n = x.size();
+    paradox_value out;
+
+    dspirit sum(0.0), product(1.0);
+    for (const paradox_value& v : x) {
+        sum = sum + toDspirit(v);
+        product = product * toDspirit(v);
+    }
+    assert(paradox_sum_n(x.data(), n, &out) == PARADOX_OK && sameValue(out, sum));
+    assert(paradox_product_n(x.data(), n, &out) == PARADOX_OK && sameValue(out, product));
+    assert(paradox_sum_n(nullptr, 0, &out) == PARADOX_OK && sameValue(out, dspirit(0.0)));
+    assert(paradox_product_n(nullptr, 0, &out) == PARADOX_OK && sameValue(out, dspirit(1.0)));
+
+    size_t index = n;
+    assert(paradox_min_n(x.data(), n, &out, &index) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(paradox_compare(x[k], out) >= 0);
+    for (size_t k = 0; k < index; ++k) assert(paradox_compare(x[k], out) > 0);
+    assert(paradox_max_n(x.data(), n, &out, &index) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(paradox_compare(x[k], out) <= 0);
+    assert(paradox_max_n(x.data(), 0, &out, &index) == PARADOX_INVALID_ARGUMENT);
+
+    // double и плоскости туда и обратно
+    std::vector<double> r(n), i(n), j(n), level(n);
+    assert(paradox_to_planes(x.data(), r.data(), i.data(), j.data(), level.data(), n) == PARADOX_OK);
+    std::vector<paradox_value> back(n);
+    assert(paradox_from_planes(r.data(), i.data(), j.data(), level.data(), back.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(back[k], parts(x[k])));
+
+    std::vector<double> doubles(n);
+    assert(paradox_to_doubles(x.data(), doubles.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(same(doubles[k], toDspirit(x[k]).toDouble()));
+    assert(paradox_from_doubles(r.data(), back.data(), n) == PARADOX_OK);
+    assert(paradox_from_planes(r.data(), nullptr, nullptr, nullptr, back.data(), n) == PARADOX_OK);
+    for (size_t k = 0; k < n; ++k) assert(sameValue(back[k], dspirit(r[k])));
+
+    std::cout << "Reductions and planes passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing C ABI ===\n" << std::endl;
+
+    test_scalar();
+    test_text();
+    test_batch();
+    test_reductions_and_planes();
+
+    std::cout << "=== All C ABI tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,94 @@
+// cell_graph: малые и подуровневые изменения доходят до потомков
+#undef NDEBUG
+#include "paradox/cells.h"
+#include "test_common.h"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+dspirit twice(const std::vector<dspirit>& args) {
+    return args[0] * dspirit(2.0);
+}
+
+void test_small_updates() {
+    std::cout << "Testing tiny and sub-level updates..." << std::endl;
+
+    cell_graph g;
+    const cell_graph::cell_id x = g.addInput(dspirit(1e-20));
+    const cell_graph::cell_id y = g.addFormula(twice, {x});
+    std::size_t changes = 0;
+    g.onChange([&](cell_graph::cell_id, const dspirit&) { ++changes; });
+
+    // 5e-20 == 1e-20 по допуску operator==, но значение другое
+    g.setInput(x, dspirit(5e-20));
+    assert(sameParts(g.value(x), dspirit(5e-20)));
+    assert(g.recompute() == 1);
+    assert(sameParts(g.value(y), dspirit(1e-19)));
+
+    // Изменение только в подуровне i
+    g.setInput(x, dspirit::fromParts({1.0, 0.0, 0.0, 0.0}));
+    g.recompute();
+    g.setInput(x, dspirit::fromParts({1.0, 1e-3, 0.0, 0.0}));
+    assert(g.recompute() == 1);
+    assert(sameParts(g.value(y), dspirit::fromParts({2.0, 2e-3, 0.0, 0.0})));
+
+    // Смена уровня при том же r
+    g.setInput(x, dspirit::fromLevel(1.0, -1.0));
+    g.recompute();
+    g.setInput(x, dspirit::fromLevel(1.0, -2.0));
+    assert(g.recompute() == 1);
+    assert(sameParts(g.value(y), dspirit::fromLevel(2.0, -2.0)));
+    assert(changes == 10);
+
+    // То же значение: потомки не пересчитываются
+    g.setInput(x, dspirit::fromLevel(1.0, -2.0));
+    assert(!g.isDirty(y) && g.recompute() == 0);
+    assert(changes == 10);
+
+    std::cout << "Tiny and sub-level updates passed!\n" << std::endl;
+}
+
+void test_early_cutoff() {
+    std::cout << "Testing early cutoff..." << std::endl;
+
+    // Знак не меняется: ячейка после него не пересчитывается
+    cell_graph g;
+    const cell_graph::cell_id x = g.addInput(dspirit(2.0));
+    const cell_graph::cell_id sign = g.addFormula([](const std::vector<dspirit>& args) {
+        return args[0].isNegative() ? dspirit::NEG_ONE : dspirit::ONE;
+    }, {x});
+    const cell_graph::cell_id y = g.addFormula(twice, {sign});
+    g.setInput(x, dspirit(3.0));
+    assert(g.recompute() == 1);
+    g.setInput(x, dspirit(-3.0));
+    assert(g.recompute() == 2);
+    assert(sameParts(g.value(y), dspirit(-2.0)));
+
+    // Новый результат формулы, равный старому по ==, тоже сохраняется
+    const cell_graph::cell_id z = g.addInput(dspirit(1e-20));
+    const cell_graph::cell_id w = g.addFormula(twice, {z});
+    const cell_graph::cell_id v = g.addFormula(twice, {w});
+    g.setInput(z, dspirit(3e-20));
+    assert(g.recompute() == 2);
+    assert(sameParts(g.value(w), dspirit(6e-20)));
+    assert(sameParts(g.value(v), dspirit(1.2e-19)));
+
+    std::cout << "Early cutoff passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing cell graph ===\n" << std::endl;
+
+    test_small_updates();
+    test_early_cutoff();
+
+    std::cout << "=== All cell graph tests passed! ===" << std::endl;
+    return 0;
+}
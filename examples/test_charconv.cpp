@@ -0,0 +1,117 @@
+// Текстовые форматы: to_chars -> from_chars без потерь
+#undef NDEBUG
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+std::string format(const dspirit& value, text_format f) {
+    char buffer[dspirit::MAX_CHARS];
+    const std::to_chars_result res = value.to_chars(buffer, buffer + sizeof buffer, f);
+    assert(res.ec == std::errc());
+    return std::string(buffer, res.ptr);
+}
+
+// Запись и чтение обратно; текст должен разбираться целиком
+dspirit_parts roundTrip(const dspirit& value, text_format f) {
+    const std::string text = format(value, f);
+    dspirit parsed;
+    const std::from_chars_result res = dspirit::from_chars(text, parsed);
+    if (res.ec != std::errc() || res.ptr != text.data() + text.size()) {
+        std::cerr << "cannot parse " << text << std::endl;
+        assert(false);
+    }
+    return parsed.toParts();
+}
+
+void checkRoundTrip(const dspirit& value) {
+    const dspirit_parts p = value.toParts();
+    if (!sameParts(roundTrip(value, text_format::lossless), p)) {
+        std::cerr << "lossless round trip failed: " << format(value, text_format::lossless) << std::endl;
+        assert(false);
+    }
+    if (p.i == 0.0 && p.j == 0.0) assert(sameParts(roundTrip(value, text_format::shortest), p));
+}
+
+void test_random_values() {
+    std::cout << "Testing 200k random values..." << std::endl;
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-300, 300);
+    const double levels[] = {0.0, 1.0, -1.0, 2.0, -2.0, 0.5, -1.5, 3.25,
+                             std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    auto component = [&]() { return std::ldexp(mantissa(rng), exponent(rng)); };
+
+    for (int k = 0; k < 200000; ++k) {
+        const double r = component();
+        const double i = (k % 3 == 0) ? 0.0 : component();
+        const double j = (k % 5 == 0) ? 0.0 : component();
+        const double level = levels[rng() % 10];
+        checkRoundTrip(dspirit::fromParts({r, i, j, level}));
+    }
+
+    std::cout << "Random values passed!\n" << std::endl;
+}
+
+void test_special_values() {
+    std::cout << "Testing special values..." << std::endl;
+
+    checkRoundTrip(dspirit::ZERO);
+    checkRoundTrip(dspirit::INF);
+    checkRoundTrip(dspirit::NEG_INF);
+    checkRoundTrip(dspirit::EPSILON);
+    checkRoundTrip(dspirit::fromLevel(-1.0, 2.0));
+    checkRoundTrip(dspirit::fromLevel(1.0, -3.0));
+    checkRoundTrip(dspirit(1.0) - dspirit(1.0));
+
+    std::cout << "Special values passed!\n" << std::endl;
+}
+
+void test_nan() {
+    std::cout << "Testing NaN..." << std::endl;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    checkRoundTrip(dspirit::fromParts({nan, 0.0, 0.0, 0.0}));
+    checkRoundTrip(dspirit::fromParts({nan, 0.0, 0.0, 2.0}));
+    checkRoundTrip(dspirit::fromParts({1.0, nan, 0.5, 0.0}));
+
+    dspirit value;
+    assert(dspirit::from_chars("nan", value).ec == std::errc());
+    assert(std::isnan(value.toParts().r) && value.toParts().level == 0.0);
+    assert(dspirit::from_chars("-NaN@1", value).ec == std::errc());
+    assert(std::isnan(value.toParts().r) && value.toParts().level == 1.0);
+    assert(dspirit::from_chars("na", value).ec == std::errc::invalid_argument);
+
+    // Ошибочные элементы пакетных функций
+    dspirit_array x = {-1.0, 4.0};
+    dspirit_array out(2);
+    assert(batch::sqrt(x.view(), out.view()) == 1);
+    checkRoundTrip(out[0]);
+    checkRoundTrip(out[1]);
+
+    std::cout << "NaN passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing text round trip ===\n" << std::endl;
+
+    test_random_values();
+    test_special_values();
+    test_nan();
+
+    std::cout << "=== All text round trip tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+// circuit_solver: закон Кирхгофа, идеальные перемычки и разрывы, update
+#undef NDEBUG
+#include "paradox/circuit.h"
+#include "test_common.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+double current(const circuit& c, const circuit_solver& s, const std::string& name) {
+    return standard(s.current(c, c.findElement(name)));
+}
+
+// Наибольшая сумма токов в узле относительно наибольшего тока элемента
+double kirchhoffResidual(const circuit& c, const circuit_solver& s) {
+    std::vector<double> sums(c.nodeCount(), 0.0);
+    double scale = 0.0;
+    for (std::size_t e = 0; e < c.elementCount(); ++e) {
+        const double i = standard(s.current(c, e));
+        assert(std::isfinite(i));
+        sums[c.element(e).positive] += i;
+        sums[c.element(e).negative] -= i;
+        scale = std::max(scale, std::abs(i));
+    }
+    double worst = 0.0;
+    for (double sum : sums) worst = std::max(worst, std::abs(sum));
+    return worst / scale;
+}
+
+// Сетка side x side: резисторы 1..10 кОм, каждое 17-е ребро - перемычка
+// R = 0, каждое 23-е - разрыв; источник напряжения и токи в углах
+circuit grid(std::size_t side, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> resistance(1e3, 1e4);
+    circuit c;
+    auto node = [&](std::size_t x, std::size_t y) {
+        return c.node("n" + std::to_string(x) + "_" + std::to_string(y));
+    };
+    std::size_t edge = 0;
+    auto link = [&](std::size_t a, std::size_t b) {
+        ++edge;
+        dspirit r(resistance(rng));
+        if (edge % 17 == 0) r = dspirit(0.0);
+        else if (edge % 23 == 0) r = dspirit::INF;
+        c.resistor("R" + std::to_string(edge), a, b, r);
+    };
+    for (std::size_t x = 0; x < side; ++x) {
+        for (std::size_t y = 0; y < side; ++y) {
+            if (x + 1 < side) link(node(x, y), node(x + 1, y));
+            if (y + 1 < side) link(node(x, y), node(x, y + 1));
+        }
+    }
+    c.resistor("Rg", node(side - 1, side - 1), circuit::GROUND, dspirit(100.0));
+    c.voltageSource("V1", node(0, 0), circuit::GROUND, dspirit(5.0));
+    c.currentSource("I1", circuit::GROUND, node(side - 1, 0), dspirit(1e-3));
+    c.currentSource("I2", node(0, side - 1), circuit::GROUND, dspirit(2e-3));
+    return c;
+}
+
+void test_kirchhoff() {
+    std::cout << "Testing Kirchhoff's current law on a grid with shorts..." << std::endl;
+
+    std::mt19937_64 rng(50);
+    circuit c = grid(40, rng);
+    circuit_solver s(c);
+    assert(kirchhoffResidual(c, s) < 1e-12);
+
+    // Новые значения той же топологии
+    std::uniform_real_distribution<double> resistance(1e3, 1e4);
+    for (std::size_t e = 0; e < c.elementCount(); ++e) {
+        const circuit_element& element = c.element(e);
+        if (element.type == circuit_element_type::resistor && element.value.isFinite()) {
+            c.setValue(e, dspirit(resistance(rng)));
+        }
+    }
+    s.update(c);
+    assert(kirchhoffResidual(c, s) < 1e-12);
+
+    std::cout << "Kirchhoff's law passed!\n" << std::endl;
+}
+
+void test_chain_of_shorts() {
+    std::cout << "Testing a chain of shorts..." << std::endl;
+
+    const circuit c = circuit::parse(
+        "V1 a 0 5\n"
+        "R1 a b 0\n"
+        "R2 b c 0\n"
+        "R3 c d 0\n"
+        "R4 d 0 10\n"
+        "R5 b 0 5\n");
+    const circuit_solver s(c);
+    assert(std::abs(standard(s.voltage(c.findNode("d"))) - 5.0) < 1e-14);
+    assert(std::abs(current(c, s, "R1") - 1.5) < 1e-14);
+    assert(std::abs(current(c, s, "R2") - 0.5) < 1e-14);
+    assert(std::abs(current(c, s, "R3") - 0.5) < 1e-14);
+    assert(std::abs(current(c, s, "R5") - 1.0) < 1e-14);
+    assert(std::abs(current(c, s, "V1") + 1.5) < 1e-14);
+
+    std::cout << "Chain of shorts passed!\n" << std::endl;
+}
+
+void test_opens() {
+    std::cout << "Testing opens..." << std::endl;
+
+    // Ток разрыва - точный ноль, без тока через R2 потенциал b - ноль
+    const circuit c = circuit::parse(
+        "I1 0 a 1m\n"
+        "R3 a 0 1k\n"
+        "R1 a b inf\n"
+        "R2 b 0 1k\n");
+    const circuit_solver s(c);
+    assert(s.current(c, c.findElement("R1")) == dspirit::SUPER_ZERO);
+    assert(current(c, s, "R2") == 0.0);
+    assert(std::abs(current(c, s, "R3") - 1e-3) < 1e-18);
+    assert(kirchhoffResidual(c, s) == 0.0);
+
+    // Узел только с разрывами: ток уходит на землю через ведущий элемент ZERO
+    const circuit floating = circuit::parse(
+        "I1 0 a 1m\n"
+        "R1 a b inf\n"
+        "R2 b 0 1k\n");
+    const circuit_solver f(floating);
+    assert(f.floatingNodes() == 1);
+    assert(f.voltage(floating.findNode("a")).isInfinity());
+    assert(f.current(floating, floating.findElement("R1")) == dspirit::SUPER_ZERO);
+    assert(current(floating, f, "R2") == 0.0);
+
+    std::cout << "Opens passed!\n" << std::endl;
+}
+
+bool updates(circuit_solver& s, const circuit& c) {
+    try {
+        s.update(c);
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+void test_topology_check() {
+    std::cout << "Testing update topology check..." << std::endl;
+
+    const circuit before = circuit::parse("I1 x y 1m\nR1 y 0 1k\nR2 x 0 1k\n");
+    circuit_solver s(before);
+    assert(updates(s, circuit::parse("I1 x y 2m\nR1 y 0 2k\nR2 x 0 1k\n")));
+
+    // Тот же узел, другой тип: источник тока не входил в структуру G
+    assert(!updates(s, circuit::parse("R9 x y 1k\nR1 y 0 1k\nR2 x 0 1k\n")));
+    assert(!updates(s, circuit::parse("V1 x y 1\nR1 y 0 1k\nR2 x 0 1k\n")));
+    // Другие узлы и число элементов
+    assert(!updates(s, circuit::parse("I1 y x 1m\nR1 y 0 1k\nR2 x 0 1k\n")));
+    assert(!updates(s, circuit::parse("I1 x y 1m\nR1 y 0 1k\n")));
+
+    std::cout << "Topology check passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing circuit solver ===\n" << std::endl;
+
+    test_kirchhoff();
+    test_chain_of_shorts();
+    test_opens();
+    test_topology_check();
+
+    std::cout << "=== All circuit solver tests passed! ===" << std::endl;
+    return 0;
+}
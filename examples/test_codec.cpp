@@ -0,0 +1,203 @@
+// Сжатие PDXZ: точное восстановление, порции, параметры и повреждения
+#undef NDEBUG
+#include "paradox/codec.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace paradox;
+
+namespace {
+
+// Побитовое совпадение (-0.0, NaN и денормализованные сохраняются как есть)
+bool identical(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+bool identical(const_dspirit_view a, const_dspirit_view b, std::size_t offset = 0) {
+    for (std::size_t k = 0; k < b.size; ++k) {
+        const dspirit_parts x = a[offset + k], y = b[k];
+        if (!identical(x.r, y.r) || !identical(x.i, y.i) || !identical(x.j, y.j) || !identical(x.level, y.level)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Fn>
+bool raises(Fn fn) {
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+// Типичные данные: измерения уровня 0, редкие уровни и подуровни
+dspirit_array typical(std::size_t n) {
+    dspirit_array values(n);
+    std::mt19937_64 rng(38);
+    std::uniform_int_distribution<int> step(-3, 3);
+    double r = 1000.0;
+    for (std::size_t k = 0; k < n; ++k) {
+        r += 0.25 * step(rng);
+        dspirit_parts p = {r, 0.0, 0.0, 0.0};
+        if (k % 997 == 0) p.i = 0.5;
+        if (k % 1499 == 0) p.j = -2.0;
+        if (k >= 5000 && k < 5100) p.level = 1.0;
+        if (k % 3001 == 0) p.level = -1.0;
+        values.set(k, p);
+    }
+    return values;
+}
+
+// Все особые значения double и случайные биты r
+dspirit_array awkward(std::size_t n) {
+    const double specials[] = {0.0, -0.0, std::numeric_limits<double>::infinity(),
+                               -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(),
+                               std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max()};
+    dspirit_array values(n);
+    std::mt19937_64 rng(39);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::uint64_t bits = rng();
+        double r;
+        std::memcpy(&r, &bits, sizeof(double));
+        if (k % 11 == 0) r = specials[(k / 11) % 7];
+        values.set(k, dspirit_parts{r, (k % 7 == 0) ? specials[k % 7] : 0.0, (k % 5 == 0) ? -0.0 : 0.0,
+                                    static_cast<double>(k % 4)});
+    }
+    return values;
+}
+
+void test_round_trip() {
+    std::cout << "Testing round trips..." << std::endl;
+
+    const std::size_t n = 200000;
+    const dspirit_array data[] = {typical(n), awkward(n), dspirit_array(n, dspirit(2.5))};
+
+    codec::options variants[4];
+    variants[1].entropy = false;
+    variants[2].shuffle = false;
+    variants[3].chunkValues = 1000;
+    variants[3].threads = 1;
+
+    for (const dspirit_array& values : data) {
+        for (const codec::options& opts : variants) {
+            const compressed_array packed(values.view(), opts);
+            assert(packed.size() == n);
+            assert(packed.chunkCount() == (n + opts.chunkValues - 1) / opts.chunkValues);
+
+            const dspirit_array back = packed.toArray();
+            assert(back.size() == n && identical(back.view(), values.view()));
+
+            // Последовательно и параллельно - одно и то же
+            dspirit_array serial(n);
+            packed.decode(serial.view(), 1);
+            assert(identical(serial.view(), values.view()));
+        }
+    }
+
+    // Типичные данные и постоянный столбец заметно сжимаются
+    const std::size_t raw = n * 4 * sizeof(double);
+    assert(compressed_array(data[0].view()).bytes().size() < raw / 4);
+    assert(compressed_array(data[2].view()).bytes().size() < raw / 100);
+
+    // Пустой массив
+    const compressed_array empty(dspirit_array().view());
+    assert(empty.size() == 0 && empty.toArray().size() == 0);
+
+    std::cout << "Round trips passed!\n" << std::endl;
+}
+
+void test_chunks() {
+    std::cout << "Testing chunks..." << std::endl;
+
+    const std::size_t n = 10000;
+    const dspirit_array values = typical(n);
+    codec::options opts;
+    opts.chunkValues = 4096;
+    const compressed_array packed(values.view(), opts);
+    assert(packed.chunkCount() == 3 && packed.chunkValues() == 4096);
+
+    // Порция отдельно, последняя неполная
+    for (std::size_t c = 0; c < packed.chunkCount(); ++c) {
+        const std::size_t first = c * 4096;
+        const std::size_t count = (n - first < 4096) ? n - first : 4096;
+        dspirit_array chunk(count);
+        packed.decodeChunk(c, chunk.view());
+        assert(identical(values.view(), chunk.view(), first));
+    }
+
+    dspirit_array wrong(10);
+    assert(raises([&] { packed.decodeChunk(0, wrong.view()); }));
+    assert(raises([&] { packed.decodeChunk(3, wrong.view()); }));
+    assert(raises([&] { packed.decode(wrong.view()); }));
+
+    // Размер порции вне допустимого
+    opts.chunkValues = 0;
+    assert(raises([&] { compressed_array bad(values.view(), opts); }));
+    opts.chunkValues = codec::MAX_CHUNK_VALUES + 1;
+    assert(raises([&] { compressed_array bad(values.view(), opts); }));
+
+    std::cout << "Chunks passed!\n" << std::endl;
+}
+
+void test_bytes() {
+    std::cout << "Testing stored bytes..." << std::endl;
+
+    const std::size_t n = 10000;
+    const dspirit_array values = typical(n);
+    codec::options opts;
+    opts.chunkValues = 4096;
+    const std::vector<unsigned char> good = compressed_array(values.view(), opts).bytes();
+
+    const compressed_array loaded = compressed_array::fromBytes(good);
+    assert(loaded.size() == n && loaded.chunkCount() == 3);
+    assert(identical(loaded.toArray().view(), values.view()));
+
+    // Заголовок проверяется сразу
+    std::vector<unsigned char> bad = good;
+    bad[0] = 'X';
+    assert(raises([&] { compressed_array::fromBytes(bad); }));
+    bad = good;
+    bad[4] = 2;
+    assert(raises([&] { compressed_array::fromBytes(bad); }));
+    bad = good;
+    bad.pop_back();
+    assert(raises([&] { compressed_array::fromBytes(bad); }));
+    bad = good;
+    bad.push_back(0);
+    assert(raises([&] { compressed_array::fromBytes(bad); }));
+
+    // Данные порции - контрольной суммой при распаковке этой порции
+    bad = good;
+    bad[bad.size() - 10] ^= 0x40;
+    const compressed_array damaged = compressed_array::fromBytes(bad);
+    dspirit_array chunk(4096);
+    damaged.decodeChunk(0, chunk.view());
+    dspirit_array last(n - 2 * 4096);
+    assert(raises([&] { damaged.decodeChunk(2, last.view()); }));
+    assert(raises([&] { damaged.toArray(); }));
+
+    std::cout << "Stored bytes passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing PDXZ codec ===\n" << std::endl;
+
+    test_round_trip();
+    test_chunks();
+    test_bytes();
+
+    std::cout << "=== All PDXZ codec tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Столбцовый файл PDXC: запись порциями, отображение, срезы и повреждения
+#undef NDEBUG
+#include "paradox/columnar.h"
+#include "test_common.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+const std::string PATH = "test_columnar.tmp";
+
+// Больше страницы на столбец, размер не кратен странице
+const std::size_t N = 5000;
+
+dspirit_array sample() {
+    dspirit_array values(N);
+    for (std::size_t k = 0; k < N; ++k) {
+        if (k % 5 == 0) values.set(k, dspirit_parts{1.5, 0.25 * static_cast<double>(k), -1.0, static_cast<double>(k % 3) - 1.0});
+        else values.set(k, dspirit(0.5 * static_cast<double>(k) - 100.0));
+    }
+    return values;
+}
+
+template <class Fn>
+bool raises(Fn fn) {
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+std::string readFile() {
+    std::ifstream in(PATH, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& bytes) {
+    std::ofstream out(PATH, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void test_full_columns() {
+    std::cout << "Testing full columns..." << std::endl;
+
+    const dspirit_array values = sample();
+    {
+        // Порциями разного размера
+        columnar_writer writer(PATH, N);
+        std::size_t at = 0;
+        for (std::size_t part : {std::size_t(1), std::size_t(1023), std::size_t(2500), N - 3524}) {
+            const const_dspirit_view v = values.view();
+            writer.write({v.r + at, v.i + at, v.j + at, v.level + at, part});
+            at += part;
+        }
+        assert(writer.count() == N);
+        writer.finish();
+    }
+
+    columnar_file file(PATH);
+    assert(file.size() == N && !file.isPlain());
+    for (std::size_t k = 0; k < N; ++k) assert(sameParts(file.view()[k], values.parts(k)));
+
+    // Срез и подсказка чтения
+    const const_dspirit_view part = file.slice(4000, 1000);
+    assert(part.size == 1000);
+    for (std::size_t k = 0; k < part.size; ++k) assert(sameParts(part[k], values.parts(4000 + k)));
+    file.prefetch(0, N);
+    assert(file.slice(N, 0).size == 0);
+    assert(raises([&] { (void)file.slice(N - 1, 2); }));
+
+    // Перемещение
+    columnar_file moved(std::move(file));
+    assert(moved.size() == N && file.size() == 0);
+    assert(sameParts(moved.view()[N - 1], values.parts(N - 1)));
+
+    std::cout << "Full columns passed!\n" << std::endl;
+}
+
+void test_plain_column() {
+    std::cout << "Testing plain column..." << std::endl;
+
+    std::vector<double> plain(N);
+    for (std::size_t k = 0; k < N; ++k) plain[k] = 0.125 * static_cast<double>(k) + 1.0;
+    writeColumnar(PATH, const_dspirit_view{plain.data(), nullptr, nullptr, nullptr, N});
+
+    // Один столбец: заголовок, страница столбца, данные
+    assert(readFile().size() == 2 * columnar::PAGE_BYTES + N * sizeof(double));
+
+    const columnar_file file(PATH);
+    assert(file.isPlain() && file.size() == N);
+    for (std::size_t k = 0; k < N; ++k) assert(sameParts(file.view()[k], dspirit(plain[k]).toParts()));
+
+    // Значения уровня 0 из полного представления тоже пишутся одним столбцом
+    dspirit_array full(3);
+    full.set(0, dspirit(1.0));
+    full.set(1, dspirit(-2.0));
+    full.set(2, dspirit(3.5));
+    {
+        columnar_writer writer(PATH, 3, true);
+        writer.write(full.view());
+        writer.finish();
+    }
+    assert(columnar_file(PATH).isPlain());
+
+    // Значение с уровнем в файл из одного столбца не пишется
+    full.set(1, dspirit::INF);
+    assert(raises([&] {
+        columnar_writer writer(PATH, 3, true);
+        writer.write(full.view());
+    }));
+
+    std::cout << "Plain column passed!\n" << std::endl;
+}
+
+void test_writer_count() {
+    std::cout << "Testing declared count..." << std::endl;
+
+    const dspirit_array values = sample();
+    assert(raises([&] {
+        columnar_writer writer(PATH, 10);
+        writer.write(values.view());
+    }));
+    assert(raises([&] {
+        columnar_writer writer(PATH, N + 1);
+        writer.write(values.view());
+        writer.finish();
+    }));
+
+    // Пустой файл значений
+    {
+        columnar_writer writer(PATH, 0);
+        writer.finish();
+    }
+    assert(columnar_file(PATH).size() == 0);
+
+    std::cout << "Declared count passed!\n" << std::endl;
+}
+
+void test_corrupt() {
+    std::cout << "Testing corrupt files..." << std::endl;
+
+    writeColumnar(PATH, sample().view());
+    const std::string good = readFile();
+
+    auto rejected = [](const std::string& bytes) {
+        writeFile(bytes);
+        return raises([] { columnar_file file(PATH); });
+    };
+
+    std::string bad = good;
+    bad[0] = 'X';
+    assert(rejected(bad));  // сигнатура
+
+    bad = good;
+    bad[4] = 2;
+    assert(rejected(bad));  // версия
+
+    bad = good;
+    bad[columnar::PAGE_BYTES] = 'X';
+    assert(rejected(bad));  // заголовок столбца
+
+    assert(rejected(good.substr(0, good.size() - columnar::PAGE_BYTES)));  // обрезан
+    assert(rejected(good.substr(0, 100)));                                  // меньше страницы
+
+    writeFile(good);
+    assert(!raises([] { columnar_file file(PATH); }));
+    std::remove(PATH.c_str());
+    assert(raises([] { columnar_file file(PATH); }));  // нет файла
+
+    std::cout << "Corrupt files passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing columnar files ===\n" << std::endl;
+
+    test_full_columns();
+    test_plain_column();
+    test_writer_count();
+    test_corrupt();
+
+    std::remove(PATH.c_str());
+    std::cout << "=== All columnar file tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,42 @@
+// Общие сравнения для проверок examples/test_*.cpp
+#ifndef PARADOX_TEST_COMMON_H
+#define PARADOX_TEST_COMMON_H
+
+#include "paradox/dspirit.h"
+
+#include <cmath>
+#include <limits>
+
+namespace paradox {
+namespace test {
+
+// Точное равенство, NaN равен NaN (ошибочные элементы пакетных функций)
+inline bool same(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// Все компоненты и уровень совпадают точно
+inline bool sameParts(const dspirit_parts& a, const dspirit_parts& b) {
+    return same(a.r, b.r) && same(a.i, b.i) && same(a.j, b.j) && same(a.level, b.level);
+}
+
+inline bool sameParts(const dspirit& a, const dspirit& b) {
+    return sameParts(a.toParts(), b.toParts());
+}
+
+// Стандартная часть: бесконечно малые - 0, бесконечные - +-inf
+inline double standard(const dspirit_parts& x) {
+    if (x.level < 0.0) return 0.0;
+    if (x.level > 0.0) return x.r < 0.0 ? -std::numeric_limits<double>::infinity()
+                                         : std::numeric_limits<double>::infinity();
+    return x.r;
+}
+
+inline double standard(const dspirit& x) {
+    return standard(x.toParts());
+}
+
+} // namespace test
+} // namespace paradox
+
+#endif // PARADOX_TEST_COMMON_H
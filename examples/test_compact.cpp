@@ -0,0 +1,126 @@
+// compact_dspirit: упаковка против точного округления и повторная упаковка
+#undef NDEBUG
+#include "paradox/compact.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace paradox;
+
+namespace {
+
+const std::size_t N = 1000000;
+
+float fromBf16(std::uint16_t bits) {
+    const std::uint32_t word = static_cast<std::uint32_t>(bits) << 16;
+    float value;
+    std::memcpy(&value, &word, sizeof value);
+    return value;
+}
+
+// Ближайшее bfloat16 (8 значащих бит, чётное при равенстве) без
+// промежуточного float: шаг 2^(e - 7), в субнормальных - 2^-133
+double bf16Reference(double x) {
+    if (x == 0.0 || std::isnan(x)) return x;
+    int e;
+    std::frexp(x, &e);
+    const int exponent = std::max(e - 1, -126) - 7;
+    return std::nearbyint(std::ldexp(x, -exponent)) * std::ldexp(1.0, exponent);
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof a) == 0;
+}
+
+// Компонента в диапазоне float: нормальные, субнормальные float и ниже
+double component(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> mantissa(-2.0, 2.0);
+    std::uniform_int_distribution<int> exponent(-160, 126);
+    return std::ldexp(mantissa(rng), exponent(rng));
+}
+
+void test_random_values() {
+    std::cout << "Testing " << N << " random values..." << std::endl;
+
+    std::mt19937_64 rng(44);
+    std::uniform_int_distribution<int> level16(-32767, 32766);
+    std::vector<compact_dspirit> packed(N);
+    dspirit_array values(N);
+
+    for (std::size_t k = 0; k < N; ++k) {
+        const double level = (k % 100 == 0) ? -std::numeric_limits<double>::infinity()
+                                            : static_cast<double>(level16(rng)) / 16.0;
+        const dspirit_parts value = {component(rng), component(rng), component(rng), level};
+        values.set(k, value);
+
+        const compact_dspirit c = compact_dspirit::fromParts(value);
+        const dspirit_parts back = c.toParts();
+
+        // r и уровень - точно, i - одно округление к float, j - к bfloat16
+        assert(sameBits(back.r, value.r));
+        assert(back.level == value.level);
+        assert(c.i == static_cast<float>(value.i));
+        assert(static_cast<double>(fromBf16(c.j)) == bf16Reference(value.j));
+
+        // Повторная упаковка расширенного значения - те же биты
+        const compact_dspirit again = compact_dspirit::fromParts(back);
+        assert(std::memcmp(&again, &c, sizeof c) == 0);
+        packed[k] = c;
+    }
+
+    // Пакетная упаковка совпадает с поэлементной
+    std::vector<compact_dspirit> batchPacked(N);
+    assert(batch::pack(values.view(), batchPacked.data()) == 0);
+    assert(std::memcmp(batchPacked.data(), packed.data(), N * sizeof(compact_dspirit)) == 0);
+
+    dspirit_array unpacked(N);
+    batch::unpack(packed.data(), unpacked.view());
+    for (std::size_t k = 0; k < N; k += 997) {
+        const dspirit_parts a = unpacked.parts(k), b = packed[k].toParts();
+        assert(sameBits(a.r, b.r) && sameBits(a.i, b.i) && sameBits(a.j, b.j) && a.level == b.level);
+    }
+
+    std::cout << "Random values passed!\n" << std::endl;
+}
+
+void test_rounding_ties() {
+    std::cout << "Testing bfloat16 ties..." << std::endl;
+
+    // Чуть выше середины между bf16 соседями, но ровно середина после
+    // округления к float: двойное округление дало бы меньшего соседа
+    const double tie = 1.0 + std::ldexp(1.0, -8) + std::ldexp(1.0, -40);
+    const compact_dspirit c = compact_dspirit::fromParts({1.0, 0.0, tie, 0.0});
+    assert(static_cast<double>(fromBf16(c.j)) == 1.0 + std::ldexp(1.0, -7));
+
+    std::cout << "Ties passed!\n" << std::endl;
+}
+
+void test_rejected() {
+    std::cout << "Testing unrepresentable values..." << std::endl;
+
+    compact_dspirit out = {};
+    assert(compact_dspirit::fromParts({1.0, 1e39, 0.0, 0.0}, out) == status::invalid_argument);
+    assert(compact_dspirit::fromParts({1.0, 0.0, -1e39, 0.0}, out) == status::invalid_argument);
+    assert(compact_dspirit::fromParts({1.0, 0.0, 0.0, 0.03}, out) == status::invalid_argument);
+    assert(compact_dspirit::fromParts({1.0, 0.0, 0.0, 4096.0}, out) == status::invalid_argument);
+
+    std::cout << "Unrepresentable values passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing compact_dspirit ===\n" << std::endl;
+
+    test_random_values();
+    test_rounding_ties();
+    test_rejected();
+
+    std::cout << "=== All compact_dspirit tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Комплексные числа: мнимая часть по умолчанию, умножение Гаусса, деление
+#undef NDEBUG
+#include "paradox/complex.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Детерминированные обычные значения из [-4, 4)
+double sample(std::uint64_t& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<double>(state >> 11) * 0x1.0p-53 * 8.0 - 4.0;
+}
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1e-12 * (1.0 + std::abs(a) + std::abs(b));
+}
+
+void test_default_imag() {
+    std::cout << "Testing default imaginary part..." << std::endl;
+
+    // Без мнимой части число вещественное: точный ноль, а не ZERO
+    assert(sameParts(complex_dspirit(2.0).imag(), dspirit::SUPER_ZERO));
+    assert(sameParts(complex_dspirit(dspirit(2.0)).imag(), dspirit::SUPER_ZERO));
+    assert(sameParts(complex_dspirit().imag(), dspirit::SUPER_ZERO));
+
+    // (5 + INF i) * 2 = 10 + 2INF i
+    const complex_dspirit z(dspirit(5.0), dspirit::INF);
+    const complex_dspirit w = z * complex_dspirit(2.0);
+    assert(sameParts(w.real(), dspirit(10.0)));
+    assert(sameParts(w.imag(), dspirit::fromLevel(2.0, 1.0)));
+    assert(sameParts((z * dspirit(2.0)).real(), dspirit(10.0)));
+
+    // Явный ZERO - бесконечно малая: INF * ZERO = 1 попадает в результат
+    const complex_dspirit t = z * complex_dspirit(2.0, 0.0);
+    assert(sameParts(t.real(), dspirit(9.0)));
+    assert(sameParts(t.imag(), dspirit::fromParts({2.0, 0.0, 5.0, 1.0})));  // + 5 * ZERO
+
+    std::cout << "Default imaginary part passed!\n" << std::endl;
+}
+
+void test_multiply() {
+    std::cout << "Testing three-product multiply..." << std::endl;
+
+    // Обычные части: формула Гаусса в double, близко к четырём произведениям
+    std::uint64_t state = 42;
+    for (int k = 0; k < 1000; ++k) {
+        const double a = sample(state), b = sample(state), c = sample(state), d = sample(state);
+        const complex_dspirit p = complex_dspirit(a, b) * complex_dspirit(c, d);
+        const double k1 = c * (a + b), k2 = a * (d - c), k3 = b * (c + d);
+        assert(sameParts(p.real(), dspirit(k1 - k3)));
+        assert(sameParts(p.imag(), dspirit(k1 + k2)));
+        assert(close(p.real().toDouble(), a * c - b * d));
+        assert(close(p.imag().toDouble(), a * d + b * c));
+    }
+
+    // Части на одном бесконечном уровне: тот же порядок операций через Impl
+    const complex_dspirit x(dspirit::fromLevel(1.5, 1.0), dspirit::fromLevel(-2.0, 1.0));
+    const complex_dspirit y(dspirit::fromLevel(3.0, 1.0), dspirit::fromLevel(0.5, 1.0));
+    const complex_dspirit xy = x * y;
+    assert(sameParts(xy.real(), dspirit::fromLevel(3.0 * (1.5 - 2.0) - (-2.0) * (3.0 + 0.5), 2.0)));
+    assert(sameParts(xy.imag(), dspirit::fromLevel(3.0 * (1.5 - 2.0) + 1.5 * (0.5 - 3.0), 2.0)));
+
+    // Разные уровни частей: младшая часть не теряется в a + b
+    const complex_dspirit u(dspirit(3.0), dspirit::fromLevel(1.0, 1.0));
+    const complex_dspirit v(dspirit(2.0), dspirit::fromLevel(4.0, -1.0));
+    const complex_dspirit uv = u * v;
+    assert(sameParts(uv.real(), dspirit(6.0 - 4.0)));
+    assert(sameParts(uv.imag(), dspirit::fromParts({2.0, 0.0, 12.0, 1.0})));
+
+    std::cout << "Three-product multiply passed!\n" << std::endl;
+}
+
+void test_divide() {
+    std::cout << "Testing Smith division..." << std::endl;
+
+    std::uint64_t state = 7;
+    for (int k = 0; k < 1000; ++k) {
+        const double a = sample(state), b = sample(state), c = sample(state), d = sample(state);
+        if (std::abs(c) + std::abs(d) < 0.5) continue;
+        const complex_dspirit q = complex_dspirit(a, b) / complex_dspirit(c, d);
+        const double den = c * c + d * d;
+        assert(close(q.real().toDouble(), (a * c + b * d) / den));
+        assert(close(q.imag().toDouble(), (b * c - a * d) / den));
+    }
+
+    // Деление на вещественное бесконечное: мнимая часть делителя - суперноль
+    const complex_dspirit q = complex_dspirit(4.0, 6.0) / complex_dspirit(dspirit::fromLevel(2.0, 1.0));
+    assert(sameParts(q.real(), dspirit::fromLevel(2.0, -1.0)));
+    assert(sameParts(q.imag(), dspirit::fromLevel(3.0, -1.0)));
+
+    std::cout << "Smith division passed!\n" << std::endl;
+}
+
+void test_batch() {
+    std::cout << "Testing batch multiply..." << std::endl;
+
+    const std::size_t n = 257;
+    complex_array a(n), b(n), out(n);
+    std::uint64_t state = 3;
+    for (std::size_t k = 0; k < n; ++k) {
+        a.set(k, complex_dspirit(sample(state), sample(state)));
+        b.set(k, complex_dspirit(sample(state), sample(state)));
+    }
+    a.set(5, complex_dspirit(dspirit(5.0), dspirit::INF));
+    b.set(5, complex_dspirit(2.0));
+
+    batch::multiply(a, b, out);
+    for (std::size_t k = 0; k < n; ++k) {
+        const complex_dspirit p = a[k] * b[k];
+        assert(sameParts(out[k].real(), p.real()));
+        assert(sameParts(out[k].imag(), p.imag()));
+    }
+    assert(sameParts(out[5].real(), dspirit(10.0)));
+
+    std::cout << "Batch multiply passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing complex numbers ===\n" << std::endl;
+
+    test_default_imag();
+    test_multiply();
+    test_divide();
+    test_batch();
+
+    std::cout << "=== All complex number tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Загрузка CSV: формат полей, ошибки строк, параллельные куски, файл
+#undef NDEBUG
+#include "paradox/csv.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+status parse(const std::string& text, csv_table& out, const csv_options& opts = csv_options()) {
+    return parseCsv(text.data(), text.data() + text.size(), out, opts);
+}
+
+void test_fields() {
+    std::cout << "Testing fields..." << std::endl;
+
+    csv_options opts;
+    opts.header = true;
+    csv_table t;
+    const std::string text = "x, \"y\" ,z\r\n"
+                             "1.5, inf, -2\r\n"
+                             "\n"
+                             "  \t\n"
+                             "eps, \"2@1\", -inf^2\n"
+                             "3,4,5";
+    assert(parse(text, t, opts) == status::ok);
+    assert(t.names.size() == 3 && t.names[0] == "x" && t.names[1] == "y" && t.names[2] == "z");
+    assert(t.rows == 3 && t.columns.size() == 3 && t.errorCount == 0);
+
+    assert(sameParts(t.columns[0][0], dspirit(1.5)));
+    assert(sameParts(t.columns[1][0], dspirit::INF));
+    assert(sameParts(t.columns[2][0], dspirit(-2.0)));
+    assert(sameParts(t.columns[0][1], dspirit::EPSILON));
+    assert(sameParts(t.columns[1][1], dspirit::fromLevel(2.0, 1.0)));
+    assert(sameParts(t.columns[2][1], dspirit::fromLevel(-1.0, 2.0)));
+    assert(sameParts(t.columns[2][2], dspirit(5.0)));
+
+    // Другой разделитель, без заголовка
+    opts = csv_options();
+    opts.delimiter = ';';
+    assert(parse("1;2\n3;4\n", t, opts) == status::ok);
+    assert(t.names.empty() && t.rows == 2 && sameParts(t.columns[1][1], dspirit(4.0)));
+
+    // Пустой текст
+    assert(parse("", t) == status::ok && t.rows == 0 && t.columns.empty());
+
+    std::cout << "Fields passed!\n" << std::endl;
+}
+
+void test_errors() {
+    std::cout << "Testing row errors..." << std::endl;
+
+    csv_table t;
+    assert(parse("1,2,3\n4,x,6\n7,8\n9,10,11,12\n13,\"14\" junk,15\n", t) == status::ok);
+    assert(t.rows == 5 && t.errorCount == 4 && t.errors.size() == 4);
+
+    // Поле не разобрано - NaN уровня 0
+    assert(t.errors[0].row == 1 && t.errors[0].column == 1 && t.errors[0].code == status::invalid_argument);
+    assert(std::isnan(t.columns[1].parts(1).r) && t.columns[1].parts(1).level == 0.0);
+    assert(sameParts(t.columns[2][1], dspirit(6.0)));
+
+    // Недостающее поле
+    assert(t.errors[1].row == 2 && t.errors[1].column == 2 && t.errors[1].code == status::size_mismatch);
+    assert(std::isnan(t.columns[2].parts(2).r));
+
+    // Лишнее поле: значения сохраняются
+    assert(t.errors[2].row == 3 && t.errors[2].column == 3 && t.errors[2].code == status::size_mismatch);
+    assert(sameParts(t.columns[2][3], dspirit(11.0)));
+
+    // Текст после кавычек
+    assert(t.errors[3].row == 4 && t.errors[3].column == 1 && t.errors[3].code == status::invalid_argument);
+
+    // Сохраняется не больше maxErrors, считаются все
+    csv_options opts;
+    opts.maxErrors = 1;
+    assert(parse("a\nb\nc\n", t, opts) == status::ok);
+    assert(t.errorCount == 3 && t.errors.size() == 1);
+
+    std::cout << "Row errors passed!\n" << std::endl;
+}
+
+void test_pieces() {
+    std::cout << "Testing parallel pieces..." << std::endl;
+
+    // Больше нескольких кусков по 1 МБ, с ошибками на границах кусков
+    std::string text;
+    const std::size_t rows = 200000;
+    for (std::size_t k = 0; k < rows; ++k) {
+        text += std::to_string(k) + ",";
+        text += (k % 50000 == 7) ? "bad" : std::to_string(0.5 * static_cast<double>(k));
+        text += ",1e-3\n";
+    }
+    assert(text.size() > (std::size_t(3) << 20));
+
+    csv_options serial;
+    serial.threads = 1;
+    csv_options parallel;
+    parallel.threads = 4;
+    csv_table a, b;
+    assert(parse(text, a, serial) == status::ok);
+    assert(parse(text, b, parallel) == status::ok);
+
+    assert(a.rows == rows && b.rows == rows);
+    assert(a.errorCount == 4 && b.errorCount == 4);
+    for (std::size_t e = 0; e < 4; ++e) {
+        assert(b.errors[e].row == 50000 * e + 7 && b.errors[e].column == 1);
+    }
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t k = 0; k < rows; ++k) assert(sameParts(a.columns[c].parts(k), b.columns[c].parts(k)));
+    }
+    assert(sameParts(b.columns[0][rows - 1], dspirit(static_cast<double>(rows - 1))));
+
+    std::cout << "Parallel pieces passed!\n" << std::endl;
+}
+
+void test_file() {
+    std::cout << "Testing file loading..." << std::endl;
+
+    const std::string path = "test_csv.tmp";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "a,b\n1,2\n3,x\n";
+    }
+    csv_options opts;
+    opts.header = true;
+    csv_table t;
+    assert(loadCsv(path, t, opts) == status::ok);
+    assert(t.rows == 2 && t.names[1] == "b" && t.errorCount == 1);
+    assert(sameParts(t.columns[0][1], dspirit(3.0)));
+
+    // Пустой файл - пустая таблица
+    { std::ofstream out(path, std::ios::binary | std::ios::trunc); }
+    assert(loadCsv(path, t) == status::ok && t.rows == 0);
+    std::remove(path.c_str());
+
+    assert(loadCsv("no/such/file.csv", t) == status::io_error);
+
+    std::cout << "File loading passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing CSV loader ===\n" << std::endl;
+
+    test_fields();
+    test_errors();
+    test_pieces();
+    test_file();
+
+    std::cout << "=== All CSV loader tests passed! ===" << std::endl;
+    return 0;
+}
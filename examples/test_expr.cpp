@@ -0,0 +1,125 @@
+// Шаблоны выражений: совпадение с dspirit и однократное вычисление констант
+#undef NDEBUG
+#include "paradox/expr.h"
+#include "test_common.h"
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Скалярный лист, считающий обращения к at()
+class counted : public expr::node<counted> {
+public:
+    counted(double value, int* calls) : value_(kernel::make(value)), calls_(calls) {}
+
+    static constexpr bool constant = true;
+    dspirit_parts at(std::size_t) const {
+        ++*calls_;
+        return value_;
+    }
+    std::size_t size() const { return expr::broadcast; }
+    counted folded() const { return *this; }
+
+private:
+    dspirit_parts value_;
+    int* calls_;
+};
+
+dspirit_array sample(std::size_t n) {
+    dspirit_array values(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (k % 7 == 3) values.set(k, dspirit::fromLevel(1.5 + static_cast<double>(k), 1.0));
+        else if (k % 7 == 5) values.set(k, dspirit_parts{0.5, 2.0, -1.0, -1.0});
+        else values.set(k, dspirit(0.01 * static_cast<double>(k) - 1.0));
+    }
+    return values;
+}
+
+void test_matches_dspirit() {
+    std::cout << "Testing expressions against dspirit..." << std::endl;
+    using namespace paradox::expr;
+
+    const std::size_t n = 100;
+    const dspirit_array a = sample(n);
+    dspirit_array b(n), out;
+    for (std::size_t k = 0; k < n; ++k) b.set(k, dspirit(2.0 + 0.5 * static_cast<double>(k % 9)));
+
+    assign(out, ref(a) * ref(b) + 1.0);
+    assert(out.size() == n);
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(out[k], a[k] * b[k] + dspirit(1.0)));
+
+    const dspirit c(3.0);
+    assign(out, sqrt(abs(ref(a))) / (val(c) * val(c)) - exp(ref(b) / 10.0));
+    for (std::size_t k = 0; k < n; ++k) {
+        assert(sameParts(out[k], sqrt(a[k].abs()) / (c * c) - exp(b[k] / dspirit(10.0))));
+    }
+
+    assign(out, fma(ref(a), ref(b), val(c)));
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(out[k], fma(a[k], b[k], c)));
+
+    assign(out, pow(ref(b), 3.0));
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(out[k], pow(b[k], 3.0)));
+
+    // Скалярное выражение
+    const dspirit v(0.6);
+    const dspirit gamma = eval(1.0 / sqrt(1.0 - (val(v) * val(v)) / (val(c) * val(c))));
+    assert(sameParts(gamma, dspirit::ONE / sqrt(dspirit::ONE - (v * v) / (c * c))));
+
+    // out совпадает со входом
+    dspirit_array in_place = sample(n);
+    assign(in_place, ref(in_place) * 2.0);
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(in_place[k], a[k] * dspirit(2.0)));
+
+    std::cout << "Expressions against dspirit passed!\n" << std::endl;
+}
+
+void test_constant_folding() {
+    std::cout << "Testing constant subtrees..." << std::endl;
+    using namespace paradox::expr;
+
+    static_assert(decltype(val(1.0) * val(2.0))::constant, "scalar subtree is constant");
+    static_assert(!decltype(ref(const_dspirit_view()) * val(2.0))::constant, "array subtree is not constant");
+
+    const std::size_t n = 1000;
+    const dspirit_array a = sample(n);
+    dspirit_array out(n);
+
+    // Постоянное поддерево вычисляется один раз, а не на каждом элементе
+    int calls = 0;
+    const counted c(3.0, &calls);
+    assign(out, ref(a) / (c * c) + sqrt(c));
+    assert(calls == 3);
+    for (std::size_t k = 0; k < n; ++k) {
+        assert(sameParts(out[k], a[k] / dspirit(9.0) + sqrt(dspirit(3.0))));
+    }
+
+    // Вся правая часть постоянна
+    calls = 0;
+    assign(out, exp(c) * 2.0);
+    assert(calls == 1);
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(out[k], exp(dspirit(3.0)) * dspirit(2.0)));
+
+    // Пустой выход - ничего не вычисляется
+    calls = 0;
+    dspirit_array empty;
+    assign(empty.view(), ref(empty) * c);
+    assert(calls == 0);
+
+    std::cout << "Constant subtrees passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing expression templates ===\n" << std::endl;
+
+    test_matches_dspirit();
+    test_constant_folding();
+
+    std::cout << "=== All expression template tests passed! ===" << std::endl;
+    return 0;
+}
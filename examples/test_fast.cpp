@@ -0,0 +1,135 @@
+// fast::: погрешность в ULP на всём документированном диапазоне против
+// long double (на x86 - 64 бита мантиссы, запас в 11 бит)
+#undef NDEBUG
+#include "paradox/fast.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using namespace paradox;
+
+namespace {
+
+const int SAMPLES = 1000000;
+
+double ulp(long double reference) {
+    const double magnitude = std::abs(static_cast<double>(reference));
+    int exponent;
+    std::frexp(magnitude, &exponent);
+    return std::ldexp(1.0, exponent - 53);
+}
+
+// Наибольшая ошибка в ULP на точках из sample(k)
+template <class Sample, class Fast, class Exact>
+double worstError(int count, Sample sample, Fast fast, Exact exact) {
+    double worst = 0.0;
+    for (int k = 0; k < count; ++k) {
+        const double x = sample(k);
+        const long double reference = exact(static_cast<long double>(x));
+        const double value = fast(dspirit(x)).toParts().r;
+        worst = std::max(worst, static_cast<double>(std::abs(value - reference) / ulp(reference)));
+    }
+    return worst;
+}
+
+// Ближайшие к q*pi/2 аргументы - наибольшая потеря точности при редукции
+double nearHalfPi(int k) {
+    const long double HALF_PI = 1.5707963267948966192313216916397514L;
+    const double x = static_cast<double>((k / 3 + 1) * 3 * HALF_PI);
+    return k % 3 == 0 ? x : std::nextafter(x, k % 3 == 1 ? 0.0 : 2e6);
+}
+
+void test_exp_log() {
+    std::cout << "Testing fast::exp and fast::log..." << std::endl;
+
+    std::mt19937_64 rng(33);
+    std::uniform_real_distribution<double> argument(-703.0, 709.78);
+    std::uniform_real_distribution<double> binade(-1015.0, 1024.0);
+    auto fastExp = [](const dspirit& x) { return fast::exp(x); };
+    auto fastLog = [](const dspirit& x) { return fast::log(x); };
+    auto exactExp = [](long double x) { return std::exp(x); };
+    auto exactLog = [](long double x) { return std::log(x); };
+
+    assert(worstError(SAMPLES, [&](int) { return argument(rng); }, fastExp, exactExp) <= 1.5);
+    assert(worstError(SAMPLES, [](int k) { return (k - SAMPLES / 2) * 1e-9; }, fastExp, exactExp) <= 1.5);
+    // Все положительные обычные числа, от NEAR_ZERO до DBL_MAX
+    assert(worstError(SAMPLES, [&](int) { return std::exp2(binade(rng)); }, fastLog, exactLog) <= 1.5);
+    // Около 1 (кроме самой 1) и около границ [sqrt(2)/2, sqrt(2))
+    assert(worstError(SAMPLES, [](int k) { return 1.0 + (k + 1) * 1e-11; }, fastLog, exactLog) <= 1.5);
+    assert(worstError(SAMPLES, [](int k) { return 1.0 - (k + 1) * 1e-12; }, fastLog, exactLog) <= 1.5);
+    assert(worstError(SAMPLES, [](int k) { return 1.4142135623730951 + (k - SAMPLES / 2) * 1e-12; },
+                      fastLog, exactLog) <= 1.5);
+
+    // Особые уровни - как у точных функций
+    assert(fast::exp(dspirit::ZERO) == dspirit::ONE);
+    assert(fast::exp(dspirit::NEG_INF).isZero());
+    assert(fast::exp(dspirit::INF).isInfinity());
+    assert(fast::log(dspirit::ZERO).isInfinity() && fast::log(dspirit::ZERO).isNegative());
+
+    std::cout << "fast::exp and fast::log passed!\n" << std::endl;
+}
+
+void test_trig() {
+    std::cout << "Testing fast::sin, fast::cos and fast::tan..." << std::endl;
+
+    std::mt19937_64 rng(34);
+    std::uniform_real_distribution<double> argument(-1e6, 1e6);
+    auto random = [&](int) { return argument(rng); };
+    auto fastSin = [](const dspirit& x) { return fast::sin(x); };
+    auto fastCos = [](const dspirit& x) { return fast::cos(x); };
+    auto fastTan = [](const dspirit& x) { return fast::tan(x); };
+    auto exactSin = [](long double x) { return std::sin(x); };
+    auto exactCos = [](long double x) { return std::cos(x); };
+    auto exactTan = [](long double x) { return std::tan(x); };
+
+    assert(worstError(SAMPLES, random, fastSin, exactSin) <= 1.5);
+    assert(worstError(SAMPLES, random, fastCos, exactCos) <= 1.5);
+    assert(worstError(SAMPLES, random, fastTan, exactTan) <= 2.5);
+    assert(worstError(SAMPLES, nearHalfPi, fastSin, exactSin) <= 1.5);
+    assert(worstError(SAMPLES, nearHalfPi, fastCos, exactCos) <= 1.5);
+    assert(worstError(SAMPLES, nearHalfPi, fastTan, exactTan) <= 2.5);
+
+    std::cout << "fast::sin, fast::cos and fast::tan passed!\n" << std::endl;
+}
+
+void test_pow() {
+    std::cout << "Testing fast::pow..." << std::endl;
+
+    std::mt19937_64 rng(35);
+    std::uniform_real_distribution<double> logBase(-700.0, 700.0), exponent(-50.0, 50.0);
+    double worst = 0.0;
+    for (int k = 0; k < SAMPLES; ++k) {
+        const double x = std::exp(logBase(rng)), p = exponent(rng);
+        const long double y = p * std::log(static_cast<long double>(x));
+        if (std::abs(y) > 700.0L) continue;
+        const long double reference = std::pow(static_cast<long double>(x), static_cast<long double>(p));
+        const double error = static_cast<double>(std::abs(fast::pow(dspirit(x), p).toParts().r - reference) /
+                                                 ulp(reference));
+        worst = std::max(worst, error / (1.5 + 2.0 * static_cast<double>(std::abs(y))));
+    }
+    assert(worst <= 1.0);
+
+    std::cout << "fast::pow passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing fast:: accuracy ===\n" << std::endl;
+
+    // С long double размером в double эталон не точнее проверяемого
+    if (std::numeric_limits<long double>::digits < 64) {
+        std::cout << "long double is too short for a reference, skipped" << std::endl;
+        return 0;
+    }
+
+    test_exp_log();
+    test_trig();
+    test_pow();
+
+    std::cout << "=== All fast:: accuracy tests passed! ===" << std::endl;
+    return 0;
+}
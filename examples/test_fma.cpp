@@ -0,0 +1,112 @@
+// fma(a, b, c): совпадение с a * b + c на уровнях, подуровнях и суперуровнях
+#undef NDEBUG
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/kernel.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Совпадение с точностью до округления (fma может округлять один раз)
+bool close(const dspirit& x, const dspirit& y) {
+    const dspirit_parts a = x.toParts(), b = y.toParts();
+    auto near = [](double u, double v) { return std::abs(u - v) <= 1e-12 * (1.0 + std::abs(u) + std::abs(v)); };
+    return same(a.level, b.level) && near(a.r, b.r) && near(a.i, b.i) && near(a.j, b.j);
+}
+
+dspirit randomValue(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> value(-3.0, 3.0);
+    std::uniform_int_distribution<int> level(-2, 2), sub(0, 3);
+    const double i = sub(rng) == 0 ? value(rng) : 0.0;
+    const double j = sub(rng) == 0 ? value(rng) : 0.0;
+    return dspirit::fromParts({value(rng), i, j, static_cast<double>(level(rng))});
+}
+
+void test_random() {
+    std::cout << "Testing random levels and sublevels..." << std::endl;
+
+    std::mt19937_64 rng(27);
+    for (int trial = 0; trial < 20000; ++trial) {
+        const dspirit a = randomValue(rng), b = randomValue(rng), c = randomValue(rng);
+        assert(close(fma(a, b, c), a * b + c));
+    }
+
+    std::cout << "Random levels and sublevels passed!\n" << std::endl;
+}
+
+void test_special() {
+    std::cout << "Testing special cases..." << std::endl;
+
+    // Сокращение старшей части: как в сложении
+    assert(sameParts(fma(dspirit(1.0), dspirit(1.0), dspirit(-1.0)), dspirit(1.0) * dspirit(1.0) + dspirit(-1.0)));
+    const dspirit t = dspirit::fromParts({1.0, 2.0, 0.0, 0.0});
+    assert(sameParts(fma(t, dspirit(1.0), dspirit(-1.0)), dspirit::fromLevel(2.0, -1.0)));
+
+    // Далёкие уровни: младшее слагаемое пренебрежимо
+    assert(sameParts(fma(dspirit::INF, dspirit::INF, dspirit::fromLevel(5.0, -2.0)), dspirit::INF * dspirit::INF));
+    assert(sameParts(fma(dspirit::ZERO, dspirit::ZERO, dspirit(5.0)), dspirit::fromParts({5.0, 0.0, 1.0, 0.0})));
+
+    // INF * ZERO = 1
+    assert(sameParts(fma(dspirit::INF, dspirit::ZERO, dspirit(2.0)), dspirit(3.0)));
+
+    // Переполнение произведения повышает уровень так же, как a * b + c
+    const dspirit big(1e300);
+    assert(sameParts(fma(big, big, dspirit(1.0)), big * big + dspirit(1.0)));
+
+    // Суперуровни
+    const dspirit& super_zero = dspirit::SUPER_ZERO;
+    const dspirit& super_inf = dspirit::SUPER_INF;
+    assert(sameParts(fma(super_inf, dspirit(2.0), dspirit(3.0)), super_inf * dspirit(2.0) + dspirit(3.0)));
+    assert(sameParts(fma(super_zero, dspirit(2.0), dspirit(3.0)), dspirit(3.0)));
+    assert(sameParts(fma(dspirit(2.0), dspirit(3.0), super_zero), dspirit(6.0)));
+
+    std::cout << "Special cases passed!\n" << std::endl;
+}
+
+void test_kernel_and_batch() {
+    std::cout << "Testing kernel and batch fma..." << std::endl;
+
+    const std::size_t n = 1000;
+    std::mt19937_64 rng(28);
+    dspirit_array a(n), b(n), c(n), out(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        a.set(k, randomValue(rng));
+        b.set(k, randomValue(rng));
+        c.set(k, randomValue(rng));
+    }
+
+    batch::fma(a, b, c, out);
+    const dspirit_array result = fma(a, b, c);
+    for (std::size_t k = 0; k < n; ++k) {
+        const dspirit expected = fma(a[k], b[k], c[k]);
+        assert(sameParts(out[k], expected));
+        assert(sameParts(result[k], expected));
+        assert(sameParts(kernel::fma(a.parts(k), b.parts(k), c.parts(k)), expected.toParts()));
+    }
+
+    // out совпадает со слагаемым
+    batch::fma(a, b, c, c);
+    for (std::size_t k = 0; k < n; ++k) assert(sameParts(c[k], out[k]));
+
+    std::cout << "Kernel and batch fma passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing fused multiply-add ===\n" << std::endl;
+
+    test_random();
+    test_special();
+    test_kernel_and_batch();
+
+    std::cout << "=== All fused multiply-add tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Ленивый граф выражений: общие подвыражения, пакетное исполнение, владение узлами
+#undef NDEBUG
+#include "paradox/graph.h"
+#include "test_common.h"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Узлы хранят адрес графа: копия или перемещение оставили бы их висячими
+static_assert(!std::is_copy_constructible<expr_graph>::value, "expr_graph must not be copyable");
+static_assert(!std::is_copy_assignable<expr_graph>::value, "expr_graph must not be copyable");
+static_assert(!std::is_move_constructible<expr_graph>::value, "expr_graph must not be movable");
+static_assert(!std::is_move_assignable<expr_graph>::value, "expr_graph must not be movable");
+
+void test_sharing() {
+    std::cout << "Testing common subexpressions..." << std::endl;
+
+    expr_graph g;
+    const graph_node v = g.input("v"), c = g.input("c");
+    assert(g.input("v").index() == v.index());
+    assert(g.inputCount() == 2 && g.inputName(1) == "c");
+
+    // c * c и v * v встречаются дважды, но хранятся один раз
+    const graph_node a = (v * v) / (c * c);
+    const std::size_t size = g.size();
+    const graph_node b = (v * v) / (c * c);
+    assert(b.index() == a.index() && g.size() == size);
+    assert(g.constant(dspirit(2.0)).index() == g.constant(dspirit(2.0)).index());
+
+    std::cout << "Common subexpressions passed!\n" << std::endl;
+}
+
+void test_evaluate() {
+    std::cout << "Testing compiled evaluation..." << std::endl;
+
+    expr_graph g;
+    const graph_node v = g.input("v"), c = g.input("c");
+    const graph_node gamma = 1.0 / sqrt(1.0 - (v * v) / (c * c));
+    const graph_node beta = v / c;
+    const graph_program p = g.compile({gamma, beta});
+    assert(p.inputCount() == 2 && p.outputCount() == 2);
+
+    // Несколько блоков строк и неполный последний
+    const std::size_t n = 3000;
+    dspirit_array vs(n), cs(n), gs(n), bs(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        vs.set(k, dspirit(0.0001 * static_cast<double>(k + 1)));
+        cs.set(k, dspirit(1.0));
+    }
+    cs.set(7, dspirit::INF);
+    p.evaluate({vs.view(), cs.view()}, {gs.view(), bs.view()});
+
+    for (std::size_t k = 0; k < n; ++k) {
+        const dspirit vk = vs[k], ck = cs[k];
+        const dspirit expected = dspirit::ONE / sqrt(dspirit::ONE - (vk * vk) / (ck * ck));
+        assert(sameParts(gs[k], expected));
+        assert(sameParts(bs[k], vk / ck));
+    }
+
+    // Одна строка тем же кодом
+    const std::vector<dspirit> row = p.evaluate({vs[7], cs[7]});
+    assert(sameParts(row[0], gs[7]) && sameParts(row[1], bs[7]));
+
+    std::cout << "Compiled evaluation passed!\n" << std::endl;
+}
+
+void test_ownership() {
+    std::cout << "Testing node ownership..." << std::endl;
+
+    expr_graph g, h;
+    const graph_node x = g.input("x"), y = h.input("y");
+    assert(x.graph() == &g && y.graph() == &h);
+
+    bool rejected = false;
+    try {
+        (void)(x + y);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    rejected = false;
+    try {
+        (void)g.compile({y});
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    rejected = false;
+    try {
+        (void)sqrt(graph_node());
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    std::cout << "Node ownership passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing expression graph ===\n" << std::endl;
+
+    test_sharing();
+    test_evaluate();
+    test_ownership();
+
+    std::cout << "=== All expression graph tests passed! ===" << std::endl;
+    return 0;
+}
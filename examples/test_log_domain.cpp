@@ -0,0 +1,98 @@
+// log_dspirit: logSumExp против попарного сложения
+#undef NDEBUG
+#include "paradox/log_domain.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace paradox;
+
+namespace {
+
+log_dspirit value(double r, double level) {
+    return log_dspirit::fromParts({r, 0.0, 0.0, level});
+}
+
+bool close(const dspirit_parts& a, const dspirit_parts& b, double tolerance) {
+    return a.level == b.level && std::abs(a.r - b.r) <= tolerance * std::abs(b.r);
+}
+
+void test_cancellation() {
+    std::cout << "Testing cancellation on the top level..." << std::endl;
+
+    // 1@0 - 1@0 + 5@-1: старший уровень сокращается, остаётся 5@-1
+    const log_dspirit terms[] = {value(1.0, 0.0), value(-1.0, 0.0), value(5.0, -1.0)};
+    const dspirit_parts sum = logSumExp(terms, 3).toParts();
+    const dspirit_parts pairwise = (terms[0] + terms[1] + terms[2]).toParts();
+    const dspirit_parts plain = (dspirit(1.0) + dspirit(-1.0) + dspirit::fromLevel(5.0, -1.0)).toParts();
+    assert(close(sum, pairwise, 1e-15));
+    assert(close(sum, plain, 1e-15));
+    assert(close(sum, {5.0, 0.0, 0.0, -1.0}, 1e-15));
+
+    // Два уровня сокращаются, младший в начале списка
+    const log_dspirit deep[] = {value(-2.0, -3.0), value(2.0, 1.0), value(3.0, -1.0),
+                                value(-2.0, 1.0), value(-3.0, -1.0), value(7.0, -3.0)};
+    assert(close(logSumExp(deep, 6).toParts(), {5.0, 0.0, 0.0, -3.0}, 1e-14));
+
+    // Полное сокращение - суперноль
+    const log_dspirit all[] = {value(4.0, 2.0), value(-4.0, 2.0), value(1.0, 0.0), value(-1.0, 0.0)};
+    assert(std::isinf(logSumExp(all, 4).level) && logSumExp(all, 4).level < 0.0);
+
+    std::cout << "Cancellation passed!\n" << std::endl;
+}
+
+void test_pairwise_order() {
+    std::cout << "Testing pairwise order dependence..." << std::endl;
+
+    // Попарное сложение отбрасывает младший уровень сразу: результат
+    // зависит от порядка, logSumExp и dspirit - нет
+    const log_dspirit one = value(1.0, 0.0), minus_one = value(-1.0, 0.0), low = value(5.0, -1.0);
+    const dspirit_parts late = ((one + low) + minus_one).toParts();
+    assert(std::isinf(late.level) && late.level < 0.0);
+    assert(close(((one + minus_one) + low).toParts(), {5.0, 0.0, 0.0, -1.0}, 1e-15));
+
+    const log_dspirit forward[] = {one, low, minus_one};
+    const log_dspirit backward[] = {minus_one, low, one};
+    assert(close(logSumExp(forward, 3).toParts(), {5.0, 0.0, 0.0, -1.0}, 1e-15));
+    assert(close(logSumExp(backward, 3).toParts(), {5.0, 0.0, 0.0, -1.0}, 1e-15));
+
+    const dspirit exact = (dspirit(1.0) + dspirit::fromLevel(5.0, -1.0)) + dspirit(-1.0);
+    assert(close(exact.toParts(), {5.0, 0.0, 0.0, -1.0}, 1e-15));
+
+    std::cout << "Pairwise order dependence passed!\n" << std::endl;
+}
+
+void test_random_sums() {
+    std::cout << "Testing random single-level sums..." << std::endl;
+
+    std::mt19937_64 rng(45);
+    std::uniform_real_distribution<double> magnitude(0.1, 100.0);
+    for (int trial = 0; trial < 1000; ++trial) {
+        std::vector<log_dspirit> terms;
+        dspirit expected = dspirit::fromLevel(magnitude(rng), 1.0);
+        terms.push_back(log_dspirit::fromDspirit(expected));
+        for (int k = 0; k < 20; ++k) {
+            const dspirit v = dspirit::fromLevel(magnitude(rng), (k % 4 == 0) ? 0.0 : 1.0);
+            terms.push_back(log_dspirit::fromDspirit(v));
+            if (k % 4 != 0) expected = expected + v;
+        }
+        assert(close(logSumExp(terms.data(), terms.size()).toParts(), expected.toParts(), 1e-12));
+    }
+
+    std::cout << "Random sums passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing log-domain sums ===\n" << std::endl;
+
+    test_cancellation();
+    test_pairwise_order();
+    test_random_sums();
+
+    std::cout << "=== All log-domain tests passed! ===" << std::endl;
+    return 0;
+}
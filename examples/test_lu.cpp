@@ -0,0 +1,106 @@
+// LU: невязка a * solve(a, b) против b, в том числе с ZERO и INF
+#undef NDEBUG
+#include "paradox/lu.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Больше полосы из 8 столбцов и нескольких уровней рекурсии
+const std::size_t N = 100;
+
+void checkResidual(const dspirit_matrix& a, const dspirit_array& x, const dspirit_array& b, double tolerance) {
+    const dspirit_array ax = a * x;
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        if (!(std::abs(standard(ax.parts(i)) - standard(b.parts(i))) <= tolerance)) {
+            std::cerr << "residual too large in row " << i << std::endl;
+            assert(false);
+        }
+    }
+}
+
+// Случайная матрица с преобладающей диагональю и изредка ZERO; каждый
+// седьмой диагональный элемент - INF (идеальная связь узла с землёй)
+dspirit_matrix sample(std::mt19937_64& rng, bool infinite) {
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    dspirit_matrix a(N, N);
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            dspirit x(value(rng));
+            if (rng() % 50 == 0) x = dspirit::ZERO * x;
+            if (i == j) x = x + (infinite && i % 7 == 3 ? dspirit::INF : dspirit(4.0));
+            a.set(i, j, x);
+        }
+    }
+    return a;
+}
+
+dspirit_array rightSide(std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    dspirit_array b(N);
+    for (std::size_t i = 0; i < N; ++i) b.set(i, dspirit(value(rng)));
+    return b;
+}
+
+void test_random() {
+    std::cout << "Testing residual on " << N << "x" << N << " matrices..." << std::endl;
+
+    std::mt19937_64 rng(48);
+    for (bool infinite : {false, true}) {
+        const dspirit_matrix a = sample(rng, infinite);
+        const dspirit_array b = rightSide(rng);
+        checkResidual(a, solve(a, b, 1), b, 1e-12);
+        checkResidual(a, solve(a, b, 4), b, 1e-12);
+    }
+
+    // a * a^-1 = E по стандартной части
+    const dspirit_matrix a = sample(rng, false);
+    const dspirit_matrix product = a * inverse(a);
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            assert(std::abs(standard(product.parts(i, j)) - (i == j ? 1.0 : 0.0)) <= 1e-12);
+        }
+    }
+
+    std::cout << "Random residual passed!\n" << std::endl;
+}
+
+void test_shorts() {
+    std::cout << "Testing a chain of shorts..." << std::endl;
+
+    // Узлы 0 - 1 - 2 связаны бесконечными проводимостями, каждый - с землёй
+    // через 1 См; ток 3 А в узел 0 даёт 1 В во всех узлах
+    dspirit_matrix g(3, 3, dspirit::ZERO);
+    g.set(0, 0, dspirit::INF + dspirit(1.0));
+    g.set(0, 1, -dspirit::INF);
+    g.set(1, 0, -dspirit::INF);
+    g.set(1, 1, dspirit::INF + dspirit::INF + dspirit(1.0));
+    g.set(1, 2, -dspirit::INF);
+    g.set(2, 1, -dspirit::INF);
+    g.set(2, 2, dspirit::INF + dspirit(1.0));
+    const dspirit_array b = {3.0, 0.0, 0.0};
+
+    const dspirit_array v = solve(g, b);
+    for (std::size_t i = 0; i < 3; ++i) assert(std::abs(standard(v.parts(i)) - 1.0) <= 1e-14);
+    checkResidual(g, v, b, 1e-14);
+
+    std::cout << "Chain of shorts passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing LU solver ===\n" << std::endl;
+
+    test_random();
+    test_shorts();
+
+    std::cout << "=== All LU solver tests passed! ===" << std::endl;
+    return 0;
+}
@@ -148,14 +148,15 @@ void test_math_functions() {
     assert(sqrt(dspirit(4.0)) == dspirit(2.0));
     assert(sqrt(dspirit(9.0)) == dspirit(3.0));
     assert(sqrt(dspirit::ZERO) == dspirit::ZERO);
-    assert(sqrt(dspirit::INF) == dspirit::INF);
+    assert(sqrt(dspirit::INF) == dspirit::fromLevel(1.0, 0.5));
+    assert(sqrt(dspirit::fromLevel(4.0, 2.0)) == dspirit::fromLevel(2.0, 1.0));
     
     // pow
     assert(pow(dspirit(2.0), 3.0) == dspirit(8.0));
     assert(pow(dspirit(3.0), 2.0) == dspirit(9.0));
     assert(pow(dspirit(2.0), 0.0) == dspirit::ONE);
     assert(pow(dspirit::ZERO, 2.0) == dspirit::ZERO);
-    assert(pow(dspirit::INF, 2.0) == dspirit::INF);
+    assert(pow(dspirit::INF, 2.0) == dspirit::fromLevel(1.0, 2.0));
     
     // exp и log
     assert(exp(dspirit::ZERO) == dspirit::ONE);
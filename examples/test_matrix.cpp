@@ -0,0 +1,113 @@
+// gemm и gemv против последовательного скалярного произведения
+#undef NDEBUG
+#include "paradox/matrix.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace paradox;
+
+namespace {
+
+// Размеры по разные стороны блоков MC = 64, KC = NC = 256 и микроядра 4 x 8
+const std::size_t M = 69;
+const std::size_t K = 259;
+const std::size_t N = 261;
+
+// Порядок сложения в gemm другой: уровень тот же, компоненты - с допуском
+bool close(const dspirit_parts& a, const dspirit_parts& b, double tolerance) {
+    const double scale = std::abs(b.r) + std::abs(b.i) + std::abs(b.j);
+    return a.level == b.level && std::abs(a.r - b.r) <= tolerance * scale &&
+           std::abs(a.i - b.i) <= tolerance * scale && std::abs(a.j - b.j) <= tolerance * scale;
+}
+
+// Обычные числа и изредка ZERO и суперноль
+dspirit_matrix sample(std::size_t rows, std::size_t cols, matrix_layout layout, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> value(-2.0, 2.0);
+    std::uniform_int_distribution<int> kind(0, 99);
+    dspirit_matrix m(rows, cols, layout);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            const int k = kind(rng);
+            if (k == 0) m.set(i, j, dspirit::ZERO * dspirit(value(rng)));
+            else if (k == 1) m.set(i, j, dspirit::ZERO * dspirit::ZERO);
+            else m.set(i, j, dspirit(value(rng)));
+        }
+    }
+    return m;
+}
+
+dspirit naiveDot(const dspirit_matrix& a, const dspirit_matrix& b, std::size_t i, std::size_t j) {
+    dspirit sum = a(i, 0) * b(0, j);
+    for (std::size_t k = 1; k < a.cols(); ++k) sum = sum + a(i, k) * b(k, j);
+    return sum;
+}
+
+void test_gemm(matrix_layout la, matrix_layout lb, unsigned threads) {
+    std::mt19937_64 rng(47);
+    const dspirit_matrix a = sample(M, K, la, rng);
+    const dspirit_matrix b = sample(K, N, lb, rng);
+    dspirit_matrix c(M, N, matrix_layout::row_major);
+    gemm(a, b, c, threads);
+
+    for (std::size_t i = 0; i < M; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+            if (!close(c.parts(i, j), naiveDot(a, b, i, j).toParts(), 1e-12)) {
+                std::cerr << "gemm differs at (" << i << ", " << j << ")" << std::endl;
+                assert(false);
+            }
+        }
+    }
+}
+
+void test_block_boundaries() {
+    std::cout << "Testing gemm " << M << "x" << K << " * " << K << "x" << N << "..." << std::endl;
+
+    test_gemm(matrix_layout::row_major, matrix_layout::row_major, 1);
+    test_gemm(matrix_layout::column_major, matrix_layout::row_major, 3);
+    test_gemm(matrix_layout::row_major, matrix_layout::column_major, 0);
+
+    std::cout << "gemm passed!\n" << std::endl;
+}
+
+void test_infinity() {
+    std::cout << "Testing gemm with INF entries..." << std::endl;
+
+    // INF на уровне 1 перекрывает обычные слагаемые строки
+    std::mt19937_64 rng(470);
+    dspirit_matrix a = sample(M, K, matrix_layout::row_major, rng);
+    const dspirit_matrix b = sample(K, N, matrix_layout::row_major, rng);
+    a.set(3, 256, dspirit::INF);  // первый столбец второго блока KC
+    dspirit_matrix c(M, N);
+    gemm(a, b, c);
+    for (std::size_t j = 0; j < N; ++j) assert(close(c.parts(3, j), naiveDot(a, b, 3, j).toParts(), 1e-12));
+    for (std::size_t j = 0; j < N; ++j) assert(close(c.parts(4, j), naiveDot(a, b, 4, j).toParts(), 1e-12));
+
+    std::cout << "INF entries passed!\n" << std::endl;
+}
+
+void test_gemv() {
+    std::cout << "Testing gemv..." << std::endl;
+
+    std::mt19937_64 rng(4700);
+    const dspirit_matrix a = sample(M, K, matrix_layout::column_major, rng);
+    const dspirit_matrix x = sample(K, 1, matrix_layout::row_major, rng);
+    const dspirit_array y = a * x.data();
+    for (std::size_t i = 0; i < M; ++i) assert(close(y.parts(i), naiveDot(a, x, i, 0).toParts(), 1e-12));
+
+    std::cout << "gemv passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing dense matrices ===\n" << std::endl;
+
+    test_block_boundaries();
+    test_infinity();
+    test_gemv();
+
+    std::cout << "=== All dense matrix tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Обычные числа без Pimpl: быстрый путь операторов против полного пути Impl
+// (kernel:: работает с Impl напрямую и быстрого пути не имеет)
+#undef NDEBUG
+#include "paradox/dspirit.h"
+#include "paradox/kernel.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+// Результат ядра в каноническом виде dspirit
+dspirit_parts canonical(const dspirit_parts& x) {
+    return dspirit::fromParts(x).toParts();
+}
+
+// Граничные значения и случайные числа
+std::vector<dspirit> sample() {
+    const double max = std::numeric_limits<double>::max();
+    const double min = std::numeric_limits<double>::min();
+    const double denormal = std::numeric_limits<double>::denorm_min();
+    const double near_zero = min * 100.0;
+    const double edges[] = {1.0, 0.5, 2.0, 3.0, 1.0 / 3.0, 1e-300, 1e300, 1e154, 1e-154,
+                            max, max / 2.0, near_zero, near_zero * 2.0, near_zero / 2.0,
+                            min, denormal, 0.0, 1.0 + 1e-15, 1e16, 1e-16};
+
+    std::vector<dspirit> values;
+    for (double e : edges) {
+        values.push_back(dspirit(e));
+        values.push_back(dspirit(-e));
+    }
+    values.push_back(dspirit::ZERO);
+    values.push_back(dspirit::INF);
+    values.push_back(dspirit::NEG_INF);
+    values.push_back(dspirit::EPSILON);
+    values.push_back(dspirit(1.0) - dspirit(1.0));
+    values.push_back(dspirit::fromLevel(2.0, 1.0));
+    values.push_back(dspirit::fromLevel(-3.0, -1.0));
+    values.push_back(dspirit::fromLevel(1.5, 0.5));
+    values.push_back(dspirit::fromParts({2.0, 0.5, 0.25, 0.0}));
+    values.push_back(dspirit::fromParts({-1.0, 3.0, 0.0, 1.0}));
+    values.push_back(dspirit(std::numeric_limits<double>::infinity()));
+    values.push_back(dspirit(std::numeric_limits<double>::quiet_NaN()));
+
+    std::mt19937_64 rng(2024);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-1030, 1030);
+    while (values.size() < 222) values.push_back(dspirit(std::ldexp(mantissa(rng), exponent(rng))));
+    return values;
+}
+
+void check(const char* op, const dspirit& result, const dspirit_parts& expected) {
+    if (!sameParts(result.toParts(), canonical(expected))) {
+        std::cerr << op << ": fast path differs from Impl path" << std::endl;
+        assert(false);
+    }
+}
+
+void test_binary_operators(const std::vector<dspirit>& values) {
+    std::cout << "Testing + - * / and comparisons on " << values.size() << " values..." << std::endl;
+
+    for (const dspirit& a : values) {
+        const dspirit_parts pa = a.toParts();
+        check("negate", -a, kernel::negate(pa));
+        for (const dspirit& b : values) {
+            const dspirit_parts pb = b.toParts();
+            check("+", a + b, kernel::add(pa, pb));
+            check("-", a - b, kernel::subtract(pa, pb));
+            check("*", a * b, kernel::multiply(pa, pb));
+            check("/", a / b, kernel::divide(pa, pb));
+
+            dspirit c = a;
+            c += b;
+            check("+=", c, kernel::add(pa, pb));
+            c = a;
+            c *= b;
+            check("*=", c, kernel::multiply(pa, pb));
+
+            assert((a == b) == kernel::equals(pa, pb));
+            assert((a < b) == kernel::less(pa, pb));
+        }
+    }
+
+    std::cout << "Operators passed!\n" << std::endl;
+}
+
+void test_fma(const std::vector<dspirit>& values) {
+    std::cout << "Testing fma..." << std::endl;
+
+    for (std::size_t x = 0; x < values.size(); x += 3) {
+        for (std::size_t y = 1; y < values.size(); y += 5) {
+            for (std::size_t z = 2; z < values.size(); z += 7) {
+                const dspirit &a = values[x], &b = values[y], &c = values[z];
+                check("fma", fma(a, b, c), kernel::fma(a.toParts(), b.toParts(), c.toParts()));
+            }
+        }
+    }
+
+    std::cout << "fma passed!\n" << std::endl;
+}
+
+void test_moves() {
+    std::cout << "Testing moved-from values..." << std::endl;
+
+    // Источник с Pimpl и обычный
+    for (dspirit source : {dspirit::INF, dspirit(2.5)}) {
+        dspirit target(std::move(source));
+        assert(source == dspirit::ONE);
+        assert(sameParts((source + dspirit(1.0)).toParts(), dspirit(2.0).toParts()));
+        (void)target;
+    }
+
+    dspirit a = dspirit::INF;
+    dspirit b(3.0);
+    a = std::move(b);
+    assert(a == dspirit(3.0));
+    assert(b == dspirit::INF);
+
+    std::cout << "Moved-from values passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing plain fast path ===\n" << std::endl;
+
+    const std::vector<dspirit> values = sample();
+    test_binary_operators(values);
+    test_fma(values);
+    test_moves();
+
+    std::cout << "=== All plain fast path tests passed! ===" << std::endl;
+    return 0;
+}
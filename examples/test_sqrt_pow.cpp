@@ -0,0 +1,93 @@
+// sqrt и pow на (r, i, j, level): уровни, подуровни и суперуровни
+#undef NDEBUG
+#include "paradox/dspirit.h"
+#include "paradox/kernel.h"
+#include "test_common.h"
+#include <cassert>
+#include <iostream>
+#include <limits>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+const double INF_LEVEL = std::numeric_limits<double>::infinity();
+
+bool atLevel(const dspirit& x, double r, double level) {
+    return sameParts(x, dspirit::fromParts({r, 0.0, 0.0, level}));
+}
+
+void test_levels() {
+    std::cout << "Testing sqrt and pow on finite levels..." << std::endl;
+
+    // Уровень делится пополам, а не схлопывается в ZERO и INF
+    assert(atLevel(sqrt(dspirit::ZERO), 1.0, -0.5));
+    assert(atLevel(sqrt(dspirit::INF), 1.0, 0.5));
+    assert(atLevel(sqrt(dspirit::fromLevel(4.0, 2.0)), 2.0, 1.0));
+    assert(atLevel(pow(dspirit::fromLevel(4.0, 2.0), 0.5), 2.0, 1.0));
+    assert(atLevel(pow(dspirit::fromLevel(8.0, -3.0), 1.0 / 3.0), 2.0, -1.0));
+    assert(atLevel(pow(dspirit::fromLevel(2.0, -1.0), 3.0), 8.0, -3.0));
+    assert(atLevel(pow(dspirit::fromLevel(2.0, 1.0), -2.0), 0.25, -2.0));
+
+    // sqrt(4 + 4t) = 2 + t - t^2/4
+    assert(sameParts(sqrt(dspirit::fromParts({4.0, 4.0, 0.0, 0.0})),
+                     dspirit::fromParts({2.0, 1.0, -0.25, 0.0})));
+    // (1 + t)^3 = 1 + 3t + 3t^2
+    assert(sameParts(pow(dspirit::fromParts({1.0, 1.0, 0.0, 0.0}), 3.0),
+                     dspirit::fromParts({1.0, 3.0, 3.0, 0.0})));
+
+    // Дробная степень отрицательного конечного - ошибка области
+    dspirit_parts out;
+    assert(kernel::pow(dspirit(-8.0).toParts(), 1.0 / 3.0, out) == status::domain_error);
+    assert(kernel::pow(dspirit(-2.0).toParts(), 3.0, out) == status::ok && out.r == -8.0);
+
+    std::cout << "Finite levels passed!\n" << std::endl;
+}
+
+void test_super_levels() {
+    std::cout << "Testing sqrt and pow on super levels..." << std::endl;
+
+    const dspirit& super_zero = dspirit::SUPER_ZERO;
+    const dspirit& super_inf = dspirit::SUPER_INF;
+
+    // Суперуровни остаются суперуровнями: sqrt(суперноль) раньше давал ZERO
+    assert(atLevel(sqrt(super_zero), 1.0, -INF_LEVEL));
+    assert(atLevel(sqrt(super_inf), 1.0, INF_LEVEL));
+    assert(atLevel(dspirit::ONE / sqrt(super_zero), 1.0, INF_LEVEL));
+
+    // Целые и дробные степени: знак степени выбирает суперноль или
+    // супербесконечность
+    for (double p : {2.0, 3.0, 0.5, 1.0 / 3.0, 2.5}) {
+        assert(atLevel(pow(super_zero, p), 1.0, -INF_LEVEL));
+        assert(atLevel(pow(super_inf, p), 1.0, INF_LEVEL));
+        assert(atLevel(pow(super_zero, -p), 1.0, INF_LEVEL));
+        assert(atLevel(pow(super_inf, -p), 1.0, -INF_LEVEL));
+    }
+    assert(sameParts(pow(super_zero, 0.0), dspirit::ONE));
+    assert(sameParts(pow(super_inf, 0.0), dspirit::ONE));
+
+    // Отрицательная супербесконечность берётся по модулю, как и раньше
+    assert(atLevel(sqrt(-super_inf), 1.0, INF_LEVEL));
+
+    // То же через kernel, без исключений
+    dspirit_parts out;
+    assert(kernel::sqrt(super_zero.toParts(), out) == status::ok);
+    assert(sameParts(out, super_zero.toParts()));
+    assert(kernel::pow(super_inf.toParts(), -0.5, out) == status::ok);
+    assert(sameParts(out, super_zero.toParts()));
+
+    std::cout << "Super levels passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing sqrt and pow ===\n" << std::endl;
+
+    test_levels();
+    test_super_levels();
+
+    std::cout << "=== All sqrt and pow tests passed! ===" << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Ошибки без исключений: status, result, checked:: и пакетные маски.
+// Собирается и в режиме PARADOX_NO_EXCEPTIONS
+#undef NDEBUG
+#include "paradox/checked.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/kernel.h"
+#include "paradox/status.h"
+#include "test_common.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace paradox;
+using namespace paradox::test;
+
+namespace {
+
+void test_result() {
+    std::cout << "Testing result..." << std::endl;
+
+    const result<dspirit> good = dspirit(2.0);
+    assert(good.ok() && static_cast<bool>(good));
+    assert(good.error() == status::ok);
+    assert(sameParts(good.value(), dspirit(2.0)));
+    assert(sameParts(*good, dspirit(2.0)));
+    assert(sameParts(good.valueOr(dspirit::ONE), dspirit(2.0)));
+
+    const result<dspirit> bad = status::domain_error;
+    assert(!bad.ok() && !static_cast<bool>(bad));
+    assert(bad.error() == status::domain_error);
+    assert(sameParts(bad.valueOr(dspirit::ONE), dspirit::ONE));
+
+    // У каждого кода своё сообщение
+    const status codes[] = {status::ok, status::domain_error, status::invalid_argument,
+                            status::size_mismatch, status::corrupt_data, status::io_error};
+    for (status a : codes) {
+        assert(statusMessage(a) != nullptr && std::strlen(statusMessage(a)) > 0);
+        for (status b : codes) {
+            if (a != b) assert(std::strcmp(statusMessage(a), statusMessage(b)) != 0);
+        }
+    }
+
+    std::cout << "Result passed!\n" << std::endl;
+}
+
+void test_checked() {
+    std::cout << "Testing checked functions..." << std::endl;
+
+    // Значения совпадают с обычными функциями
+    assert(sameParts(checked::sqrt(dspirit(4.0)).value(), sqrt(dspirit(4.0))));
+    assert(sameParts(checked::exp(dspirit(1.0)).value(), exp(dspirit(1.0))));
+    assert(sameParts(checked::log(dspirit(3.0)).value(), log(dspirit(3.0))));
+    assert(sameParts(checked::pow(dspirit(2.0), 10.0).value(), dspirit(1024.0)));
+    assert(sameParts(checked::sin(dspirit(0.5)).value(), sin(dspirit(0.5))));
+    assert(sameParts(checked::cos(dspirit(0.5)).value(), cos(dspirit(0.5))));
+    assert(sameParts(checked::tan(dspirit(0.5)).value(), tan(dspirit(0.5))));
+    assert(sameParts(checked::log1p(dspirit(0.5)).value(), log1p(dspirit(0.5))));
+
+    // Ошибки области определения - код, а не исключение или abort
+    assert(checked::sqrt(dspirit(-1.0)).error() == status::domain_error);
+    assert(checked::log(dspirit(-1.0)).error() == status::domain_error);
+    assert(checked::pow(dspirit(-8.0), 1.0 / 3.0).error() == status::domain_error);
+    assert(checked::sin(dspirit::INF).error() == status::domain_error);
+    assert(checked::cos(dspirit::INF).error() == status::domain_error);
+    assert(checked::log1p(dspirit(-2.0)).error() == status::domain_error);
+
+    // Разбор строки
+    assert(sameParts(checked::parse("1.5").value(), dspirit(1.5)));
+    assert(checked::parse("--1").error() == status::invalid_argument);
+    assert(checked::parse("abc").error() == status::invalid_argument);
+
+    std::cout << "Checked functions passed!\n" << std::endl;
+}
+
+void test_kernel_status() {
+    std::cout << "Testing kernel status..." << std::endl;
+
+    dspirit_parts out;
+    assert(kernel::sqrt(dspirit(9.0).toParts(), out) == status::ok);
+    assert(sameParts(out, dspirit(3.0).toParts()));
+    assert(kernel::sqrt(dspirit(-9.0).toParts(), out) == status::domain_error);
+    assert(kernel::log(dspirit(-1.0).toParts(), out) == status::domain_error);
+    assert(kernel::tan(dspirit::INF.toParts(), out) == status::domain_error);
+
+    std::cout << "Kernel status passed!\n" << std::endl;
+}
+
+void test_batch_failed() {
+    std::cout << "Testing batch failure bits..." << std::endl;
+
+    // Отрицательные - каждый третий элемент, через границу слова
+    const std::size_t n = 150;
+    dspirit_array x(n), out(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        x.set(k, dspirit(k % 3 == 0 ? -1.0 - static_cast<double>(k) : 1.0 + static_cast<double>(k)));
+    }
+
+    std::vector<std::uint64_t> failed(statusWords(n), ~std::uint64_t{0});
+    const std::size_t count = batch::sqrt(x, out, failed.data());
+    assert(count == 50);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (k % 3 == 0) {
+            assert(laneFailed(failed.data(), k));
+            assert(std::isnan(out.parts(k).r) && out.parts(k).level == 0.0);
+        } else {
+            assert(!laneFailed(failed.data(), k));
+            assert(sameParts(out.parts(k), sqrt(x[k]).toParts()));
+        }
+    }
+
+    // Без маски - только счётчик
+    assert(batch::sqrt(x, out) == 50);
+    assert(batch::log(x, out, nullptr) == 50);
+
+    std::cout << "Batch failure bits passed!\n" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Testing status reporting ===\n" << std::endl;
+
+    test_result();
+    test_checked();
+    test_kernel_status();
+    test_batch_failed();
+
+    std::cout << "=== All status reporting tests passed! ===" << std::endl;
+    return 0;
+}
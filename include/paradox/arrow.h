@@ -0,0 +1,100 @@
+#ifndef PARADOX_ARROW_H
+#define PARADOX_ARROW_H
+
+#include "paradox/dspirit_array.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Arrow C Data Interface: структуры ABI из спецификации Arrow, без
+// зависимости от библиотеки Arrow. Определение совместимо с arrow/c/abi.h.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace paradox {
+
+// Экспорт SoA-данных без копирования. Полное представление выходит как
+// struct (формат "+s") с дочерними float64 r, i, j, level и типом-расширением
+// ARROW:extension:name = "paradox.dspirit"; представление из одних r
+// (isPlain) - как обычный float64 ("g"). Структуры заполняются целиком,
+// освобождаются вызовом release по правилам спецификации.
+namespace arrow {
+
+const char* const EXTENSION_NAME = "paradox.dspirit";
+
+// Данные не копируются и должны жить до вызова array->release
+void exportArray(const_dspirit_view values, ArrowSchema* schema, ArrowArray* array);
+
+// Массив переходит во владение ArrowArray (перемещение, без копирования)
+void exportArray(dspirit_array&& values, ArrowSchema* schema, ArrowArray* array);
+
+} // namespace arrow
+
+// Столбец, импортированный из Arrow: владеет ArrowArray и вызывает его
+// release в деструкторе. Представление указывает прямо в буферы Arrow.
+class arrow_column {
+public:
+    arrow_column() = default;
+    ~arrow_column();
+
+    arrow_column(arrow_column&& other) noexcept;
+    arrow_column& operator=(arrow_column&& other) noexcept;
+    arrow_column(const arrow_column&) = delete;
+    arrow_column& operator=(const arrow_column&) = delete;
+
+    // Импорт float64 ("g") как столбца уровня 0 или struct из четырёх
+    // float64 (r, i, j, level - как при экспорте). При успехе array
+    // перемещается в столбец (array->release становится nullptr), schema
+    // остаётся у вызывающего. Значения null не поддерживаются:
+    // status::invalid_argument, как и для других форматов.
+    static status fromArrow(ArrowArray* array, const ArrowSchema* schema, arrow_column& out);
+
+    std::size_t size() const { return view_.size; }
+    const_dspirit_view view() const { return view_; }
+
+private:
+    void reset();
+
+    ArrowArray array_ = ArrowArray();
+    const_dspirit_view view_;
+};
+
+} // namespace paradox
+
+#endif // PARADOX_ARROW_H
@@ -0,0 +1,120 @@
+#ifndef PARADOX_BINARY_H
+#define PARADOX_BINARY_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace paradox {
+
+// Двоичный формат MLNS (версия 1). Все поля - little-endian независимо от
+// платформы, double - IEEE 754 binary64.
+//
+//   заголовок потока (8 байт):  "PDXB", версия u16, флаги u16 (= 0)
+//   блок (16 байт + данные):    тип u32, число значений (младшие 32 бита) u32,
+//                               контрольная сумма данных u32,
+//                               число значений (старшие 32 бита) u32
+//
+// Типы блоков:
+//   plain - n значений double: обычные числа уровня 0 без подуровней
+//           (0.0 обозначает ZERO); читается как kernel::make(x)
+//   full  - плоскости r[n], i[n], j[n], level[n] для остальных значений
+//   end   - последний блок без данных; число значений - всего в потоке
+//
+// Контрольная сумма - Fletcher-64 по 32-битным словам данных блока,
+// свёрнутая в 32 бита. Блок содержит не более BLOCK_VALUES значений.
+namespace binary {
+
+const std::uint16_t VERSION = 1;
+const std::size_t BLOCK_VALUES = 4096;
+
+enum class block_kind : std::uint32_t { plain = 1, full = 2, end = 3 };
+
+// true, если значение записывается в plain-блок без потерь
+bool isPlain(const dspirit_parts& value);
+
+std::uint32_t checksum(const void* data, std::size_t bytes);
+
+} // namespace binary
+
+// Потоковая запись: значения копятся в буфере блока и сбрасываются в поток
+// целыми блоками. Серия plain-значений идёт одним блоком, full-записи - только
+// для значений с подуровнями или ненулевым уровнем.
+class binary_writer {
+public:
+    explicit binary_writer(std::ostream& out);
+    ~binary_writer();
+
+    binary_writer(const binary_writer&) = delete;
+    binary_writer& operator=(const binary_writer&) = delete;
+
+    void write(const dspirit& value);
+    void write(const dspirit_parts& value);
+    void write(const_dspirit_view values);
+
+    // Сбрасывает последний блок и пишет блок end. Вызывается деструктором,
+    // но ошибки потока сообщаются только при явном вызове.
+    void finish();
+
+    std::size_t count() const { return count_; }
+
+private:
+    void flush();
+    void writeBlock(binary::block_kind kind, std::size_t n, const unsigned char* data, std::size_t bytes);
+
+    std::ostream& out_;
+    binary::block_kind kind_;
+    std::size_t pending_;
+    std::size_t count_;
+    bool finished_;
+    std::vector<double> r_, i_, j_, level_;
+    std::vector<unsigned char> bytes_;
+};
+
+// Потоковое чтение: блоки проверяются по контрольной сумме целиком до
+// декодирования; ошибки формата - status::corrupt_data.
+class binary_reader {
+public:
+    explicit binary_reader(std::istream& in);
+
+    binary_reader(const binary_reader&) = delete;
+    binary_reader& operator=(const binary_reader&) = delete;
+
+    // Следующее значение; false - достигнут блок end
+    bool read(dspirit_parts& value);
+    bool read(dspirit& value);
+
+    // Заполняет out до out.size значений; возвращает прочитанное число
+    std::size_t read(dspirit_view out);
+
+    // Оставшиеся значения целиком
+    dspirit_array readAll();
+
+    bool done() const { return done_; }
+    std::size_t count() const { return count_; }
+
+private:
+    bool nextBlock();
+    dspirit_parts decode(std::size_t k) const;
+
+    std::istream& in_;
+    binary::block_kind kind_;
+    std::size_t size_;
+    std::size_t pos_;
+    std::size_t count_;
+    bool done_;
+    std::vector<double> values_;
+    std::vector<unsigned char> bytes_;
+};
+
+// Массив целиком: заголовок, блоки и end
+void writeBinary(std::ostream& out, const_dspirit_view values);
+dspirit_array readBinary(std::istream& in);
+
+} // namespace paradox
+
+#endif // PARADOX_BINARY_H
@@ -0,0 +1,67 @@
+#ifndef PARADOX_CELLS_H
+#define PARADOX_CELLS_H
+
+#include "paradox/dspirit.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace paradox {
+
+// Граф ячеек с инкрементальным пересчётом (как в электронной таблице).
+// Формула может ссылаться только на уже созданные ячейки, поэтому граф
+// ацикличен по построению. После изменения входов recompute() пересчитывает
+// только затронутых потомков: волнами по глубине, независимые ячейки одной
+// волны - параллельно. Новое значение сохраняется всегда; если оно совпадает
+// со старым во всех частях (r, i, j, уровень), потомки не трогаются.
+class cell_graph {
+public:
+    using cell_id = std::uint32_t;
+    using formula = std::function<dspirit(const std::vector<dspirit>& args)>;
+    using listener = std::function<void(cell_id id, const dspirit& value)>;
+
+    // Создание ячеек (формула вычисляется сразу)
+    cell_id addInput(const dspirit& value);
+    cell_id addFormula(formula f, const std::vector<cell_id>& deps);
+
+    // Изменение входа: прямые потомки помечаются грязными
+    void setInput(cell_id id, const dspirit& value);
+
+    // Пересчёт грязных ячеек; возвращает число вычисленных формул
+    std::size_t recompute(unsigned threads = 0);
+
+    // Уведомление о каждой ячейке, значение которой изменилось
+    void onChange(listener callback) { listener_ = std::move(callback); }
+
+    // Доступ
+    const dspirit& value(cell_id id) const { return values_[id]; }
+    bool isInput(cell_id id) const { return !cells_[id].f; }
+    bool isDirty(cell_id id) const { return cells_[id].dirty; }
+    const std::vector<cell_id>& dependencies(cell_id id) const { return cells_[id].deps; }
+    const std::vector<cell_id>& dependents(cell_id id) const { return cells_[id].users; }
+    std::size_t size() const { return cells_.size(); }
+
+private:
+    struct cell {
+        formula f;
+        std::vector<cell_id> deps;
+        std::vector<cell_id> users;
+        std::uint32_t depth = 0;
+        bool dirty = false;
+    };
+
+    cell_id addCell(cell c, const dspirit& value);
+    void markUsers(cell_id id);
+    dspirit evaluate(cell_id id) const;
+
+    std::vector<cell> cells_;
+    std::vector<dspirit> values_;
+    std::vector<std::vector<cell_id>> waves_;  // грязные ячейки по глубине
+    listener listener_;
+};
+
+} // namespace paradox
+
+#endif // PARADOX_CELLS_H
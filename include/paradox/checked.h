@@ -0,0 +1,28 @@
+#ifndef PARADOX_CHECKED_H
+#define PARADOX_CHECKED_H
+
+#include "paradox/dspirit.h"
+#include "paradox/status.h"
+
+#include <string>
+
+namespace paradox {
+namespace checked {
+
+// Варианты функций dspirit без исключений: ошибка возвращается в result
+result<dspirit> sqrt(const dspirit& x);
+result<dspirit> pow(const dspirit& x, double exponent);
+result<dspirit> exp(const dspirit& x);
+result<dspirit> log(const dspirit& x);
+result<dspirit> sin(const dspirit& x);
+result<dspirit> cos(const dspirit& x);
+result<dspirit> tan(const dspirit& x);
+result<dspirit> log1p(const dspirit& x);
+
+// Разбор строки (как dspirit::fromString)
+result<dspirit> parse(const std::string& s);
+
+} // namespace checked
+} // namespace paradox
+
+#endif // PARADOX_CHECKED_H
@@ -0,0 +1,181 @@
+#ifndef PARADOX_CIRCUIT_H
+#define PARADOX_CIRCUIT_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/sparse.h"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace paradox {
+
+enum class circuit_element_type {
+    resistor,        // R: value - сопротивление
+    voltage_source,  // V: value = V(positive) - V(negative)
+    current_source   // I: ток value от positive к negative через источник
+};
+
+struct circuit_element {
+    circuit_element_type type;
+    std::string name;
+    std::size_t positive;
+    std::size_t negative;
+    dspirit value;
+};
+
+// Схема из резисторов и источников. Узел 0 - земля ("0" или "gnd").
+//
+// R = 0 и R = inf - обычные значения: проводимость 1/R равна INF или
+// ZERO, так что идеальные перемычки и разрывы не требуют предварительного
+// слияния узлов.
+class circuit {
+public:
+    static const std::size_t GROUND = 0;
+
+    circuit();
+
+    // Узел по имени (создаётся при первом обращении)
+    std::size_t node(const std::string& name);
+    // Номер узла или npos
+    std::size_t findNode(const std::string& name) const;
+    std::size_t nodeCount() const { return nodeNames_.size(); }
+    const std::string& nodeName(std::size_t k) const { return nodeNames_[k]; }
+
+    // Элементы; возвращают номер элемента. Узел вне схемы -
+    // std::invalid_argument
+    std::size_t add(circuit_element_type type, const std::string& name, std::size_t positive,
+                    std::size_t negative, const dspirit& value);
+    std::size_t resistor(const std::string& name, std::size_t a, std::size_t b, const dspirit& value);
+    std::size_t voltageSource(const std::string& name, std::size_t positive, std::size_t negative,
+                              const dspirit& value);
+    std::size_t currentSource(const std::string& name, std::size_t positive, std::size_t negative,
+                              const dspirit& value);
+
+    std::size_t elementCount() const { return elements_.size(); }
+    const circuit_element& element(std::size_t k) const { return elements_[k]; }
+    // Номер элемента или npos
+    std::size_t findElement(const std::string& name) const;
+
+    // Новое значение элемента; топология не меняется, поэтому
+    // circuit_solver::update переиспользует символьное разложение
+    void setValue(std::size_t element, const dspirit& value);
+
+    // Список соединений в духе SPICE, по элементу в строке:
+    //
+    //   * делитель с идеальной перемычкой
+    //   V1 in 0 12
+    //   R1 in a 10k
+    //   R2 a 0 0        ; R = 0 - идеальный проводник
+    //   R3 a b inf      ; R = inf - разрыв
+    //   I1 0 b 1m
+    //   .end
+    //
+    // Тип - по первой букве имени (R, V, I). Значения - в нотации
+    // dspirit::from_chars с необязательным множителем SPICE (f, p, n, u,
+    // m, k, meg, g, t) и единицей измерения. '*' в начале строки и ';' -
+    // комментарии, директивы '.' кроме .end пропускаются. Ошибка -
+    // std::invalid_argument с номером строки
+    static circuit parse(std::istream& in);
+    static circuit parse(std::string_view text);
+
+private:
+    std::vector<std::string> nodeNames_;
+    std::unordered_map<std::string, std::size_t> nodes_;
+    std::vector<circuit_element> elements_;
+    std::unordered_map<std::string, std::size_t> elementNames_;
+};
+
+// Узловой анализ схемы: G v = i, где G - разреженная матрица проводимостей
+// MLNS без узла земли.
+//
+// Источник напряжения заменяется эквивалентом Нортона с проводимостью
+// INF и током V * INF, поэтому G остаётся симметричной и решается
+// разложением L D L^T без выбора ведущего элемента. Уровни MLNS сами
+// разделяют идеальные и обычные проводимости: сокращение уровня INF в
+// ведущем элементе оставляет точную конечную часть.
+//
+// Конструктор выполняет символьный анализ (порядок исключения по
+// приближённой минимальной степени, дерево исключения, структура L) по
+// топологии схемы, включая разрывы, и численное разложение. update()
+// повторяет только численную часть. Проводимость ниже нулевого уровня
+// (R = inf) в численную часть не входит: разрыв - точное отсутствие
+// связи. Узел без соединений (например, только через R = inf) получает
+// ведущий элемент ZERO - проводимость разрыва на землю: без тока его
+// потенциал 0, с током - бесконечность.
+class circuit_solver {
+public:
+    circuit_solver() = default;
+    explicit circuit_solver(const circuit& c);
+
+    // Новые значения элементов той же топологии (узлы и типы элементов);
+    // иначе std::invalid_argument
+    void update(const circuit& c);
+
+    // Потенциал узла (у земли - точный ноль)
+    dspirit voltage(std::size_t node) const;
+    // Потенциалы всех узлов по номерам circuit
+    const dspirit_array& voltages() const { return voltages_; }
+
+    // Ток через элемент от positive к negative. У идеальных элементов
+    // (R = 0, источники напряжения) ток определяется младшими частями
+    // падения напряжения: старшие части потенциалов, совпадающие с
+    // относительной точностью IDEAL_DROP_TOLERANCE, считаются равными.
+    // Допуск покрывает ошибку округления разложения (порядка 1e-13 на
+    // сетках в тысячи узлов) с запасом; разность больше допуска - реальное
+    // падение, и ток через идеальный элемент бесконечен.
+    //
+    // Проводимость ниже нулевого уровня (R = inf) в G не хранится, поэтому
+    // ток разрыва - точный ноль (суперноль), и закон Кирхгофа выполняется
+    // для токов, которые даёт current(). Исключение - узел, связанный
+    // только разрывами: ток источника в него уходит на землю через
+    // ведущий элемент ZERO, которому не соответствует элемент схемы
+    dspirit current(const circuit& c, std::size_t element) const;
+
+    static constexpr double IDEAL_DROP_TOLERANCE = 1e-9;
+
+    // Матрица проводимостей и правая часть (без земли: узел k - строка k - 1)
+    const sparse_matrix& conductance() const { return conductance_; }
+    const dspirit_array& injections() const { return injections_; }
+
+    // Число элементов L вне диагонали и узлов с заменённым ведущим элементом
+    std::size_t factorNonZeros() const { return factorIndices_.size(); }
+    std::size_t floatingNodes() const { return floating_; }
+
+private:
+    void analyze(const circuit& c);
+    void factor(const circuit& c);
+
+    // Топология, по которой построен анализ: выводы и типы элементов
+    // (источник тока не входит в структуру G)
+    std::vector<std::size_t> terminals_;
+    std::vector<circuit_element_type> types_;
+
+    // Порядок исключения: order_[k] - неизвестная на шаге k, position_ - обратный
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> position_;
+
+    // Верхний треугольник переставленной G по столбцам
+    std::vector<std::size_t> matrixOffsets_;
+    std::vector<std::size_t> matrixIndices_;
+
+    // Дерево исключения и L по столбцам (строки в порядке возрастания)
+    std::vector<std::size_t> parent_;
+    std::vector<std::size_t> factorOffsets_;
+    std::vector<std::size_t> factorIndices_;
+    dspirit_array factorValues_;
+    dspirit_array diagonal_;
+    std::size_t floating_ = 0;
+
+    sparse_matrix conductance_;
+    dspirit_array injections_;
+    dspirit_array voltages_;
+};
+
+} // namespace paradox
+
+#endif // PARADOX_CIRCUIT_H
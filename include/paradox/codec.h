@@ -0,0 +1,73 @@
+#ifndef PARADOX_CODEC_H
+#define PARADOX_CODEC_H
+
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace paradox {
+
+// Сжатие столбцов MLNS порциями (chunk). Рассчитано на типичные данные:
+// почти все значения уровня 0 с нулевыми i и j.
+//
+//   level - ничего (все 0), RLE серий или разреженный список отличных от 0
+//   i, j  - разреженно: позиции (битовая карта или u16) и значения != 0
+//   r     - перестановка байтов (byte-shuffle) по 8 плоскостям; каждая
+//           плоскость с не более чем 16 различными байтами упаковывается
+//           словарём в 0, 1, 2 или 4 бита на значение
+//
+// Порции кодируются и декодируются независимо (и параллельно); у каждой
+// своя контрольная сумма. Формат little-endian:
+//
+//   заголовок:  "PDXZ", версия u16, флаги u16, значений в порции u32,
+//               число порций u32, число значений u64
+//   порция:     значений u32, флаги u32, байты r u32, байты level u32,
+//               байты i/j u32, контрольная сумма u32, затем данные секций
+namespace codec {
+
+const std::uint16_t VERSION = 1;
+const std::size_t MAX_CHUNK_VALUES = 65536;
+
+struct options {
+    bool shuffle = true;   // перестановка байтов r
+    bool entropy = true;   // словарная упаковка плоскостей (только с shuffle)
+    std::size_t chunkValues = MAX_CHUNK_VALUES;
+    unsigned threads = 0;  // 0 - по числу аппаратных потоков
+};
+
+} // namespace codec
+
+// Сжатый массив в памяти: байты формата и смещения порций.
+// Порцию можно распаковать отдельно, не трогая остальные.
+class compressed_array {
+public:
+    compressed_array() = default;
+    explicit compressed_array(const_dspirit_view values, const codec::options& opts = codec::options());
+
+    // Из байтов формата (проверяются заголовки; суммы - при распаковке)
+    static compressed_array fromBytes(std::vector<unsigned char> bytes);
+
+    std::size_t size() const { return size_; }
+    std::size_t chunkCount() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    std::size_t chunkValues() const { return chunkValues_; }
+
+    // Сжатые данные
+    const std::vector<unsigned char>& bytes() const { return bytes_; }
+
+    // Распаковка в SoA-буферы: out.size == size() (или размер порции)
+    void decode(dspirit_view out, unsigned threads = 0) const;
+    void decodeChunk(std::size_t chunk, dspirit_view out) const;
+    dspirit_array toArray(unsigned threads = 0) const;
+
+private:
+    std::vector<unsigned char> bytes_;
+    std::vector<std::size_t> offsets_;  // начала порций и конец данных
+    std::size_t size_ = 0;
+    std::size_t chunkValues_ = codec::MAX_CHUNK_VALUES;
+};
+
+} // namespace paradox
+
+#endif // PARADOX_CODEC_H
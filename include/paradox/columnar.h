@@ -0,0 +1,107 @@
+#ifndef PARADOX_COLUMNAR_H
+#define PARADOX_COLUMNAR_H
+
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace paradox {
+
+// Столбцовый файл MLNS (версия 1) для данных больше оперативной памяти.
+// Плоскости r, i, j и level лежат отдельными непрерывными блоками, каждый
+// начинается с собственной страницы заголовка, данные - со следующей
+// границы страницы (PAGE_BYTES). Все поля - little-endian.
+//
+//   страница 0:  "PDXC", версия u16, флаги u16, размер страницы u32,
+//                число столбцов u32 (1 или 4), число значений u64,
+//                таблица смещений заголовков столбцов u64[столбцы]
+//   столбец:     страница "PDXK", номер u32, число значений u64,
+//                смещение данных u64; затем значения double
+//
+// Файл из одного столбца r хранит обычные числа уровня 0
+// (читается как kernel::make(r)).
+namespace columnar {
+
+const std::uint16_t VERSION = 1;
+const std::size_t PAGE_BYTES = 4096;
+
+enum class column : std::uint32_t { r = 0, i = 1, j = 2, level = 3 };
+
+} // namespace columnar
+
+// Потоковая запись: число значений задаётся заранее, поэтому каждый столбец
+// пишется сразу на своё место, без промежуточных файлов.
+class columnar_writer {
+public:
+    // plain = true - только столбец r; значения должны быть binary::isPlain
+    columnar_writer(const std::string& path, std::size_t size, bool plain = false);
+    ~columnar_writer();
+
+    columnar_writer(const columnar_writer&) = delete;
+    columnar_writer& operator=(const columnar_writer&) = delete;
+
+    // Следующие values.size значений
+    void write(const_dspirit_view values);
+
+    // Проверяет, что записаны все size значений, и закрывает файл
+    void finish();
+
+    std::size_t size() const { return size_; }
+    std::size_t count() const { return count_; }
+
+private:
+    void writeColumn(std::size_t c, const double* values, std::size_t n);
+
+    std::ofstream out_;
+    std::size_t size_;
+    std::size_t count_;
+    std::size_t columns_;
+    std::uint64_t data_[4];
+    bool finished_;
+};
+
+// Файл целиком; для представления без плоскостей i, j, level - один столбец
+void writeColumnar(const std::string& path, const_dspirit_view values);
+
+// Файл, отображённый в память (mmap / MapViewOfFile). Конструктор читает
+// только заголовки; значения подгружаются страничным кэшем ОС при первом
+// обращении. Представления указывают прямо в отображение и действительны,
+// пока жив объект.
+class columnar_file {
+public:
+    explicit columnar_file(const std::string& path);
+    ~columnar_file();
+
+    columnar_file(columnar_file&& other) noexcept;
+    columnar_file& operator=(columnar_file&& other) noexcept;
+    columnar_file(const columnar_file&) = delete;
+    columnar_file& operator=(const columnar_file&) = delete;
+
+    std::size_t size() const { return size_; }
+    bool isPlain() const { return view_.isPlain(); }
+
+    const_dspirit_view view() const { return view_; }
+
+    // Значения [offset, offset + n); выход за границы - status::invalid_argument
+    const_dspirit_view slice(std::size_t offset, std::size_t n) const;
+
+    // Подсказка ОС заранее прочитать страницы диапазона (madvise WILLNEED)
+    void prefetch(std::size_t offset, std::size_t n) const;
+
+private:
+    void close();
+
+    const unsigned char* data_ = nullptr;
+    std::size_t bytes_ = 0;
+    std::size_t size_ = 0;
+    const_dspirit_view view_;
+    double* swapped_ = nullptr;  // копия столбцов на big-endian платформах
+    void* mapping_ = nullptr;    // объект отображения Windows
+};
+
+} // namespace paradox
+
+#endif // PARADOX_COLUMNAR_H
@@ -0,0 +1,69 @@
+#ifndef PARADOX_COMPACT_H
+#define PARADOX_COMPACT_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace paradox {
+
+// Компактное число MLNS в 16 байтах (вместо указателя и Impl в куче).
+// Тривиально копируемо и выровнено на 16: подходит для массивов и
+// std::atomic<compact_dspirit> (без блокировок там, где есть 16-байтовый
+// CAS - cmpxchg16b с -mcx16 на x86-64, LSE на AArch64).
+//
+// Точность (контракт упаковки fromParts):
+//   r     - double, хранится точно;
+//   i     - float, округление к ближайшему: относительная погрешность
+//           не больше 2^-24 при |i| >= FLT_MIN, ниже - абсолютная не
+//           больше 2^-150 (субнормальные float, затем ноль);
+//   j     - bfloat16 (старшие 16 бит float), округление к ближайшему:
+//           относительная погрешность не больше 2^-8 при |j| >= FLT_MIN,
+//           ниже - абсолютная не больше 2^-134;
+//   level - кратен 1/16 в [-2047.9375, 2047.875] или суперуровень (±inf).
+// |i| и |j| больше FLT_MAX не упаковываются. NaN сохраняется.
+// Расширение (toParts, toDspirit) всегда точное, и повторная упаковка
+// расширенного значения даёт те же биты.
+struct alignas(16) compact_dspirit {
+    double r;
+    float i;
+    std::uint16_t j;     // bfloat16
+    std::int16_t level;  // уровень * LEVEL_SCALE или LEVEL_SUPER_*
+
+    static constexpr int LEVEL_SCALE = 16;
+    static constexpr std::int16_t LEVEL_SUPER_INF = 32767;    // уровень +inf
+    static constexpr std::int16_t LEVEL_SUPER_ZERO = -32768;  // уровень -inf
+
+    // Упаковка: status::invalid_argument, если уровень не представим или
+    // i, j вне диапазона float (out тогда не меняется)
+    static status fromParts(const dspirit_parts& value, compact_dspirit& out) noexcept;
+
+    // То же с исключением std::invalid_argument
+    static compact_dspirit fromParts(const dspirit_parts& value);
+    static compact_dspirit fromDspirit(const dspirit& value);
+
+    // Точное расширение
+    dspirit_parts toParts() const noexcept;
+    dspirit toDspirit() const;
+};
+
+static_assert(sizeof(compact_dspirit) == 16, "compact_dspirit must be 16 bytes");
+
+namespace batch {
+
+// Упаковка SoA в компактный массив (out - x.size элементов). Непредставимые
+// элементы получают NaN уровня 0 и бит в failed (statusWords(n) слов, может
+// быть nullptr); возвращается их число.
+std::size_t pack(const_dspirit_view x, compact_dspirit* out, std::uint64_t* failed = nullptr);
+
+// Точная распаковка в SoA (out.size элементов)
+void unpack(const compact_dspirit* x, dspirit_view out);
+
+} // namespace batch
+
+} // namespace paradox
+
+#endif // PARADOX_COMPACT_H
@@ -0,0 +1,124 @@
+#ifndef PARADOX_COMPLEX_H
+#define PARADOX_COMPLEX_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace paradox {
+
+// Комплексное число MLNS: вещественная и мнимая части хранятся рядом
+// (массив complex_dspirit - чередование re, im), без Pimpl и выделения
+// памяти. Части могут быть точными нулями и бесконечностями разных
+// уровней: импеданс идеальной индуктивности jωL при ω = inf и т.п.
+//
+// Без мнимой части число вещественное: im = SUPER_ZERO (точный ноль).
+// Явный 0.0 или ZERO - бесконечно малая, и INF * ZERO = 1 попадает в
+// результат: (5 + INF i) * (2 + 0.0 i) = 9 + 2INF i, а не 10 + 2INF i.
+struct complex_dspirit {
+    dspirit_parts re;
+    dspirit_parts im;
+
+    complex_dspirit(double re = 0.0);
+    complex_dspirit(double re, double im);
+    complex_dspirit(const dspirit& re, const dspirit& im = dspirit::SUPER_ZERO);
+
+    static complex_dspirit fromParts(const dspirit_parts& re, const dspirit_parts& im);
+
+    dspirit real() const { return dspirit::fromParts(re); }
+    dspirit imag() const { return dspirit::fromParts(im); }
+};
+
+// Арифметика. Если все части - обычные double, вычисления идут без Impl.
+// Умножение - тремя произведениями (Гаусс): c(a + b) - b(c + d) и
+// c(a + b) + a(d - c). Если уровни частей множителя различаются, младшая
+// часть пропала бы в сумме a + b, и используется формула с четырьмя
+// произведениями. Деление - по Смиту (через отношение меньшей части
+// знаменателя к большей), без c^2 + d^2 и связанного с ним повышения уровня.
+complex_dspirit operator-(const complex_dspirit& z);
+complex_dspirit operator+(const complex_dspirit& a, const complex_dspirit& b);
+complex_dspirit operator-(const complex_dspirit& a, const complex_dspirit& b);
+complex_dspirit operator*(const complex_dspirit& a, const complex_dspirit& b);
+complex_dspirit operator/(const complex_dspirit& a, const complex_dspirit& b);
+
+bool operator==(const complex_dspirit& a, const complex_dspirit& b);
+bool operator!=(const complex_dspirit& a, const complex_dspirit& b);
+
+complex_dspirit conj(const complex_dspirit& z);
+dspirit norm(const complex_dspirit& z);  // re^2 + im^2
+dspirit abs(const complex_dspirit& z);   // hypot(re, im)
+dspirit arg(const complex_dspirit& z);   // atan2(im, re)
+
+// Вывод в виде (re,im)
+std::ostream& operator<<(std::ostream& os, const complex_dspirit& z);
+
+// Представления комплексных SoA-данных: отдельные плоскости частей
+struct const_complex_view {
+    const_dspirit_view re;
+    const_dspirit_view im;
+
+    std::size_t size() const { return re.size; }
+    complex_dspirit operator[](std::size_t k) const { return complex_dspirit::fromParts(re[k], im[k]); }
+};
+
+struct complex_view {
+    dspirit_view re;
+    dspirit_view im;
+
+    std::size_t size() const { return re.size; }
+    complex_dspirit operator[](std::size_t k) const { return complex_dspirit::fromParts(re[k], im[k]); }
+
+    void store(std::size_t k, const complex_dspirit& value) const {
+        re.store(k, value.re);
+        im.store(k, value.im);
+    }
+
+    operator const_complex_view() const { return {re, im}; }
+};
+
+// Массив комплексных чисел в SoA-раскладке
+class complex_array {
+public:
+    complex_array() = default;
+    explicit complex_array(std::size_t n, const complex_dspirit& value = complex_dspirit());
+
+    std::size_t size() const { return re_.size(); }
+    void resize(std::size_t n, const complex_dspirit& value = complex_dspirit());
+
+    complex_dspirit operator[](std::size_t k) const { return complex_dspirit::fromParts(re_.parts(k), im_.parts(k)); }
+    void set(std::size_t k, const complex_dspirit& value);
+
+    dspirit_array& real() { return re_; }
+    dspirit_array& imag() { return im_; }
+    const dspirit_array& real() const { return re_; }
+    const dspirit_array& imag() const { return im_; }
+
+    complex_view view() { return {re_.view(), im_.view()}; }
+    const_complex_view view() const { return {re_.view(), im_.view()}; }
+    operator complex_view() { return view(); }
+    operator const_complex_view() const { return view(); }
+
+private:
+    dspirit_array re_;
+    dspirit_array im_;
+};
+
+// Пакетные ядра (соглашения как у batch::add над dspirit_view)
+namespace batch {
+
+void negate(const_complex_view x, complex_view out);
+void add(const_complex_view a, const_complex_view b, complex_view out);
+void subtract(const_complex_view a, const_complex_view b, complex_view out);
+void multiply(const_complex_view a, const_complex_view b, complex_view out);
+void divide(const_complex_view a, const_complex_view b, complex_view out);
+void conj(const_complex_view x, complex_view out);
+void abs(const_complex_view x, dspirit_view out);
+void arg(const_complex_view x, dspirit_view out);
+
+} // namespace batch
+
+} // namespace paradox
+
+#endif // PARADOX_COMPLEX_H
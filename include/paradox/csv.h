@@ -0,0 +1,50 @@
+#ifndef PARADOX_CSV_H
+#define PARADOX_CSV_H
+
+#include "paradox/dspirit_array.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace paradox {
+
+// Ошибка разбора строки CSV
+struct csv_error {
+    std::size_t row;     // строка данных (с 0, без заголовка и пустых строк)
+    std::size_t column;  // номер поля
+    status code;         // invalid_argument - поле не разобрано,
+                         // size_mismatch - в строке не то число полей
+};
+
+struct csv_options {
+    char delimiter = ',';
+    bool header = false;          // первая строка - имена столбцов
+    unsigned threads = 0;         // 0 - по числу аппаратных потоков
+    std::size_t maxErrors = 1000; // сколько ошибок сохранить (считаются все)
+};
+
+// Столбцы числового CSV в SoA-раскладке. Поле с ошибкой получает NaN
+// уровня 0, недостающие поля - тоже.
+struct csv_table {
+    std::vector<std::string> names;
+    std::vector<dspirit_array> columns;
+    std::size_t rows = 0;
+    std::vector<csv_error> errors;
+    std::size_t errorCount = 0;
+};
+
+// Загрузка числового CSV. Файл отображается в память и делится на куски по
+// границам строк, которые разбираются параллельно (поля - в формате
+// dspirit::from_chars: 3.5, inf, -inf^2, eps, 2@1). Ошибки в строках не
+// прерывают загрузку и попадают в out.errors; код возврата - только для
+// ошибок открытия файла (status::io_error).
+status loadCsv(const std::string& path, csv_table& out, const csv_options& opts = csv_options());
+
+// То же для текста в памяти
+status parseCsv(const char* first, const char* last, csv_table& out, const csv_options& opts = csv_options());
+
+} // namespace paradox
+
+#endif // PARADOX_CSV_H
@@ -13,11 +13,31 @@
     #define PARADOX_API
 #endif
 
+#include <charconv>
+#include <cstddef>
 #include <iostream>
 #include <string>
+#include <string_view>
 
 namespace paradox {
 
+// Компоненты числа MLNS: r·ω^level + i·ω^(level-1) + j·ω^(level-2)
+struct dspirit_parts {
+    double r;
+    double i;
+    double j;
+    double level;
+};
+
+namespace detail { struct impl_access; }
+
+// Текстовые форматы dspirit::to_chars
+enum class text_format {
+    compact,   // как toString() и operator<<: 0, inf, -inf или %.10g
+    shortest,  // кратчайшая запись r с уровнем: 3.5, 3.5@2, inf^2, eps^3
+    lossless   // все компоненты: (r,i,j)@level, восстанавливается точно
+};
+
 class dspirit {
 public:
     // Основные конструкторы
@@ -27,11 +47,14 @@ public:
     
 
     static dspirit fromLevel(double value, double level);
+    static dspirit fromParts(const dspirit_parts& parts);
 
     // Деструктор
     ~dspirit();
 
-    // Копирование и перемещение
+    // Копирование и перемещение. Перемещённый объект остаётся допустимым
+    // числом: после конструктора - ONE, после присваивания - прежнее
+    // значение приёмника
     dspirit(const dspirit& other);
     dspirit(dspirit&& other) noexcept;
     
@@ -97,6 +120,20 @@ public:
     static dspirit fromString(const std::string& s);
     static dspirit parse(const std::string& s);
     
+    // Разбор без выделения памяти в стиле std::from_chars: ptr - первый
+    // неразобранный символ, ec - код ошибки. Нотация: 3.5, -2e10,
+    // 3.5@2 (3.5·ω^2), inf, -inf^2 (-ω^2), eps, eps^2 (ω^-2), inf^inf,
+    // nan@level (NaN ошибочных элементов пакетных функций),
+    // (r,i,j)@level - все компоненты (также inf и nan)
+    static std::from_chars_result from_chars(const char* first, const char* last, dspirit& value);
+    static std::from_chars_result from_chars(std::string_view text, dspirit& value);
+    
+    // Запись в буфер вызывающего без выделения памяти; при нехватке места
+    // ec = value_too_large. MAX_CHARS байт хватает для любого формата.
+    // Форматы shortest и lossless читаются обратно через from_chars
+    static constexpr std::size_t MAX_CHARS = 128;
+    std::to_chars_result to_chars(char* first, char* last, text_format format = text_format::compact) const;
+    
     // Статические константы
     static const dspirit ZERO;
     static const dspirit INF;
@@ -115,6 +152,16 @@ public:
     friend dspirit sin(const dspirit& x);
     friend dspirit cos(const dspirit& x);
     friend dspirit tan(const dspirit& x);
+    friend dspirit sinh(const dspirit& x);
+    friend dspirit cosh(const dspirit& x);
+    friend dspirit tanh(const dspirit& x);
+    friend dspirit cbrt(const dspirit& x);
+    friend dspirit erf(const dspirit& x);
+    friend dspirit log1p(const dspirit& x);
+    friend dspirit expm1(const dspirit& x);
+    friend dspirit atan2(const dspirit& y, const dspirit& x);
+    friend dspirit hypot(const dspirit& x, const dspirit& y);
+    friend dspirit fma(const dspirit& a, const dspirit& b, const dspirit& c);
     
         // Новые методы для отладки
     double debugR() const;
@@ -126,15 +173,22 @@ public:
     // Явные методы преобразования
     double toDouble() const;
     float toFloat() const;
+    dspirit_parts toParts() const;
 
 private:
-    // Скрытая реализация (Pimpl)
+    // Скрытая реализация (Pimpl). Обычное конечное число уровня 0 без
+    // подуровней хранится прямо в value_ (pimpl == nullptr): без выделения
+    // памяти, операции над двумя такими числами - одна операция double.
     class Impl;
     Impl* pimpl;
-    
+    double value_ = 0.0;
+
     // Вспомогательные конструкторы
     dspirit(Impl* impl);
     
+    // Доступ к реализации для внутренних модулей библиотеки
+    friend struct detail::impl_access;
+    
     // Дружественные операторы для работы с числами с левой стороны
     friend dspirit operator+(double lhs, const dspirit& rhs);
     friend dspirit operator-(double lhs, const dspirit& rhs);
@@ -0,0 +1,168 @@
+#ifndef PARADOX_DSPIRIT_ARRAY_H
+#define PARADOX_DSPIRIT_ARRAY_H
+
+#include "paradox/dspirit.h"
+#include "paradox/kernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace paradox {
+
+// Невладеющее представление SoA-данных только для чтения.
+// Плоскости i, j и level могут быть nullptr: тогда они считаются нулевыми,
+// а если отсутствуют все три - столбец состоит из обычных double уровня 0.
+struct const_dspirit_view {
+    const double* r = nullptr;
+    const double* i = nullptr;
+    const double* j = nullptr;
+    const double* level = nullptr;
+    std::size_t size = 0;
+
+    bool isPlain() const { return !i && !j && !level; }
+
+    dspirit_parts operator[](std::size_t k) const {
+        if (isPlain()) return kernel::make(r[k]);
+        return {r[k], i ? i[k] : 0.0, j ? j[k] : 0.0, level ? level[k] : 0.0};
+    }
+};
+
+// Невладеющее представление SoA-данных для записи (все плоскости обязательны)
+struct dspirit_view {
+    double* r = nullptr;
+    double* i = nullptr;
+    double* j = nullptr;
+    double* level = nullptr;
+    std::size_t size = 0;
+
+    dspirit_parts operator[](std::size_t k) const {
+        return {r[k], i[k], j[k], level[k]};
+    }
+
+    void store(std::size_t k, const dspirit_parts& value) const {
+        r[k] = value.r;
+        i[k] = value.i;
+        j[k] = value.j;
+        level[k] = value.level;
+    }
+
+    operator const_dspirit_view() const { return {r, i, j, level, size}; }
+};
+
+// Массив чисел MLNS в SoA-раскладке: отдельные плоскости r, i, j и level.
+// Элементы хранятся без Pimpl, поэтому пакетные операции не выделяют память.
+class dspirit_array {
+public:
+    dspirit_array() = default;
+    explicit dspirit_array(std::size_t n, const dspirit& value = dspirit::ZERO);
+    dspirit_array(std::initializer_list<double> values);
+    explicit dspirit_array(const std::vector<double>& values);
+    explicit dspirit_array(const_dspirit_view values);
+
+    // Размер
+    std::size_t size() const { return r_.size(); }
+    bool empty() const { return r_.empty(); }
+    void resize(std::size_t n, const dspirit& value = dspirit::ZERO);
+    void reserve(std::size_t n);
+    void clear();
+
+    // Добавление
+    void push_back(const dspirit& value);
+    void push_back(const dspirit_parts& value);
+
+    // Доступ к элементам
+    dspirit operator[](std::size_t k) const;
+    dspirit_parts parts(std::size_t k) const { return {r_[k], i_[k], j_[k], level_[k]}; }
+    void set(std::size_t k, const dspirit& value);
+    void set(std::size_t k, const dspirit_parts& value);
+
+    // Плоскости
+    double* r() { return r_.data(); }
+    double* i() { return i_.data(); }
+    double* j() { return j_.data(); }
+    double* level() { return level_.data(); }
+    const double* r() const { return r_.data(); }
+    const double* i() const { return i_.data(); }
+    const double* j() const { return j_.data(); }
+    const double* level() const { return level_.data(); }
+
+    // Представления
+    dspirit_view view();
+    const_dspirit_view view() const;
+    operator dspirit_view() { return view(); }
+    operator const_dspirit_view() const { return view(); }
+
+private:
+    std::vector<double> r_;
+    std::vector<double> i_;
+    std::vector<double> j_;
+    std::vector<double> level_;
+};
+
+// Поэлементные операции над массивами
+dspirit_array operator-(const dspirit_array& x);
+dspirit_array operator+(const dspirit_array& lhs, const dspirit_array& rhs);
+dspirit_array operator-(const dspirit_array& lhs, const dspirit_array& rhs);
+dspirit_array operator*(const dspirit_array& lhs, const dspirit_array& rhs);
+dspirit_array operator/(const dspirit_array& lhs, const dspirit_array& rhs);
+dspirit_array fma(const dspirit_array& a, const dspirit_array& b, const dspirit_array& c);
+
+// Пакетные ядра над представлениями: out[k] = op(a[k], b[k]).
+// Размеры должны совпадать; out может совпадать с одним из входов.
+namespace batch {
+
+void negate(const_dspirit_view x, dspirit_view out);
+void add(const_dspirit_view a, const_dspirit_view b, dspirit_view out);
+void subtract(const_dspirit_view a, const_dspirit_view b, dspirit_view out);
+void multiply(const_dspirit_view a, const_dspirit_view b, dspirit_view out);
+void divide(const_dspirit_view a, const_dspirit_view b, dspirit_view out);
+
+// Один из операндов - число: out[k] = op(a[k], b) и out[k] = op(a, b[k]).
+// Число разбирается один раз, массив-копия из n его повторений не нужен
+void add(const_dspirit_view a, const dspirit_parts& b, dspirit_view out);
+void add(const dspirit_parts& a, const_dspirit_view b, dspirit_view out);
+void subtract(const_dspirit_view a, const dspirit_parts& b, dspirit_view out);
+void subtract(const dspirit_parts& a, const_dspirit_view b, dspirit_view out);
+void multiply(const_dspirit_view a, const dspirit_parts& b, dspirit_view out);
+void multiply(const dspirit_parts& a, const_dspirit_view b, dspirit_view out);
+void divide(const_dspirit_view a, const dspirit_parts& b, dspirit_view out);
+void divide(const dspirit_parts& a, const_dspirit_view b, dspirit_view out);
+
+// out[k] = a[k] * b[k] + c[k] с одним выравниванием уровней
+void fma(const_dspirit_view a, const_dspirit_view b, const_dspirit_view c, dspirit_view out);
+
+// Математические функции без исключений. Для элемента вне области
+// определения в failed (statusWords(n) слов, может быть nullptr)
+// устанавливается бит k, а out[k] получает NaN уровня 0.
+// Возвращают число таких элементов.
+std::size_t sqrt(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t pow(const_dspirit_view x, double exponent, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t exp(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t log(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t sin(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t cos(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t tan(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t sinh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t cosh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t tanh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t cbrt(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t erf(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t log1p(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t expm1(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+
+// Функции двух аргументов (определены везде).
+//
+// sinh ... expm1, atan2 и hypot считают блоки из обычных чисел уровня 0
+// одним циклом по плоскости r; элементы с уровнями, подуровнями и
+// результатом вне обычных чисел - тем же ядром, что и kernel::, так что
+// результат не зависит от соседних элементов
+void atan2(const_dspirit_view y, const_dspirit_view x, dspirit_view out);
+void hypot(const_dspirit_view x, const_dspirit_view y, dspirit_view out);
+
+} // namespace batch
+
+} // namespace paradox
+
+#endif // PARADOX_DSPIRIT_ARRAY_H
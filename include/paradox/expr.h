@@ -0,0 +1,296 @@
+#ifndef PARADOX_EXPR_H
+#define PARADOX_EXPR_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/kernel.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+
+namespace paradox {
+namespace expr {
+
+// Шаблоны выражений MLNS (подключаются явно).
+// Операторы строят дерево на этапе компиляции; вычисление идёт одним
+// проходом над компонентами, без временных dspirit и без кучи:
+//
+//   using namespace paradox::expr;
+//   auto v2 = val(v) * val(v);
+//   dspirit gamma = eval(1.0 / sqrt(1.0 - v2 / (val(c) * val(c))));
+//   assign(out, ref(a) * ref(b) + 1.0);   // поэлементно, без промежуточных массивов
+//
+// Узел E: at(k), size() (broadcast - скаляр), E::constant (в поддереве нет
+// массивов) и folded() - тот же узел, в котором постоянные поддеревья
+// заменены посчитанными scalar. assign вычисляет val(c) * val(c) один раз
+// до цикла, а не на каждом элементе
+
+// Размер скалярного (широковещательного) узла
+constexpr std::size_t broadcast = static_cast<std::size_t>(-1);
+
+inline std::size_t mergeSize(std::size_t a, std::size_t b) {
+    if (a == broadcast) return b;
+    if (b == broadcast || a == b) return a;
+    detail::raise(status::size_mismatch, "expr: size mismatch");
+}
+
+// Базовый класс узла (CRTP)
+template <class E>
+struct node {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// Скаляр, захваченный по значению
+class scalar : public node<scalar> {
+public:
+    explicit scalar(const dspirit& value) : value_(value.toParts()) {}
+    explicit scalar(double value) : value_(kernel::make(value)) {}
+    explicit scalar(const dspirit_parts& value) : value_(value) {}
+
+    static constexpr bool constant = true;
+    dspirit_parts at(std::size_t) const { return value_; }
+    std::size_t size() const { return broadcast; }
+    scalar folded() const { return *this; }
+
+private:
+    dspirit_parts value_;
+};
+
+// Массив, захваченный по представлению (данные не копируются)
+class array : public node<array> {
+public:
+    explicit array(const_dspirit_view data) : data_(data) {}
+
+    static constexpr bool constant = false;
+    dspirit_parts at(std::size_t k) const { return data_[k]; }
+    std::size_t size() const { return data_.size; }
+    array folded() const { return *this; }
+
+private:
+    const_dspirit_view data_;
+};
+
+template <class Op, class A>
+class unary : public node<unary<Op, A>> {
+public:
+    explicit unary(const A& arg) : arg_(arg) {}
+
+    static constexpr bool constant = A::constant;
+    dspirit_parts at(std::size_t k) const { return Op::apply(arg_.at(k)); }
+    std::size_t size() const { return arg_.size(); }
+
+    auto folded() const {
+        if constexpr (constant) return scalar(at(0));
+        else return unary<Op, decltype(arg_.folded())>(arg_.folded());
+    }
+
+private:
+    A arg_;
+};
+
+template <class Op, class L, class R>
+class binary : public node<binary<Op, L, R>> {
+public:
+    binary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+
+    static constexpr bool constant = L::constant && R::constant;
+    dspirit_parts at(std::size_t k) const { return Op::apply(lhs_.at(k), rhs_.at(k)); }
+    std::size_t size() const { return mergeSize(lhs_.size(), rhs_.size()); }
+
+    auto folded() const {
+        if constexpr (constant) return scalar(at(0));
+        else return binary<Op, decltype(lhs_.folded()), decltype(rhs_.folded())>(lhs_.folded(), rhs_.folded());
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template <class Op, class A, class B, class C>
+class ternary : public node<ternary<Op, A, B, C>> {
+public:
+    ternary(const A& a, const B& b, const C& c) : a_(a), b_(b), c_(c) {}
+
+    static constexpr bool constant = A::constant && B::constant && C::constant;
+    dspirit_parts at(std::size_t k) const { return Op::apply(a_.at(k), b_.at(k), c_.at(k)); }
+    std::size_t size() const { return mergeSize(mergeSize(a_.size(), b_.size()), c_.size()); }
+
+    auto folded() const {
+        if constexpr (constant) return scalar(at(0));
+        else return ternary<Op, decltype(a_.folded()), decltype(b_.folded()), decltype(c_.folded())>(
+            a_.folded(), b_.folded(), c_.folded());
+    }
+
+private:
+    A a_;
+    B b_;
+    C c_;
+};
+
+template <class A>
+class power : public node<power<A>> {
+public:
+    power(const A& base, double exponent) : base_(base), exponent_(exponent) {}
+
+    static constexpr bool constant = A::constant;
+    dspirit_parts at(std::size_t k) const { return kernel::pow(base_.at(k), exponent_); }
+    std::size_t size() const { return base_.size(); }
+
+    auto folded() const {
+        if constexpr (constant) return scalar(at(0));
+        else return power<decltype(base_.folded())>(base_.folded(), exponent_);
+    }
+
+private:
+    A base_;
+    double exponent_;
+};
+
+// Операции узлов
+namespace op {
+
+struct negate   { static dspirit_parts apply(const dspirit_parts& x) { return kernel::negate(x); } };
+struct abs      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::abs(x); } };
+struct sqrt     { static dspirit_parts apply(const dspirit_parts& x) { return kernel::sqrt(x); } };
+struct exp      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::exp(x); } };
+struct log      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::log(x); } };
+struct sin      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::sin(x); } };
+struct cos      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::cos(x); } };
+struct tan      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::tan(x); } };
+struct sinh     { static dspirit_parts apply(const dspirit_parts& x) { return kernel::sinh(x); } };
+struct cosh     { static dspirit_parts apply(const dspirit_parts& x) { return kernel::cosh(x); } };
+struct tanh     { static dspirit_parts apply(const dspirit_parts& x) { return kernel::tanh(x); } };
+struct cbrt     { static dspirit_parts apply(const dspirit_parts& x) { return kernel::cbrt(x); } };
+struct erf      { static dspirit_parts apply(const dspirit_parts& x) { return kernel::erf(x); } };
+struct log1p    { static dspirit_parts apply(const dspirit_parts& x) { return kernel::log1p(x); } };
+struct expm1    { static dspirit_parts apply(const dspirit_parts& x) { return kernel::expm1(x); } };
+
+struct add {
+    static dspirit_parts apply(const dspirit_parts& a, const dspirit_parts& b) { return kernel::add(a, b); }
+};
+struct subtract {
+    static dspirit_parts apply(const dspirit_parts& a, const dspirit_parts& b) { return kernel::subtract(a, b); }
+};
+struct multiply {
+    static dspirit_parts apply(const dspirit_parts& a, const dspirit_parts& b) { return kernel::multiply(a, b); }
+};
+struct divide {
+    static dspirit_parts apply(const dspirit_parts& a, const dspirit_parts& b) { return kernel::divide(a, b); }
+};
+struct atan2 {
+    static dspirit_parts apply(const dspirit_parts& y, const dspirit_parts& x) { return kernel::atan2(y, x); }
+};
+struct hypot {
+    static dspirit_parts apply(const dspirit_parts& x, const dspirit_parts& y) { return kernel::hypot(x, y); }
+};
+
+struct fma {
+    static dspirit_parts apply(const dspirit_parts& a, const dspirit_parts& b, const dspirit_parts& c) {
+        return kernel::fma(a, b, c);
+    }
+};
+
+} // namespace op
+
+// Листья
+inline scalar val(const dspirit& value) { return scalar(value); }
+inline scalar val(double value) { return scalar(value); }
+inline array ref(const_dspirit_view data) { return array(data); }
+inline array ref(const dspirit_array& data) { return array(data.view()); }
+array ref(const dspirit_array&& data) = delete;
+
+// Бинарные операторы: узел с узлом, с dspirit и с double
+#define PARADOX_EXPR_BINARY(SYMBOL, OP)                                              \
+    template <class L, class R>                                                      \
+    binary<OP, L, R> operator SYMBOL(const node<L>& lhs, const node<R>& rhs) {       \
+        return {lhs.self(), rhs.self()};                                             \
+    }                                                                                \
+    template <class L>                                                               \
+    binary<OP, L, scalar> operator SYMBOL(const node<L>& lhs, const dspirit& rhs) {  \
+        return {lhs.self(), scalar(rhs)};                                            \
+    }                                                                                \
+    template <class R>                                                               \
+    binary<OP, scalar, R> operator SYMBOL(const dspirit& lhs, const node<R>& rhs) {  \
+        return {scalar(lhs), rhs.self()};                                            \
+    }                                                                                \
+    template <class L>                                                               \
+    binary<OP, L, scalar> operator SYMBOL(const node<L>& lhs, double rhs) {          \
+        return {lhs.self(), scalar(rhs)};                                            \
+    }                                                                                \
+    template <class R>                                                               \
+    binary<OP, scalar, R> operator SYMBOL(double lhs, const node<R>& rhs) {          \
+        return {scalar(lhs), rhs.self()};                                            \
+    }
+
+PARADOX_EXPR_BINARY(+, op::add)
+PARADOX_EXPR_BINARY(-, op::subtract)
+PARADOX_EXPR_BINARY(*, op::multiply)
+PARADOX_EXPR_BINARY(/, op::divide)
+
+#undef PARADOX_EXPR_BINARY
+
+// Унарные операции и функции
+template <class A> unary<op::negate, A> operator-(const node<A>& x) { return unary<op::negate, A>(x.self()); }
+template <class A> unary<op::abs, A> abs(const node<A>& x) { return unary<op::abs, A>(x.self()); }
+template <class A> unary<op::sqrt, A> sqrt(const node<A>& x) { return unary<op::sqrt, A>(x.self()); }
+template <class A> unary<op::exp, A> exp(const node<A>& x) { return unary<op::exp, A>(x.self()); }
+template <class A> unary<op::log, A> log(const node<A>& x) { return unary<op::log, A>(x.self()); }
+template <class A> unary<op::sin, A> sin(const node<A>& x) { return unary<op::sin, A>(x.self()); }
+template <class A> unary<op::cos, A> cos(const node<A>& x) { return unary<op::cos, A>(x.self()); }
+template <class A> unary<op::tan, A> tan(const node<A>& x) { return unary<op::tan, A>(x.self()); }
+template <class A> unary<op::sinh, A> sinh(const node<A>& x) { return unary<op::sinh, A>(x.self()); }
+template <class A> unary<op::cosh, A> cosh(const node<A>& x) { return unary<op::cosh, A>(x.self()); }
+template <class A> unary<op::tanh, A> tanh(const node<A>& x) { return unary<op::tanh, A>(x.self()); }
+template <class A> unary<op::cbrt, A> cbrt(const node<A>& x) { return unary<op::cbrt, A>(x.self()); }
+template <class A> unary<op::erf, A> erf(const node<A>& x) { return unary<op::erf, A>(x.self()); }
+template <class A> unary<op::log1p, A> log1p(const node<A>& x) { return unary<op::log1p, A>(x.self()); }
+template <class A> unary<op::expm1, A> expm1(const node<A>& x) { return unary<op::expm1, A>(x.self()); }
+template <class A> power<A> pow(const node<A>& x, double exponent) { return power<A>(x.self(), exponent); }
+
+template <class Y, class X>
+binary<op::atan2, Y, X> atan2(const node<Y>& y, const node<X>& x) { return {y.self(), x.self()}; }
+template <class A, class B>
+binary<op::hypot, A, B> hypot(const node<A>& x, const node<B>& y) { return {x.self(), y.self()}; }
+
+// a * b + c с одним выравниванием уровней
+template <class A, class B, class C>
+ternary<op::fma, A, B, C> fma(const node<A>& a, const node<B>& b, const node<C>& c) {
+    return ternary<op::fma, A, B, C>(a.self(), b.self(), c.self());
+}
+
+// Вычисление скалярного выражения
+template <class E>
+dspirit eval(const node<E>& e) {
+    if (e.self().size() != broadcast) {
+        detail::raise(status::invalid_argument, "expr: eval of array expression, use assign");
+    }
+    return dspirit::fromParts(e.self().at(0));
+}
+
+// Поэлементное вычисление в готовый буфер; out может совпадать с входом.
+// Постоянные поддеревья вычисляются один раз до цикла
+template <class E>
+void assign(dspirit_view out, const node<E>& e) {
+    const std::size_t n = e.self().size();
+    if (n != broadcast && n != out.size) {
+        detail::raise(status::size_mismatch, "expr: size mismatch");
+    }
+    if (out.size == 0) return;
+    const auto x = e.self().folded();
+    for (std::size_t k = 0; k < out.size; ++k) {
+        out.store(k, x.at(k));
+    }
+}
+
+template <class E>
+void assign(dspirit_array& out, const node<E>& e) {
+    const std::size_t n = e.self().size();
+    if (n != broadcast && n != out.size()) out.resize(n);
+    assign(out.view(), e);
+}
+
+} // namespace expr
+} // namespace paradox
+
+#endif // PARADOX_EXPR_H
@@ -0,0 +1,55 @@
+#ifndef PARADOX_FAST_H
+#define PARADOX_FAST_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace paradox {
+namespace fast {
+
+// Быстрый уровень точности для трансцендентных функций: вызов fast::exp(x)
+// вместо exp(x). Обработка нулей, бесконечностей и суперуровней та же, что
+// в обычных функциях; приближается только вычисление на уровне 0.
+//
+// Погрешность для обычных (уровень 0) аргументов, против long double на
+// всём диапазоне (examples/test_fast.cpp); полиномы - минимакс (Ремез):
+//   exp  - таблица 2^(k/64) и полином 5-й степени, не более 1.5 ULP
+//          для x из [-703, 709.78] (ниже результат меньше NEAR_ZERO - ZERO)
+//   log  - ряд atanh на [sqrt(2)/2, sqrt(2)), не более 1.5 ULP
+//   sin, cos - редукция по pi/2 с младшей частью и полиномы до x^16,
+//              не более 1.5 ULP для |x| < 1e6 (дальше - std::sin/std::cos)
+//   tan  - отношение sin/cos после редукции, не более 2.5 ULP
+//   pow  - exp(p * log|x|), не более 1.5 + 2 * |p * ln|x|| ULP;
+//          значения с подуровнями и не обычного уровня считаются точно
+
+dspirit exp(const dspirit& x);
+dspirit log(const dspirit& x);
+dspirit sin(const dspirit& x);
+dspirit cos(const dspirit& x);
+dspirit tan(const dspirit& x);
+dspirit pow(const dspirit& x, double exponent);
+
+// Над компонентами, без исключений (как kernel::exp(x, out))
+status exp(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status log(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status sin(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status cos(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status tan(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status pow(const dspirit_parts& x, double exponent, dspirit_parts& out) noexcept;
+
+// Пакетные варианты (соглашения как у batch::exp)
+std::size_t exp(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t log(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t sin(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t cos(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t tan(const_dspirit_view x, dspirit_view out, std::uint64_t* failed = nullptr);
+std::size_t pow(const_dspirit_view x, double exponent, dspirit_view out, std::uint64_t* failed = nullptr);
+
+} // namespace fast
+} // namespace paradox
+
+#endif // PARADOX_FAST_H
@@ -0,0 +1,175 @@
+#ifndef PARADOX_GRAPH_H
+#define PARADOX_GRAPH_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace paradox {
+
+class expr_graph;
+class graph_program;
+
+// Узел ленивого графа: лёгкий дескриптор (граф + номер узла)
+class graph_node {
+public:
+    graph_node() = default;
+
+    expr_graph* graph() const { return graph_; }
+    std::uint32_t index() const { return index_; }
+    bool valid() const { return graph_ != nullptr; }
+
+private:
+    friend class expr_graph;
+    graph_node(expr_graph* graph, std::uint32_t index) : graph_(graph), index_(index) {}
+
+    expr_graph* graph_ = nullptr;
+    std::uint32_t index_ = 0;
+};
+
+// Ленивый граф выражений MLNS.
+// Одинаковые подвыражения хранятся один раз (hash-consing), поэтому
+// `c * c` или `k * T`, встречающиеся в формуле многократно, вычисляются
+// однажды. После compile() граф исполняется пакетами строк:
+//
+//   expr_graph g;
+//   graph_node v = g.input("v"), c = g.input("c");
+//   graph_node gamma = 1.0 / sqrt(1.0 - (v * v) / (c * c));
+//   graph_program p = g.compile({gamma});
+//   p.evaluate({v_column, c_column}, {gamma_column});
+//
+// Узлы ссылаются на граф по адресу, поэтому граф не копируется и не
+// перемещается: узлы копии указывали бы на оригинал.
+class expr_graph {
+public:
+    expr_graph() = default;
+    expr_graph(const expr_graph&) = delete;
+    expr_graph& operator=(const expr_graph&) = delete;
+    expr_graph(expr_graph&&) = delete;
+    expr_graph& operator=(expr_graph&&) = delete;
+
+    enum class op : std::uint8_t {
+        input, constant,
+        negate, abs, sqrt, exp, log, sin, cos, tan, pow,
+        add, subtract, multiply, divide, fma
+    };
+
+    // Листья
+    graph_node input(const std::string& name);
+    graph_node constant(const dspirit& value);
+
+    // Операции (одинаковые узлы не дублируются)
+    graph_node apply(op code, graph_node a);
+    graph_node apply(op code, graph_node a, graph_node b);
+    graph_node apply(op code, graph_node a, graph_node b, graph_node c);
+    graph_node power(graph_node base, double exponent);
+
+    // Информация
+    std::size_t size() const { return nodes_.size(); }
+    std::size_t inputCount() const { return inputs_.size(); }
+    const std::string& inputName(std::size_t k) const { return inputs_[k]; }
+
+    // Расписание вычисления узлов, достижимых из outputs
+    graph_program compile(const std::vector<graph_node>& outputs) const;
+
+private:
+    friend class graph_program;
+
+    struct node_data {
+        op code;
+        std::uint32_t a;  // input: номер входа
+        std::uint32_t b;
+        std::uint32_t c;
+        dspirit_parts value;  // constant: значение, pow: value.r - показатель
+    };
+
+    struct key_hash {
+        std::size_t operator()(const node_data& n) const;
+    };
+
+    struct key_equal {
+        bool operator()(const node_data& x, const node_data& y) const;
+    };
+
+    graph_node intern(const node_data& n);
+    std::uint32_t own(graph_node x) const;
+
+    std::vector<node_data> nodes_;
+    std::vector<std::string> inputs_;
+    std::unordered_map<node_data, std::uint32_t, key_hash, key_equal> index_;
+};
+
+// Скомпилированный граф: линейная программа над слотами-блоками SoA.
+// Каждый различный узел вычисляется один раз на блок строк; слоты
+// переиспользуются после последнего использования значения.
+class graph_program {
+public:
+    std::size_t inputCount() const { return input_count_; }
+    std::size_t outputCount() const { return outputs_.size(); }
+    std::size_t instructionCount() const { return code_.size(); }
+    std::size_t slotCount() const { return slot_count_; }
+
+    // Одна строка
+    std::vector<dspirit> evaluate(const std::vector<dspirit>& inputs) const;
+
+    // Пакет строк: по столбцу на вход и на выход, размеры совпадают
+    void evaluate(const std::vector<const_dspirit_view>& inputs,
+                  const std::vector<dspirit_view>& outputs) const;
+
+private:
+    friend class expr_graph;
+
+    struct instruction {
+        expr_graph::op code;
+        std::uint32_t dst;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t c;
+        dspirit_parts value;
+    };
+
+    void run(const std::vector<const_dspirit_view>& inputs,
+             const std::vector<dspirit_view>& outputs,
+             std::size_t first, std::size_t count, double* workspace) const;
+
+    std::vector<instruction> code_;
+    std::vector<std::uint32_t> outputs_;  // слоты выходов
+    std::size_t input_count_ = 0;
+    std::size_t slot_count_ = 0;
+};
+
+// Построение графа операторами
+graph_node operator-(graph_node x);
+graph_node operator+(graph_node lhs, graph_node rhs);
+graph_node operator-(graph_node lhs, graph_node rhs);
+graph_node operator*(graph_node lhs, graph_node rhs);
+graph_node operator/(graph_node lhs, graph_node rhs);
+
+graph_node operator+(graph_node lhs, const dspirit& rhs);
+graph_node operator-(graph_node lhs, const dspirit& rhs);
+graph_node operator*(graph_node lhs, const dspirit& rhs);
+graph_node operator/(graph_node lhs, const dspirit& rhs);
+
+graph_node operator+(const dspirit& lhs, graph_node rhs);
+graph_node operator-(const dspirit& lhs, graph_node rhs);
+graph_node operator*(const dspirit& lhs, graph_node rhs);
+graph_node operator/(const dspirit& lhs, graph_node rhs);
+
+graph_node abs(graph_node x);
+graph_node sqrt(graph_node x);
+graph_node exp(graph_node x);
+graph_node log(graph_node x);
+graph_node sin(graph_node x);
+graph_node cos(graph_node x);
+graph_node tan(graph_node x);
+graph_node pow(graph_node x, double exponent);
+graph_node fma(graph_node a, graph_node b, graph_node c);
+
+} // namespace paradox
+
+#endif // PARADOX_GRAPH_H
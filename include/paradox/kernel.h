@@ -0,0 +1,78 @@
+#ifndef PARADOX_KERNEL_H
+#define PARADOX_KERNEL_H
+
+#include "paradox/dspirit.h"
+#include "paradox/status.h"
+
+namespace paradox {
+namespace kernel {
+
+// Операции MLNS над компонентами (dspirit_parts) без выделения памяти.
+// Семантика совпадает с операторами и функциями dspirit; входные
+// значения должны быть нормализованы (например, получены из toParts()).
+
+// Создание
+dspirit_parts make(double value);
+
+// Арифметика
+dspirit_parts negate(const dspirit_parts& x);
+dspirit_parts add(const dspirit_parts& a, const dspirit_parts& b);
+dspirit_parts subtract(const dspirit_parts& a, const dspirit_parts& b);
+dspirit_parts multiply(const dspirit_parts& a, const dspirit_parts& b);
+dspirit_parts divide(const dspirit_parts& a, const dspirit_parts& b);
+dspirit_parts fma(const dspirit_parts& a, const dspirit_parts& b, const dspirit_parts& c);
+dspirit_parts abs(const dspirit_parts& x);
+dspirit_parts inverse(const dspirit_parts& x);
+
+// Сравнения
+bool equals(const dspirit_parts& a, const dspirit_parts& b);
+bool less(const dspirit_parts& a, const dspirit_parts& b);
+
+// Проверки свойств
+bool isZero(const dspirit_parts& x);
+bool isInfinity(const dspirit_parts& x);
+bool isNegative(const dspirit_parts& x);
+
+// Преобразования
+double toDouble(const dspirit_parts& x);
+
+// Математические функции
+dspirit_parts sqrt(const dspirit_parts& x);
+dspirit_parts pow(const dspirit_parts& x, double exponent);
+dspirit_parts exp(const dspirit_parts& x);
+dspirit_parts log(const dspirit_parts& x);
+dspirit_parts sin(const dspirit_parts& x);
+dspirit_parts cos(const dspirit_parts& x);
+dspirit_parts tan(const dspirit_parts& x);
+
+// Расширенные функции
+dspirit_parts sinh(const dspirit_parts& x);
+dspirit_parts cosh(const dspirit_parts& x);
+dspirit_parts tanh(const dspirit_parts& x);
+dspirit_parts cbrt(const dspirit_parts& x);
+dspirit_parts erf(const dspirit_parts& x);
+dspirit_parts log1p(const dspirit_parts& x);
+dspirit_parts expm1(const dspirit_parts& x);
+dspirit_parts atan2(const dspirit_parts& y, const dspirit_parts& x);
+dspirit_parts hypot(const dspirit_parts& x, const dspirit_parts& y);
+
+// Варианты без исключений: результат в out, ошибка - в коде возврата
+status sqrt(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status pow(const dspirit_parts& x, double exponent, dspirit_parts& out) noexcept;
+status exp(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status log(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status sin(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status cos(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status tan(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status sinh(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status cosh(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status tanh(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status cbrt(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status erf(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status log1p(const dspirit_parts& x, dspirit_parts& out) noexcept;
+status expm1(const dspirit_parts& x, dspirit_parts& out) noexcept;
+
+} // namespace kernel
+} // namespace paradox
+
+#endif // PARADOX_KERNEL_H
@@ -0,0 +1,79 @@
+#ifndef PARADOX_LOG_DOMAIN_H
+#define PARADOX_LOG_DOMAIN_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/status.h"
+
+#include <cstddef>
+
+namespace paradox {
+
+// Число MLNS в логарифмической форме: sign * e^magnitude * ω^level.
+// Для цепочек произведений и статистических сумм: умножение и деление -
+// сложение логарифмов и уровней, без переполнения r и повышения уровня.
+//
+// Хранится только старшая компонента: подуровни i и j при переходе из
+// dspirit отбрасываются (как и слагаемые младших уровней при сложении).
+// Относительная погрешность r после обратного перехода - около
+// |magnitude| * 2^-53. Суперуровни (±inf) обрабатываются обычной
+// арифметикой dspirit.
+struct log_dspirit {
+    double magnitude;  // ln|r|
+    double level;
+    double sign;       // +1 или -1
+
+    // Из компонентов dspirit (i и j отбрасываются)
+    static log_dspirit fromParts(const dspirit_parts& value) noexcept;
+    static log_dspirit fromDspirit(const dspirit& value);
+
+    // e^value уровня 0 без вычисления экспоненты: fromLog(-E / (k * T)).
+    // -inf даёт ноль, +inf - бесконечность
+    static log_dspirit fromLog(double value) noexcept;
+
+    // Обратный переход. r, не помещающийся в double, сдвигает уровень
+    // (как kernel::pow): переполнение - {±1, level + 1}, потеря
+    // значимости - ноль уровня level - 1
+    dspirit_parts toParts() const noexcept;
+    dspirit toDspirit() const;
+};
+
+log_dspirit operator-(const log_dspirit& x);
+log_dspirit operator*(const log_dspirit& a, const log_dspirit& b);
+log_dspirit operator/(const log_dspirit& a, const log_dspirit& b);
+
+// Сложение через log-sum-exp: на одном уровне
+// max + log1p(±e^(min - max)); при разных уровнях остаётся старший.
+// Младшее слагаемое отбрасывается сразу, поэтому при сокращении старших
+// результат зависит от порядка: (1 + 5@-1) + (-1) - суперноль, а
+// (1 + (-1)) + 5@-1 и dspirit в любом порядке - 5@-1. Суммы, в которых
+// старшие слагаемые могут сократиться, считайте через logSumExp
+log_dspirit operator+(const log_dspirit& a, const log_dspirit& b);
+log_dspirit operator-(const log_dspirit& a, const log_dspirit& b);
+
+// Степень: magnitude и level умножаются на exponent. Дробная степень
+// отрицательного числа - status::domain_error
+status pow(const log_dspirit& x, double exponent, log_dspirit& out) noexcept;
+log_dspirit pow(const log_dspirit& x, double exponent);
+
+// Сумма n чисел за два прохода: старший уровень и наибольший логарифм
+// на нём, затем сумма e^(magnitude - max). Если слагаемые старшего уровня
+// точно сокращаются, проходы повторяются для следующего уровня (как
+// (1 - 1) + 5@-1 = 5@-1 попарно). Пустая сумма - ноль, полностью
+// сокращённая - суперноль
+log_dspirit logSumExp(const log_dspirit* x, std::size_t n);
+
+// Произведение n чисел (сумма логарифмов и уровней)
+log_dspirit product(const log_dspirit* x, std::size_t n);
+
+namespace batch {
+
+// Пакетные преобразования (out - x.size или out.size элементов)
+void toLogDomain(const_dspirit_view x, log_dspirit* out);
+void fromLogDomain(const log_dspirit* x, dspirit_view out);
+
+} // namespace batch
+
+} // namespace paradox
+
+#endif // PARADOX_LOG_DOMAIN_H
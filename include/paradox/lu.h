@@ -0,0 +1,77 @@
+#ifndef PARADOX_LU_H
+#define PARADOX_LU_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/matrix.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace paradox {
+
+// LU-разложение P a = L U с частичным выбором ведущего элемента.
+//
+// Ведущий элемент столбца - наибольший по модулю с учётом уровня: сначала
+// старший уровень, затем |r|. Бесконечная проводимость (уровень 1)
+// выбирается раньше конечных, а ZERO (уровень -1) - законный ведущий
+// элемент: деление на него даёт бесконечность, а не NaN. Вырожденной
+// считается только матрица, у которой весь остаток столбца - точные нули
+// (суперноль).
+//
+// Рекурсивный алгоритм: раскладывается левая половина столбцов, строки U
+// справа получаются треугольным решением, правая половина обновляется
+// вычитанием произведения через ядро gemm и раскладывается так же.
+// Поэлементно раскладываются только полосы из 8 столбцов, так что почти
+// вся работа приходится на gemm. Строки полос, столбцы U и строки
+// обновления обрабатываются в threads потоках (0 - по числу аппаратных
+// потоков).
+class dspirit_lu {
+public:
+    dspirit_lu() = default;
+    explicit dspirit_lu(const dspirit_matrix& a, unsigned threads = 0);
+    explicit dspirit_lu(dspirit_matrix&& a, unsigned threads = 0);
+
+    std::size_t size() const { return lu_.rows(); }
+
+    // Встретился нулевой (суперноль) ведущий элемент
+    bool singular() const { return singular_; }
+
+    // L ниже диагонали (единичная диагональ не хранится) и U
+    const dspirit_matrix& factors() const { return lu_; }
+
+    // На шаге k строка k переставлена со строкой pivots()[k]
+    const std::vector<std::size_t>& pivots() const { return pivots_; }
+
+    // Произведение диагонали U со знаком перестановки. Выход за диапазон
+    // double повышает уровень (как обычное умножение); у вырожденной
+    // матрицы - суперноль
+    dspirit determinant() const;
+
+    // Решение a x = b (x может совпадать с b). Для вырожденной матрицы -
+    // std::domain_error
+    void solve(const_dspirit_view b, dspirit_view x) const;
+    dspirit_array solve(const dspirit_array& b) const;
+
+    // Решение для каждого столбца b (столбцы - в threads потоках)
+    dspirit_matrix solve(const dspirit_matrix& b, unsigned threads = 0) const;
+
+    // a^-1 как решение для столбцов единичной матрицы
+    dspirit_matrix inverse(unsigned threads = 0) const;
+
+private:
+    void factor(unsigned threads);
+
+    dspirit_matrix lu_;
+    std::vector<std::size_t> pivots_;
+    bool singular_ = false;
+};
+
+// Однократные вычисления через dspirit_lu
+dspirit_array solve(const dspirit_matrix& a, const dspirit_array& b, unsigned threads = 0);
+dspirit determinant(const dspirit_matrix& a, unsigned threads = 0);
+dspirit_matrix inverse(const dspirit_matrix& a, unsigned threads = 0);
+
+} // namespace paradox
+
+#endif // PARADOX_LU_H
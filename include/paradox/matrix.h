@@ -0,0 +1,79 @@
+#ifndef PARADOX_MATRIX_H
+#define PARADOX_MATRIX_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+
+#include <cstddef>
+
+namespace paradox {
+
+enum class matrix_layout {
+    row_major,
+    column_major
+};
+
+// Плотная матрица чисел MLNS. Элементы хранятся в dspirit_array
+// (плоскости r, i, j, level) по строкам или по столбцам.
+class dspirit_matrix {
+public:
+    dspirit_matrix() = default;
+    dspirit_matrix(std::size_t rows, std::size_t cols, matrix_layout layout = matrix_layout::row_major);
+    dspirit_matrix(std::size_t rows, std::size_t cols, const dspirit& value,
+                   matrix_layout layout = matrix_layout::row_major);
+
+    // Единичная матрица: 1 на диагонали, ZERO вне её
+    static dspirit_matrix identity(std::size_t n, matrix_layout layout = matrix_layout::row_major);
+
+    // Размер
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    matrix_layout layout() const { return layout_; }
+
+    // Номер элемента (i, j) в плоскостях
+    std::size_t index(std::size_t i, std::size_t j) const {
+        return layout_ == matrix_layout::row_major ? i * cols_ + j : j * rows_ + i;
+    }
+
+    // Доступ к элементам
+    dspirit operator()(std::size_t i, std::size_t j) const { return data_[index(i, j)]; }
+    dspirit_parts parts(std::size_t i, std::size_t j) const { return data_.parts(index(i, j)); }
+    void set(std::size_t i, std::size_t j, const dspirit& value) { data_.set(index(i, j), value); }
+    void set(std::size_t i, std::size_t j, const dspirit_parts& value) { data_.set(index(i, j), value); }
+
+    // Плоскости
+    dspirit_array& data() { return data_; }
+    const dspirit_array& data() const { return data_; }
+    dspirit_view view() { return data_.view(); }
+    const_dspirit_view view() const { return data_.view(); }
+
+private:
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    matrix_layout layout_ = matrix_layout::row_major;
+    dspirit_array data_;
+};
+
+// c = a * b (c - a.rows() x b.cols() любой раскладки, не совпадает с a и b).
+//
+// Блочное умножение: блоки a и b упаковываются в полосы по компонентам,
+// выровненным к старшему уровню блока. Если уровни блока отличаются от
+// старшего на 0, 1 или 2 (обычные числа, ZERO, суперноль), суммы
+// произведений плоскостей r, i, j накапливаются в регистрах и
+// нормализуются один раз; блоки без подуровней требуют одного прохода.
+// Иначе (суперуровень +inf, NaN, большие разрывы уровней) и при
+// переполнении элементы блока считаются цепочкой fma. Порядок сложения
+// отличается от последовательного, поэтому результат может отличаться
+// в последних битах, но не зависит от числа потоков. Строки c делятся
+// между threads потоками (0 - по числу аппаратных потоков).
+void gemm(const dspirit_matrix& a, const dspirit_matrix& b, dspirit_matrix& c, unsigned threads = 0);
+
+// y = a * x (x - a.cols(), y - a.rows() элементов; y не совпадает с x)
+void gemv(const dspirit_matrix& a, const_dspirit_view x, dspirit_view y, unsigned threads = 0);
+
+dspirit_matrix operator*(const dspirit_matrix& a, const dspirit_matrix& b);
+dspirit_array operator*(const dspirit_matrix& a, const dspirit_array& x);
+
+} // namespace paradox
+
+#endif // PARADOX_MATRIX_H
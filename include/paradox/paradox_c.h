@@ -0,0 +1,156 @@
+#ifndef PARADOX_C_H
+#define PARADOX_C_H
+
+/*
+ * Стабильный C ABI для FFI (Rust, Java, ...). Заголовок компилируется как
+ * C99 и как C++. Значения передаются в POD-структуре paradox_value, пакетные
+ * функции работают с буферами вызывающего (указатель + длина), не выделяют
+ * память и не бросают исключений: ошибки - в коде возврата.
+ *
+ * Входные значения должны быть нормализованы (получены из функций этого
+ * API или dspirit::toParts). Выходной буфер может совпадать с входным.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+    #ifdef PARADOX_DSPIRIT_EXPORTS
+        #define PARADOX_C_API __declspec(dllexport)
+    #else
+        #define PARADOX_C_API __declspec(dllimport)
+    #endif
+#elif defined(__GNUC__)
+    #define PARADOX_C_API __attribute__((visibility("default")))
+#else
+    #define PARADOX_C_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Число MLNS: r*w^level + i*w^(level-1) + j*w^(level-2) (как dspirit_parts) */
+typedef struct paradox_value {
+    double r;
+    double i;
+    double j;
+    double level;
+} paradox_value;
+
+/* Коды возврата (значения совпадают с paradox::status) */
+typedef int32_t paradox_status;
+enum {
+    PARADOX_OK = 0,
+    PARADOX_DOMAIN_ERROR = 1,      /* аргумент вне области определения */
+    PARADOX_INVALID_ARGUMENT = 2,  /* NULL-буфер, неизвестный код, неверный текст */
+    PARADOX_SIZE_MISMATCH = 3,
+    PARADOX_CORRUPT_DATA = 4,
+    PARADOX_IO_ERROR = 5
+};
+
+/* Функции одного аргумента для paradox_apply и paradox_apply_n */
+typedef int32_t paradox_function;
+enum {
+    PARADOX_SQRT = 0,
+    PARADOX_EXP,
+    PARADOX_LOG,
+    PARADOX_SIN,
+    PARADOX_COS,
+    PARADOX_TAN,
+    PARADOX_SINH,
+    PARADOX_COSH,
+    PARADOX_TANH,
+    PARADOX_CBRT,
+    PARADOX_ERF,
+    PARADOX_LOG1P,
+    PARADOX_EXPM1,
+    PARADOX_ABS,
+    PARADOX_INVERSE
+};
+
+/* Текстовые форматы (как paradox::text_format) */
+typedef int32_t paradox_format;
+enum {
+    PARADOX_FORMAT_COMPACT = 0,
+    PARADOX_FORMAT_SHORTEST = 1,
+    PARADOX_FORMAT_LOSSLESS = 2
+};
+
+/* Размер буфера, достаточный для любого формата (с завершающим нулём) */
+#define PARADOX_MAX_CHARS 128
+
+/* Версия ABI: меняется при несовместимых изменениях */
+#define PARADOX_C_ABI_VERSION 1
+PARADOX_C_API int32_t paradox_abi_version(void);
+
+/* Скалярные операции */
+PARADOX_C_API paradox_value paradox_from_double(double value);
+PARADOX_C_API paradox_value paradox_from_level(double value, double level);
+PARADOX_C_API double paradox_to_double(paradox_value x);
+
+PARADOX_C_API paradox_value paradox_neg(paradox_value x);
+PARADOX_C_API paradox_value paradox_add(paradox_value a, paradox_value b);
+PARADOX_C_API paradox_value paradox_sub(paradox_value a, paradox_value b);
+PARADOX_C_API paradox_value paradox_mul(paradox_value a, paradox_value b);
+PARADOX_C_API paradox_value paradox_div(paradox_value a, paradox_value b);
+
+/* -1, 0 или 1 (a < b, a == b, a > b) */
+PARADOX_C_API int32_t paradox_compare(paradox_value a, paradox_value b);
+
+PARADOX_C_API paradox_status paradox_apply(paradox_function fn, paradox_value x, paradox_value* out);
+PARADOX_C_API paradox_status paradox_pow(paradox_value x, double exponent, paradox_value* out);
+
+/* Текст в формате dspirit::from_chars; строка должна разбираться целиком */
+PARADOX_C_API paradox_status paradox_parse(const char* text, size_t length, paradox_value* out);
+
+/* Запись с завершающим нулём; length (может быть NULL) - без нуля.
+ * Буфер мал - PARADOX_INVALID_ARGUMENT. */
+PARADOX_C_API paradox_status paradox_format_value(paradox_value x, paradox_format format, char* buffer,
+                                                  size_t capacity, size_t* length);
+
+/* Пакетные операции: out[k] = op(a[k], b[k]), k < n */
+PARADOX_C_API paradox_status paradox_neg_n(const paradox_value* x, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_add_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_sub_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_mul_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_div_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n);
+
+/* out[k] = a[k] * b[k] + c[k] */
+PARADOX_C_API paradox_status paradox_fma_n(const paradox_value* a, const paradox_value* b, const paradox_value* c,
+                                           paradox_value* out, size_t n);
+
+/* out[k] = paradox_compare(a[k], b[k]) */
+PARADOX_C_API paradox_status paradox_compare_n(const paradox_value* a, const paradox_value* b, int8_t* out, size_t n);
+
+/* Элементы вне области определения получают NaN уровня 0; их число
+ * пишется в failed (может быть NULL), код возврата - PARADOX_DOMAIN_ERROR */
+PARADOX_C_API paradox_status paradox_apply_n(paradox_function fn, const paradox_value* x, paradox_value* out,
+                                             size_t n, size_t* failed);
+PARADOX_C_API paradox_status paradox_pow_n(const paradox_value* x, double exponent, paradox_value* out, size_t n,
+                                           size_t* failed);
+
+/* Свёртки. Сумма пустого буфера - ноль, произведение - единица;
+ * min/max пустого буфера - PARADOX_INVALID_ARGUMENT. index (может быть
+ * NULL) - позиция первого минимального/максимального элемента. */
+PARADOX_C_API paradox_status paradox_sum_n(const paradox_value* x, size_t n, paradox_value* out);
+PARADOX_C_API paradox_status paradox_product_n(const paradox_value* x, size_t n, paradox_value* out);
+PARADOX_C_API paradox_status paradox_min_n(const paradox_value* x, size_t n, paradox_value* out, size_t* index);
+PARADOX_C_API paradox_status paradox_max_n(const paradox_value* x, size_t n, paradox_value* out, size_t* index);
+
+/* Преобразования */
+PARADOX_C_API paradox_status paradox_from_doubles(const double* x, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_to_doubles(const paradox_value* x, double* out, size_t n);
+
+/* Из SoA-плоскостей и обратно. При чтении i, j и level могут быть NULL
+ * (нули; если NULL все три - обычные double, как paradox_from_doubles). */
+PARADOX_C_API paradox_status paradox_from_planes(const double* r, const double* i, const double* j,
+                                                 const double* level, paradox_value* out, size_t n);
+PARADOX_C_API paradox_status paradox_to_planes(const paradox_value* x, double* r, double* i, double* j,
+                                               double* level, size_t n);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* PARADOX_C_H */
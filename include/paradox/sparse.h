@@ -0,0 +1,112 @@
+#ifndef PARADOX_SPARSE_H
+#define PARADOX_SPARSE_H
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/matrix.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace paradox {
+
+// Разреженная матрица чисел MLNS в сжатом формате: row_major - CSR
+// (сжатые строки), column_major - CSC (сжатые столбцы). Значения хранятся
+// в dspirit_array (плоскости r, i, j, level), индексы - отдельными
+// массивами.
+//
+// Разреженность понимается в смысле MLNS: элементы ниже нулевого уровня
+// (ZERO, eps^2, суперноль) не хранятся, отсутствующий элемент равен ZERO.
+// В произведениях отсутствующие элементы не участвуют: теряются их
+// бесконечно малые вклады и конечные вклады вида ZERO * INF = 1, которые
+// даёт плотная dspirit_matrix, где ZERO хранится явно.
+//
+// Матрица неизменяема; строится через sparse_builder.
+class sparse_matrix {
+public:
+    sparse_matrix() = default;
+
+    // Размер
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    matrix_layout layout() const { return layout_; }
+    std::size_t nonZeros() const { return indices_.size(); }
+
+    // Все хранимые элементы - обычные числа уровня 0
+    bool plain() const { return plain_; }
+
+    // Элементы строки (CSR) или столбца (CSC) k - номера [offsets()[k],
+    // offsets()[k + 1]) в indices() и values(); индексы возрастают
+    const std::vector<std::size_t>& offsets() const { return offsets_; }
+    const std::vector<std::size_t>& indices() const { return indices_; }
+    const dspirit_array& values() const { return values_; }
+
+    // Элемент (i, j) двоичным поиском; отсутствующий - ZERO
+    dspirit operator()(std::size_t i, std::size_t j) const;
+    dspirit_parts parts(std::size_t i, std::size_t j) const;
+
+    // Та же матрица в другой раскладке (CSR <-> CSC)
+    sparse_matrix convert(matrix_layout layout) const;
+
+    // Преобразования в плотную матрицу и обратно (ZERO-уровень отбрасывается)
+    dspirit_matrix toDense(matrix_layout layout = matrix_layout::row_major) const;
+    static sparse_matrix fromDense(const dspirit_matrix& a, matrix_layout layout = matrix_layout::row_major);
+
+private:
+    friend class sparse_builder;
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    matrix_layout layout_ = matrix_layout::row_major;
+    bool plain_ = true;
+    std::vector<std::size_t> offsets_ = {0};
+    std::vector<std::size_t> indices_;
+    dspirit_array values_;
+};
+
+// Построитель из координатных троек (строка, столбец, значение).
+// Повторные элементы складываются (как при сборке матрицы проводимостей);
+// суммы ниже нулевого уровня не сохраняются.
+class sparse_builder {
+public:
+    sparse_builder(std::size_t rows, std::size_t cols);
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    std::size_t size() const { return rowIndices_.size(); }
+
+    void reserve(std::size_t n);
+    void clear();
+
+    // Индекс вне матрицы - std::invalid_argument
+    void add(std::size_t i, std::size_t j, const dspirit& value);
+    void add(std::size_t i, std::size_t j, const dspirit_parts& value);
+
+    sparse_matrix build(matrix_layout layout = matrix_layout::row_major) const;
+
+private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::vector<std::size_t> rowIndices_;
+    std::vector<std::size_t> colIndices_;
+    dspirit_array values_;
+};
+
+// y = a * x (x - a.cols(), y - a.rows() элементов; y не совпадает с x).
+//
+// Суммы произведений строки выравниваются к старшему уровню и
+// накапливаются по компонентам r, i, j в double; для матрицы из обычных
+// чисел и такого же x в CSR - векторизуемым циклом по одной плоскости
+// (четырьмя суммами, поэтому от CSC он отличается в последних битах).
+// Суперуровни, NaN, большие разрывы уровней и переполнение считаются
+// цепочкой fma. Строка без элементов даёт ZERO. Строки делятся между
+// threads потоками (0 - по числу аппаратных потоков), результат от их
+// числа не зависит. CSR обходит строки подряд и быстрее; в CSC каждый
+// поток просматривает все столбцы.
+void spmv(const sparse_matrix& a, const_dspirit_view x, dspirit_view y, unsigned threads = 0);
+
+dspirit_array operator*(const sparse_matrix& a, const dspirit_array& x);
+
+} // namespace paradox
+
+#endif // PARADOX_SPARSE_H
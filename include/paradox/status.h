@@ -0,0 +1,66 @@
+#ifndef PARADOX_STATUS_H
+#define PARADOX_STATUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace paradox {
+
+// Коды ошибок для функций без исключений
+enum class status : std::uint8_t {
+    ok = 0,
+    domain_error,      // аргумент вне области определения (sqrt(-1), sin(inf))
+    invalid_argument,  // неверный аргумент или формат строки
+    size_mismatch,     // размеры массивов не совпадают
+    corrupt_data,      // повреждённые или неподдерживаемые двоичные данные
+    io_error           // ошибка чтения или записи потока/файла
+};
+
+const char* statusMessage(status code);
+
+namespace detail {
+
+// Сообщает об ошибке: бросает соответствующее std-исключение, а в режиме
+// PARADOX_NO_EXCEPTIONS печатает сообщение и вызывает std::abort()
+[[noreturn]] void raise(status code, const char* message);
+
+} // namespace detail
+
+// Результат в стиле expected: значение или код ошибки
+template <class T>
+class result {
+public:
+    result(const T& value) : value_(value), status_(status::ok) {}
+    result(T&& value) : value_(std::move(value)), status_(status::ok) {}
+    result(status code) : value_(), status_(code) {}
+
+    bool ok() const { return status_ == status::ok; }
+    explicit operator bool() const { return ok(); }
+    status error() const { return status_; }
+
+    const T& value() const {
+        if (!ok()) detail::raise(status_, "result: no value");
+        return value_;
+    }
+
+    T valueOr(const T& fallback) const { return ok() ? value_ : fallback; }
+
+    const T& operator*() const { return value(); }
+    const T* operator->() const { return &value(); }
+
+private:
+    T value_;
+    status status_;
+};
+
+// Пакетный статус: бит k установлен, если элемент k не вычислен
+inline std::size_t statusWords(std::size_t n) { return (n + 63) / 64; }
+
+inline bool laneFailed(const std::uint64_t* bits, std::size_t k) {
+    return (bits[k / 64] >> (k % 64)) & 1u;
+}
+
+} // namespace paradox
+
+#endif // PARADOX_STATUS_H
@@ -0,0 +1,913 @@
+// Модуль Python: dspirit и SoA-массивы с пакетными ядрами.
+// Сборка: cmake -DPARADOX_BUILD_PYTHON=ON (C API CPython из FindPython),
+// проверка - ctest -R test_python (python/test_paradox.py, нужен NumPy).
+// NumPy вызывается через его объекты Python и протокол буфера, без
+// заголовков NumPy: плоскости отдаются как numpy.asarray над буфером.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "paradox/dspirit.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/kernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+using namespace paradox;
+
+namespace {
+
+// Типы модуля (создаются в PyInit_paradox)
+PyTypeObject* dspirit_type = nullptr;
+PyTypeObject* array_type = nullptr;
+PyTypeObject* plane_type = nullptr;
+
+// numpy и dtype записей {r, i, j, level} - при первом обращении
+PyObject* numpy_module = nullptr;
+PyObject* records_dtype = nullptr;
+
+struct dspirit_object {
+    PyObject_HEAD
+    dspirit value;
+};
+
+struct array_object {
+    PyObject_HEAD
+    dspirit_array value;
+};
+
+// Плоскость массива для протокола буфера; держит ссылку на массив
+struct plane_object {
+    PyObject_HEAD
+    PyObject* owner;
+    double* data;
+    Py_ssize_t size;
+    Py_ssize_t stride;
+};
+
+// Исключения C++ - в исключения Python (как в pybind11)
+void translateException() {
+    try {
+        throw;
+    } catch (const std::bad_alloc&) {
+        PyErr_NoMemory();
+    } catch (const std::domain_error& e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    } catch (const std::invalid_argument& e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    } catch (const std::out_of_range& e) {
+        PyErr_SetString(PyExc_IndexError, e.what());
+    } catch (const std::exception& e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+    }
+}
+
+template <class R, class Fn>
+R guarded(R error, Fn fn) {
+    try {
+        return fn();
+    } catch (...) {
+        translateException();
+        return error;
+    }
+}
+
+template <class Fn>
+PyObject* guarded(Fn fn) {
+    return guarded(static_cast<PyObject*>(nullptr), fn);
+}
+
+// GIL отпускается на время пакетных ядер и возвращается и при исключении
+class gil_released {
+public:
+    gil_released() : state_(PyEval_SaveThread()) {}
+    ~gil_released() { PyEval_RestoreThread(state_); }
+    gil_released(const gil_released&) = delete;
+    gil_released& operator=(const gil_released&) = delete;
+
+private:
+    PyThreadState* state_;
+};
+
+// Буфер объекта Python, освобождается деструктором
+class buffer {
+public:
+    buffer() = default;
+    ~buffer() {
+        if (held_) PyBuffer_Release(&view_);
+    }
+    buffer(const buffer&) = delete;
+    buffer& operator=(const buffer&) = delete;
+
+    bool acquire(PyObject* object, int flags) {
+        held_ = (PyObject_GetBuffer(object, &view_, flags) == 0);
+        return held_;
+    }
+
+    const Py_buffer& view() const { return view_; }
+
+private:
+    Py_buffer view_{};
+    bool held_ = false;
+};
+
+PyObject* numpy() {
+    if (!numpy_module) numpy_module = PyImport_ImportModule("numpy");
+    return numpy_module;
+}
+
+PyObject* recordsDtype() {
+    if (!records_dtype && numpy()) {
+        records_dtype = PyObject_CallMethod(numpy(), "dtype", "([(ss)(ss)(ss)(ss)])", "r", "f8", "i", "f8", "j",
+                                            "f8", "level", "f8");
+    }
+    return records_dtype;
+}
+
+bool isDspirit(PyObject* object) {
+    return PyObject_TypeCheck(object, dspirit_type);
+}
+
+bool isArray(PyObject* object) {
+    return PyObject_TypeCheck(object, array_type);
+}
+
+const dspirit& valueOf(PyObject* object) {
+    return reinterpret_cast<dspirit_object*>(object)->value;
+}
+
+dspirit_array& arrayOf(PyObject* object) {
+    return reinterpret_cast<array_object*>(object)->value;
+}
+
+// Значение копируется до выделения объекта: перемещение не бросает
+PyObject* wrap(dspirit x) {
+    PyObject* object = dspirit_type->tp_alloc(dspirit_type, 0);
+    if (!object) return nullptr;
+    new (&reinterpret_cast<dspirit_object*>(object)->value) dspirit(std::move(x));
+    return object;
+}
+
+PyObject* wrap(dspirit_array&& a) {
+    PyObject* object = array_type->tp_alloc(array_type, 0);
+    if (!object) return nullptr;
+    new (&reinterpret_cast<array_object*>(object)->value) dspirit_array(std::move(a));
+    return object;
+}
+
+// Число Python или dspirit: 1 - преобразовано, 0 - другой тип, -1 - ошибка
+int toScalar(PyObject* object, dspirit& out) {
+    if (isDspirit(object)) {
+        out = valueOf(object);
+        return 1;
+    }
+    if (!PyFloat_Check(object) && !PyLong_Check(object)) return 0;
+    const double value = PyFloat_AsDouble(object);
+    if (value == -1.0 && PyErr_Occurred()) return -1;
+    out = dspirit(value);
+    return 1;
+}
+
+// Аргумент, который обязан быть числом
+bool scalarArgument(PyObject* object, dspirit& out) {
+    const int converted = toScalar(object, out);
+    if (converted == 0) PyErr_Format(PyExc_TypeError, "expected dspirit or float, got %.200s", Py_TYPE(object)->tp_name);
+    return converted == 1;
+}
+
+bool checkSize(const dspirit_array& a, const dspirit_array& b) {
+    if (a.size() == b.size()) return true;
+    PyErr_SetString(PyExc_ValueError, "dspirit_array: size mismatch");
+    return false;
+}
+
+std::string format(const dspirit& x, text_format how) {
+    char text[dspirit::MAX_CHARS];
+    return std::string(text, x.to_chars(text, text + dspirit::MAX_CHARS, how).ptr);
+}
+
+// Текст в нотации to_chars (как __repr__) целиком; dspirit::parse
+// суффикс уровня не читает
+bool parseText(PyObject* object, dspirit& value) {
+    Py_ssize_t length = 0;
+    const char* text = PyUnicode_AsUTF8AndSize(object, &length);
+    if (!text) return false;
+    const std::from_chars_result res = dspirit::from_chars(text, text + length, value);
+    if (res.ec != std::errc() || res.ptr != text + length) {
+        PyErr_Format(PyExc_ValueError, "dspirit: cannot parse '%s'", text);
+        return false;
+    }
+    return true;
+}
+
+// dspirit
+
+PyObject* dspiritNew(PyTypeObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"value", nullptr};
+    PyObject* argument = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", const_cast<char**>(keywords), &argument)) return nullptr;
+    return guarded([&]() -> PyObject* {
+        dspirit value;
+        if (argument && PyUnicode_Check(argument)) {
+            if (!parseText(argument, value)) return nullptr;
+        } else if (argument && !scalarArgument(argument, value)) {
+            return nullptr;
+        }
+        return wrap(value);
+    });
+}
+
+void dspiritDealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    reinterpret_cast<dspirit_object*>(self)->value.~dspirit();
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+PyObject* dspiritRepr(PyObject* self) {
+    return guarded([&] {
+        return PyUnicode_FromString(("dspirit('" + format(valueOf(self), text_format::lossless) + "')").c_str());
+    });
+}
+
+PyObject* dspiritStr(PyObject* self) {
+    return guarded([&] { return PyUnicode_FromString(format(valueOf(self), text_format::compact).c_str()); });
+}
+
+// Оба операнда - числа, иначе NotImplemented (dspirit_array обработает сам)
+template <class Op>
+PyObject* scalarBinary(PyObject* a, PyObject* b, Op op) {
+    dspirit x, y;
+    const int left = toScalar(a, x);
+    const int right = (left == 1) ? toScalar(b, y) : 0;
+    if (left < 0 || right < 0) return nullptr;
+    if (left == 0 || right == 0) Py_RETURN_NOTIMPLEMENTED;
+    return guarded([&] { return wrap(op(x, y)); });
+}
+
+PyObject* dspiritAdd(PyObject* a, PyObject* b) {
+    return scalarBinary(a, b, [](const dspirit& x, const dspirit& y) { return x + y; });
+}
+
+PyObject* dspiritSubtract(PyObject* a, PyObject* b) {
+    return scalarBinary(a, b, [](const dspirit& x, const dspirit& y) { return x - y; });
+}
+
+PyObject* dspiritMultiply(PyObject* a, PyObject* b) {
+    return scalarBinary(a, b, [](const dspirit& x, const dspirit& y) { return x * y; });
+}
+
+PyObject* dspiritDivide(PyObject* a, PyObject* b) {
+    return scalarBinary(a, b, [](const dspirit& x, const dspirit& y) { return x / y; });
+}
+
+PyObject* dspiritNegative(PyObject* self) {
+    return guarded([&] { return wrap(-valueOf(self)); });
+}
+
+PyObject* dspiritAbsolute(PyObject* self) {
+    return guarded([&] { return wrap(valueOf(self).abs()); });
+}
+
+PyObject* dspiritPower(PyObject* base, PyObject* exponent, PyObject* modulus) {
+    if (modulus != Py_None || !isDspirit(base) || !(PyFloat_Check(exponent) || PyLong_Check(exponent))) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    const double p = PyFloat_AsDouble(exponent);
+    if (p == -1.0 && PyErr_Occurred()) return nullptr;
+    return guarded([&] { return wrap(pow(valueOf(base), p)); });
+}
+
+PyObject* dspiritFloat(PyObject* self) {
+    return PyFloat_FromDouble(static_cast<double>(valueOf(self)));
+}
+
+PyObject* dspiritCompare(PyObject* a, PyObject* b, int op) {
+    dspirit y;
+    const int converted = toScalar(b, y);
+    if (converted < 0) return nullptr;
+    if (converted == 0) Py_RETURN_NOTIMPLEMENTED;
+    const dspirit& x = valueOf(a);
+    bool result = false;
+    switch (op) {
+    case Py_EQ: result = (x == y); break;
+    case Py_NE: result = (x != y); break;
+    case Py_LT: result = (x < y); break;
+    case Py_LE: result = (x <= y); break;
+    case Py_GT: result = (x > y); break;
+    case Py_GE: result = (x >= y); break;
+    }
+    return PyBool_FromLong(result);
+}
+
+PyObject* dspiritInverse(PyObject* self, PyObject*) {
+    return guarded([&] { return wrap(valueOf(self).inverse()); });
+}
+
+template <bool (dspirit::*Test)() const>
+PyObject* dspiritTest(PyObject* self, PyObject*) {
+    return PyBool_FromLong((valueOf(self).*Test)());
+}
+
+PyObject* dspiritFromLevel(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"value", "level", nullptr};
+    double value = 0.0, level = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "dd", const_cast<char**>(keywords), &value, &level)) return nullptr;
+    return guarded([&] { return wrap(dspirit::fromLevel(value, level)); });
+}
+
+PyObject* dspiritFromParts(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"r", "i", "j", "level", nullptr};
+    dspirit_parts p = {0.0, 0.0, 0.0, 0.0};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|ddd", const_cast<char**>(keywords), &p.r, &p.i, &p.j,
+                                     &p.level)) {
+        return nullptr;
+    }
+    return guarded([&] { return wrap(dspirit::fromParts(p)); });
+}
+
+template <double dspirit_parts::*Part>
+PyObject* dspiritPart(PyObject* self, void*) {
+    return PyFloat_FromDouble(valueOf(self).toParts().*Part);
+}
+
+PyMethodDef dspirit_methods[] = {
+    {"inverse", dspiritInverse, METH_NOARGS, nullptr},
+    {"is_zero", dspiritTest<&dspirit::isZero>, METH_NOARGS, nullptr},
+    {"is_infinity", dspiritTest<&dspirit::isInfinity>, METH_NOARGS, nullptr},
+    {"is_finite", dspiritTest<&dspirit::isFinite>, METH_NOARGS, nullptr},
+    {"is_negative", dspiritTest<&dspirit::isNegative>, METH_NOARGS, nullptr},
+    {"is_positive", dspiritTest<&dspirit::isPositive>, METH_NOARGS, nullptr},
+    {"from_level", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(dspiritFromLevel)),
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, nullptr},
+    {"from_parts", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(dspiritFromParts)),
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, nullptr},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyGetSetDef dspirit_getset[] = {
+    {"r", dspiritPart<&dspirit_parts::r>, nullptr, nullptr, nullptr},
+    {"i", dspiritPart<&dspirit_parts::i>, nullptr, nullptr, nullptr},
+    {"j", dspiritPart<&dspirit_parts::j>, nullptr, nullptr, nullptr},
+    {"level", dspiritPart<&dspirit_parts::level>, nullptr, nullptr, nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyType_Slot dspirit_slots[] = {
+    {Py_tp_new, reinterpret_cast<void*>(dspiritNew)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(dspiritDealloc)},
+    {Py_tp_repr, reinterpret_cast<void*>(dspiritRepr)},
+    {Py_tp_str, reinterpret_cast<void*>(dspiritStr)},
+    {Py_tp_richcompare, reinterpret_cast<void*>(dspiritCompare)},
+    {Py_tp_hash, reinterpret_cast<void*>(PyObject_HashNotImplemented)},
+    {Py_tp_methods, dspirit_methods},
+    {Py_tp_getset, dspirit_getset},
+    {Py_nb_add, reinterpret_cast<void*>(dspiritAdd)},
+    {Py_nb_subtract, reinterpret_cast<void*>(dspiritSubtract)},
+    {Py_nb_multiply, reinterpret_cast<void*>(dspiritMultiply)},
+    {Py_nb_true_divide, reinterpret_cast<void*>(dspiritDivide)},
+    {Py_nb_negative, reinterpret_cast<void*>(dspiritNegative)},
+    {Py_nb_absolute, reinterpret_cast<void*>(dspiritAbsolute)},
+    {Py_nb_power, reinterpret_cast<void*>(dspiritPower)},
+    {Py_nb_float, reinterpret_cast<void*>(dspiritFloat)},
+    {Py_tp_doc, const_cast<char*>("MLNS number")},
+    {0, nullptr}};
+
+PyType_Spec dspirit_spec = {"paradox.dspirit", sizeof(dspirit_object), 0, Py_TPFLAGS_DEFAULT, dspirit_slots};
+
+// Плоскость: одномерный буфер float64 с записью
+
+int planeGetBuffer(PyObject* self, Py_buffer* view, int flags) {
+    plane_object* plane = reinterpret_cast<plane_object*>(self);
+    static double empty = 0.0;
+    view->buf = plane->data ? plane->data : &empty;
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = plane->size * static_cast<Py_ssize_t>(sizeof(double));
+    view->readonly = 0;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    view->ndim = 1;
+    view->shape = &plane->size;
+    view->strides = &plane->stride;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+void planeDealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    Py_XDECREF(reinterpret_cast<plane_object*>(self)->owner);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+PyType_Slot plane_slots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(planeDealloc)},
+    {Py_bf_getbuffer, reinterpret_cast<void*>(planeGetBuffer)},
+    {0, nullptr}};
+
+PyType_Spec plane_spec = {"paradox._plane", sizeof(plane_object), 0, Py_TPFLAGS_DEFAULT, plane_slots};
+
+// Плоскость массива как одномерный float64 NumPy без копирования;
+// base держит плоскость, плоскость - объект массива
+PyObject* plane(PyObject* owner, double* data) {
+    if (!numpy()) return nullptr;
+    plane_object* exporter = PyObject_New(plane_object, plane_type);
+    if (!exporter) return nullptr;
+    Py_INCREF(owner);
+    exporter->owner = owner;
+    exporter->data = data;
+    exporter->size = static_cast<Py_ssize_t>(arrayOf(owner).size());
+    exporter->stride = sizeof(double);
+    PyObject* result = PyObject_CallMethod(numpy(), "asarray", "O", exporter);
+    Py_DECREF(exporter);
+    return result;
+}
+
+// dspirit_array
+
+// Из NumPy float64 (с приведением): обычные числа уровня 0 (как kernel::make)
+PyObject* fromNumpy(PyObject* values) {
+    if (!numpy()) return nullptr;
+    PyObject* contiguous = PyObject_CallMethod(numpy(), "ascontiguousarray", "Os", values, "f8");
+    if (!contiguous) return nullptr;
+    buffer data;
+    const bool ok = data.acquire(contiguous, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT);
+    Py_DECREF(contiguous);
+    if (!ok) return nullptr;
+    if (data.view().ndim != 1) {
+        PyErr_SetString(PyExc_ValueError, "dspirit_array: expected a 1-D array");
+        return nullptr;
+    }
+    const const_dspirit_view view = {static_cast<const double*>(data.view().buf), nullptr, nullptr, nullptr,
+                                     static_cast<std::size_t>(data.view().shape[0])};
+    return guarded([&] {
+        dspirit_array result;
+        {
+            gil_released release;
+            result = dspirit_array(view);
+        }
+        return wrap(std::move(result));
+    });
+}
+
+PyObject* arrayNew(PyTypeObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"n", "value", nullptr};
+    PyObject* first = nullptr;
+    PyObject* fill = nullptr;
+    PyObject* values = kwargs ? PyDict_GetItemString(kwargs, "values") : nullptr;
+    if (values) {
+        if (PyTuple_GET_SIZE(args) != 0 || PyDict_Size(kwargs) != 1) {
+            PyErr_SetString(PyExc_TypeError, "dspirit_array(values) takes a single argument");
+            return nullptr;
+        }
+        return fromNumpy(values);
+    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|OO", const_cast<char**>(keywords), &first, &fill)) {
+        return nullptr;
+    }
+    if (!first) return guarded([] { return wrap(dspirit_array()); });
+    if (!PyLong_Check(first)) {
+        if (fill) {
+            PyErr_SetString(PyExc_TypeError, "dspirit_array: value needs a size n");
+            return nullptr;
+        }
+        return fromNumpy(first);
+    }
+    const Py_ssize_t n = PyLong_AsSsize_t(first);
+    if (n == -1 && PyErr_Occurred()) return nullptr;
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "dspirit_array: negative size");
+        return nullptr;
+    }
+    dspirit value = dspirit::ZERO;
+    if (fill && !scalarArgument(fill, value)) return nullptr;
+    return guarded([&] { return wrap(dspirit_array(static_cast<std::size_t>(n), value)); });
+}
+
+void arrayDealloc(PyObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    arrayOf(self).~dspirit_array();
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+Py_ssize_t arrayLength(PyObject* self) {
+    return static_cast<Py_ssize_t>(arrayOf(self).size());
+}
+
+bool index(const dspirit_array& a, PyObject* key, std::size_t& k) {
+    Py_ssize_t i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+    if (i == -1 && PyErr_Occurred()) return false;
+    const Py_ssize_t n = static_cast<Py_ssize_t>(a.size());
+    if (i < 0) i += n;
+    if (i < 0 || i >= n) {
+        PyErr_SetString(PyExc_IndexError, "dspirit_array: index out of range");
+        return false;
+    }
+    k = static_cast<std::size_t>(i);
+    return true;
+}
+
+PyObject* arrayGetItem(PyObject* self, PyObject* key) {
+    const dspirit_array& a = arrayOf(self);
+    std::size_t k = 0;
+    if (!index(a, key, k)) return nullptr;
+    return guarded([&] { return wrap(a[k]); });
+}
+
+int arraySetItem(PyObject* self, PyObject* key, PyObject* item) {
+    if (!item) {
+        PyErr_SetString(PyExc_TypeError, "dspirit_array: elements cannot be deleted");
+        return -1;
+    }
+    dspirit_array& a = arrayOf(self);
+    std::size_t k = 0;
+    dspirit value;
+    if (!index(a, key, k) || !scalarArgument(item, value)) return -1;
+    return guarded(-1, [&] {
+        a.set(k, value);
+        return 0;
+    });
+}
+
+// Из структурного NumPy с полями r, i, j, level
+PyObject* fromRecords(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"records", nullptr};
+    PyObject* records = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", const_cast<char**>(keywords), &records)) return nullptr;
+    if (!recordsDtype()) return nullptr;
+    PyObject* contiguous = PyObject_CallMethod(numpy(), "ascontiguousarray", "OO", records, recordsDtype());
+    if (!contiguous) return nullptr;
+    buffer data;
+    const bool ok = data.acquire(contiguous, PyBUF_C_CONTIGUOUS);
+    Py_DECREF(contiguous);
+    if (!ok) return nullptr;
+    if (data.view().ndim != 1) {
+        PyErr_SetString(PyExc_ValueError, "dspirit_array: expected a 1-D array");
+        return nullptr;
+    }
+    const dspirit_parts* parts = static_cast<const dspirit_parts*>(data.view().buf);
+    const std::size_t n = static_cast<std::size_t>(data.view().shape[0]);
+    return guarded([&] {
+        dspirit_array result(n);
+        {
+            gil_released release;
+            for (std::size_t k = 0; k < n; ++k) result.set(k, parts[k]);
+        }
+        return wrap(std::move(result));
+    });
+}
+
+// Копия в структурный NumPy (SoA-плоскости нельзя описать одним dtype)
+PyObject* toRecords(PyObject* self, PyObject*) {
+    if (!recordsDtype()) return nullptr;
+    const dspirit_array& a = arrayOf(self);
+    PyObject* records = PyObject_CallMethod(numpy(), "empty", "nO", static_cast<Py_ssize_t>(a.size()), recordsDtype());
+    if (!records) return nullptr;
+    {
+        buffer data;
+        if (!data.acquire(records, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE)) {
+            Py_DECREF(records);
+            return nullptr;
+        }
+        dspirit_parts* parts = static_cast<dspirit_parts*>(data.view().buf);
+        gil_released release;
+        for (std::size_t k = 0; k < a.size(); ++k) parts[k] = a.parts(k);
+    }
+    return records;
+}
+
+// Пакетные ядра без GIL
+
+using array_kernel = void (*)(const_dspirit_view, const_dspirit_view, dspirit_view);
+using right_kernel = void (*)(const_dspirit_view, const dspirit_parts&, dspirit_view);
+using left_kernel = void (*)(const dspirit_parts&, const_dspirit_view, dspirit_view);
+
+// Массив с массивом или с числом с любой стороны; число передаётся ядру
+// как есть, без массива из n его повторений
+template <array_kernel Both, right_kernel Right, left_kernel Left>
+PyObject* arrayBinary(PyObject* a, PyObject* b) {
+    dspirit scalar;
+    if (isArray(a) && isArray(b)) {
+        const dspirit_array& x = arrayOf(a);
+        const dspirit_array& y = arrayOf(b);
+        if (!checkSize(x, y)) return nullptr;
+        return guarded([&] {
+            dspirit_array out(x.size());
+            {
+                gil_released release;
+                Both(x, y, out);
+            }
+            return wrap(std::move(out));
+        });
+    }
+    const bool arrayLeft = isArray(a);
+    const int converted = toScalar(arrayLeft ? b : a, scalar);
+    if (converted < 0) return nullptr;
+    if (converted == 0) Py_RETURN_NOTIMPLEMENTED;
+    const dspirit_array& x = arrayOf(arrayLeft ? a : b);
+    const dspirit_parts s = scalar.toParts();
+    return guarded([&] {
+        dspirit_array out(x.size());
+        {
+            gil_released release;
+            if (arrayLeft) Right(x, s, out);
+            else Left(s, x, out);
+        }
+        return wrap(std::move(out));
+    });
+}
+
+PyObject* arrayNegative(PyObject* self) {
+    const dspirit_array& x = arrayOf(self);
+    return guarded([&] {
+        dspirit_array out(x.size());
+        {
+            gil_released release;
+            batch::negate(x, out);
+        }
+        return wrap(std::move(out));
+    });
+}
+
+PyObject* power(const dspirit_array& x, double exponent) {
+    return guarded([&] {
+        dspirit_array out(x.size());
+        {
+            gil_released release;
+            batch::pow(x, exponent, out, nullptr);
+        }
+        return wrap(std::move(out));
+    });
+}
+
+PyObject* arrayPower(PyObject* base, PyObject* exponent, PyObject* modulus) {
+    if (modulus != Py_None || !isArray(base) || !(PyFloat_Check(exponent) || PyLong_Check(exponent))) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    const double p = PyFloat_AsDouble(exponent);
+    if (p == -1.0 && PyErr_Occurred()) return nullptr;
+    return power(arrayOf(base), p);
+}
+
+bool compareParts(int op, const dspirit_parts& a, const dspirit_parts& b) {
+    switch (op) {
+    case Py_EQ: return kernel::equals(a, b);
+    case Py_NE: return !kernel::equals(a, b);
+    case Py_LT: return kernel::less(a, b);
+    case Py_LE: return !kernel::less(b, a);
+    case Py_GT: return kernel::less(b, a);
+    case Py_GE: return !kernel::less(a, b);
+    }
+    return false;
+}
+
+// Сравнение с массивом или числом - массив NumPy bool
+PyObject* arrayCompare(PyObject* self, PyObject* other, int op) {
+    const dspirit_array& a = arrayOf(self);
+    const dspirit_array* b = nullptr;
+    dspirit scalar;
+    if (isArray(other)) {
+        b = &arrayOf(other);
+        if (!checkSize(a, *b)) return nullptr;
+    } else {
+        const int converted = toScalar(other, scalar);
+        if (converted < 0) return nullptr;
+        if (converted == 0) Py_RETURN_NOTIMPLEMENTED;
+    }
+    if (!numpy()) return nullptr;
+    PyObject* out = PyObject_CallMethod(numpy(), "empty", "ns", static_cast<Py_ssize_t>(a.size()), "?");
+    if (!out) return nullptr;
+    {
+        buffer data;
+        if (!data.acquire(out, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE)) {
+            Py_DECREF(out);
+            return nullptr;
+        }
+        bool* result = static_cast<bool*>(data.view().buf);
+        const dspirit_parts rhs = scalar.toParts();
+        gil_released release;
+        for (std::size_t k = 0; k < a.size(); ++k) result[k] = compareParts(op, a.parts(k), b ? b->parts(k) : rhs);
+    }
+    return out;
+}
+
+template <double* (dspirit_array::*Plane)()>
+PyObject* arrayPlane(PyObject* self, void*) {
+    return plane(self, (arrayOf(self).*Plane)());
+}
+
+PyMethodDef array_methods[] = {
+    {"from_records", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(fromRecords)),
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC, nullptr},
+    {"to_records", toRecords, METH_NOARGS, nullptr},
+    {nullptr, nullptr, 0, nullptr}};
+
+// Плоскости без копирования (запись в них меняет массив)
+PyGetSetDef array_getset[] = {
+    {"r", arrayPlane<&dspirit_array::r>, nullptr, nullptr, nullptr},
+    {"i", arrayPlane<&dspirit_array::i>, nullptr, nullptr, nullptr},
+    {"j", arrayPlane<&dspirit_array::j>, nullptr, nullptr, nullptr},
+    {"level", arrayPlane<&dspirit_array::level>, nullptr, nullptr, nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyType_Slot array_slots[] = {
+    {Py_tp_new, reinterpret_cast<void*>(arrayNew)},
+    {Py_tp_dealloc, reinterpret_cast<void*>(arrayDealloc)},
+    {Py_tp_richcompare, reinterpret_cast<void*>(arrayCompare)},
+    {Py_tp_hash, reinterpret_cast<void*>(PyObject_HashNotImplemented)},
+    {Py_tp_methods, array_methods},
+    {Py_tp_getset, array_getset},
+    {Py_mp_length, reinterpret_cast<void*>(arrayLength)},
+    {Py_mp_subscript, reinterpret_cast<void*>(arrayGetItem)},
+    {Py_mp_ass_subscript, reinterpret_cast<void*>(arraySetItem)},
+    {Py_sq_length, reinterpret_cast<void*>(arrayLength)},
+    {Py_nb_add, reinterpret_cast<void*>(arrayBinary<batch::add, batch::add, batch::add>)},
+    {Py_nb_subtract, reinterpret_cast<void*>(arrayBinary<batch::subtract, batch::subtract, batch::subtract>)},
+    {Py_nb_multiply, reinterpret_cast<void*>(arrayBinary<batch::multiply, batch::multiply, batch::multiply>)},
+    {Py_nb_true_divide, reinterpret_cast<void*>(arrayBinary<batch::divide, batch::divide, batch::divide>)},
+    {Py_nb_negative, reinterpret_cast<void*>(arrayNegative)},
+    {Py_nb_power, reinterpret_cast<void*>(arrayPower)},
+    {Py_tp_doc, const_cast<char*>("SoA array of MLNS numbers")},
+    {0, nullptr}};
+
+PyType_Spec array_spec = {"paradox.dspirit_array", sizeof(array_object), 0, Py_TPFLAGS_DEFAULT, array_slots};
+
+// Функции модуля: массив - пакетное ядро, число - скалярная функция
+
+// Элементы вне области определения получают NaN уровня 0
+template <std::size_t (*Batch)(const_dspirit_view, dspirit_view, std::uint64_t*), dspirit (*Scalar)(const dspirit&)>
+PyObject* unary(PyObject*, PyObject* argument) {
+    if (isArray(argument)) {
+        const dspirit_array& x = arrayOf(argument);
+        return guarded([&] {
+            dspirit_array out(x.size());
+            {
+                gil_released release;
+                Batch(x, out, nullptr);
+            }
+            return wrap(std::move(out));
+        });
+    }
+    dspirit x;
+    if (!scalarArgument(argument, x)) return nullptr;
+    return guarded([&] { return wrap(Scalar(x)); });
+}
+
+template <void (*Batch)(const_dspirit_view, const_dspirit_view, dspirit_view),
+          dspirit (*Scalar)(const dspirit&, const dspirit&)>
+PyObject* binary(PyObject*, PyObject* const* args, Py_ssize_t count) {
+    if (count != 2) {
+        PyErr_SetString(PyExc_TypeError, "expected two arguments");
+        return nullptr;
+    }
+    if (isArray(args[0]) && isArray(args[1])) {
+        const dspirit_array& x = arrayOf(args[0]);
+        const dspirit_array& y = arrayOf(args[1]);
+        if (!checkSize(x, y)) return nullptr;
+        return guarded([&] {
+            dspirit_array out(x.size());
+            {
+                gil_released release;
+                Batch(x, y, out);
+            }
+            return wrap(std::move(out));
+        });
+    }
+    dspirit x, y;
+    if (!scalarArgument(args[0], x) || !scalarArgument(args[1], y)) return nullptr;
+    return guarded([&] { return wrap(Scalar(x, y)); });
+}
+
+PyObject* modulePow(PyObject*, PyObject* const* args, Py_ssize_t count) {
+    if (count != 2) {
+        PyErr_SetString(PyExc_TypeError, "pow() expects two arguments");
+        return nullptr;
+    }
+    const double p = PyFloat_AsDouble(args[1]);
+    if (p == -1.0 && PyErr_Occurred()) return nullptr;
+    if (isArray(args[0])) return power(arrayOf(args[0]), p);
+    dspirit x;
+    if (!scalarArgument(args[0], x)) return nullptr;
+    return guarded([&] { return wrap(pow(x, p)); });
+}
+
+PyObject* moduleFma(PyObject*, PyObject* const* args, Py_ssize_t count) {
+    if (count != 3 || !isArray(args[0]) || !isArray(args[1]) || !isArray(args[2])) {
+        PyErr_SetString(PyExc_TypeError, "fma() expects three dspirit_array arguments");
+        return nullptr;
+    }
+    const dspirit_array& a = arrayOf(args[0]);
+    const dspirit_array& b = arrayOf(args[1]);
+    const dspirit_array& c = arrayOf(args[2]);
+    if (!checkSize(a, b) || !checkSize(a, c)) return nullptr;
+    return guarded([&] {
+        dspirit_array out(a.size());
+        {
+            gil_released release;
+            batch::fma(a, b, c, out);
+        }
+        return wrap(std::move(out));
+    });
+}
+
+// Скалярные функции - свободные функции dspirit (находятся через ADL)
+#define PARADOX_SCALAR(name) \
+    dspirit name##Scalar(const dspirit& x) { return name(x); }
+PARADOX_SCALAR(sqrt)
+PARADOX_SCALAR(exp)
+PARADOX_SCALAR(log)
+PARADOX_SCALAR(sin)
+PARADOX_SCALAR(cos)
+PARADOX_SCALAR(tan)
+PARADOX_SCALAR(sinh)
+PARADOX_SCALAR(cosh)
+PARADOX_SCALAR(tanh)
+PARADOX_SCALAR(cbrt)
+PARADOX_SCALAR(erf)
+PARADOX_SCALAR(log1p)
+PARADOX_SCALAR(expm1)
+#undef PARADOX_SCALAR
+
+dspirit atan2Scalar(const dspirit& y, const dspirit& x) { return atan2(y, x); }
+dspirit hypotScalar(const dspirit& x, const dspirit& y) { return hypot(x, y); }
+
+#define PARADOX_UNARY(name) {#name, unary<batch::name, name##Scalar>, METH_O, nullptr}
+#define PARADOX_FASTCALL(name, fn) \
+    {name, reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(fn)), METH_FASTCALL, nullptr}
+
+PyMethodDef module_methods[] = {
+    PARADOX_UNARY(sqrt),
+    PARADOX_UNARY(exp),
+    PARADOX_UNARY(log),
+    PARADOX_UNARY(sin),
+    PARADOX_UNARY(cos),
+    PARADOX_UNARY(tan),
+    PARADOX_UNARY(sinh),
+    PARADOX_UNARY(cosh),
+    PARADOX_UNARY(tanh),
+    PARADOX_UNARY(cbrt),
+    PARADOX_UNARY(erf),
+    PARADOX_UNARY(log1p),
+    PARADOX_UNARY(expm1),
+    PARADOX_FASTCALL("pow", modulePow),
+    PARADOX_FASTCALL("fma", moduleFma),
+    PARADOX_FASTCALL("atan2", (binary<batch::atan2, atan2Scalar>)),
+    PARADOX_FASTCALL("hypot", (binary<batch::hypot, hypotScalar>)),
+    {nullptr, nullptr, 0, nullptr}};
+
+#undef PARADOX_UNARY
+#undef PARADOX_FASTCALL
+
+PyModuleDef module_def = {PyModuleDef_HEAD_INIT, "paradox",
+                          "MLNS numbers (dspirit) with SoA arrays and batch kernels", -1, module_methods,
+                          nullptr, nullptr, nullptr, nullptr};
+
+bool addType(PyObject* module, PyType_Spec& spec, PyTypeObject*& type, const char* name) {
+    type = reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&spec));
+    if (!type) return false;
+    if (!name) return true;
+    Py_INCREF(type);
+    if (PyModule_AddObject(module, name, reinterpret_cast<PyObject*>(type)) < 0) {
+        Py_DECREF(type);
+        return false;
+    }
+    return true;
+}
+
+bool addConstant(PyObject* module, const char* name, const dspirit& value) {
+    PyObject* object = guarded([&] { return wrap(value); });
+    if (!object) return false;
+    if (PyModule_AddObject(module, name, object) < 0) {
+        Py_DECREF(object);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_paradox() {
+    PyObject* module = PyModule_Create(&module_def);
+    if (!module) return nullptr;
+    const bool ok = addType(module, dspirit_spec, dspirit_type, "dspirit") &&
+                    addType(module, array_spec, array_type, "dspirit_array") &&
+                    addType(module, plane_spec, plane_type, nullptr) &&
+                    addConstant(module, "ZERO", dspirit::ZERO) && addConstant(module, "ONE", dspirit::ONE) &&
+                    addConstant(module, "INF", dspirit::INF) && addConstant(module, "NEG_INF", dspirit::NEG_INF) &&
+                    addConstant(module, "NEG_ONE", dspirit::NEG_ONE) &&
+                    addConstant(module, "EPSILON", dspirit::EPSILON) &&
+                    addConstant(module, "SUPER_ZERO", dspirit::SUPER_ZERO) &&
+                    addConstant(module, "SUPER_INF", dspirit::SUPER_INF);
+    if (!ok) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
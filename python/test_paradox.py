@@ -0,0 +1,118 @@
+# Проверка модуля Python: скаляры, массивы, плоскости без копирования,
+# пакетные ядра. Запускается через ctest с собранным модулем в PYTHONPATH
+import math
+import threading
+
+import numpy as np
+
+import paradox as p
+
+
+def test_scalars():
+    print("Testing dspirit...")
+
+    assert p.ZERO * p.INF == p.ONE
+    assert (p.dspirit(1.0) - 1.0).is_zero()
+    assert p.dspirit("inf") == p.INF
+    assert p.dspirit("1@-1") == p.ZERO
+    assert float(p.dspirit(2.5) * 2) == 5.0
+    assert float(3.0 - p.dspirit(1.0)) == 2.0
+    assert (p.INF + 1.0).is_infinity()
+    assert p.dspirit.from_level(2.0, 1.0).level == 1.0
+    assert p.sqrt(p.dspirit(4.0)) == p.dspirit(2.0)
+    try:
+        p.sqrt(-1.0)
+        assert False
+    except ValueError:
+        pass
+    for x in (p.INF, p.ZERO, p.EPSILON, p.dspirit.from_parts(1.5, 0.25, -2.0, 3.0)):
+        y = eval(repr(x), {"dspirit": p.dspirit})
+        assert (y.r, y.i, y.j, y.level) == (x.r, x.i, x.j, x.level)
+
+    try:
+        p.dspirit("1@")
+        assert False
+    except ValueError:
+        pass
+
+    print("dspirit passed!\n")
+
+
+def test_arrays():
+    print("Testing dspirit_array...")
+
+    a = p.dspirit_array(np.arange(1.0, 6.0))
+    b = p.dspirit_array(5, p.INF)
+    assert len(a) == 5 and a[-1] == p.dspirit(5.0)
+
+    # Плоскости - представления без копирования
+    a.r[0] = 10.0
+    assert a[0] == p.dspirit(10.0)
+    assert np.all(b.level == 1.0)
+
+    s = a + b
+    assert np.all(s.level == 1.0)
+    product = p.ZERO * b
+    assert np.all(product == p.ONE)
+    assert np.all((a * 2.0).r == 2.0 * a.r)
+    assert np.all((1.0 / a).r == 1.0 / a.r)
+    assert list(a < 4.0) == [False, True, True, False, False]
+
+    # Число с любой стороны - как массив из его повторений
+    for scalar in (2.5, p.INF, p.ZERO, p.dspirit.from_parts(1.5, 0.5, 0.0, 1.0)):
+        repeated = p.dspirit_array(len(a), scalar)
+        assert np.all(a + scalar == a + repeated) and np.all(scalar + a == repeated + a)
+        assert np.all(a - scalar == a - repeated) and np.all(scalar - a == repeated - a)
+        assert np.all(a * scalar == a * repeated) and np.all(scalar * a == repeated * a)
+        assert np.all(a / scalar == a / repeated) and np.all(scalar / a == repeated / a)
+
+    records = a.to_records()
+    assert records.dtype.names == ("r", "i", "j", "level")
+    assert np.all(p.dspirit_array.from_records(records) == a)
+
+    try:
+        a + p.dspirit_array(3)
+        assert False
+    except ValueError:
+        pass
+
+    print("dspirit_array passed!\n")
+
+
+def test_batch():
+    print("Testing batch functions...")
+
+    x = p.dspirit_array(np.array([-1.0, 4.0, 9.0]))
+    root = p.sqrt(x)
+    assert math.isnan(root[0].r) and root[0].level == 0.0
+    assert list(root.r[1:]) == [2.0, 3.0]
+    assert np.allclose(p.exp(p.log(p.dspirit_array(np.array([0.5, 2.0])))).r, [0.5, 2.0])
+    assert p.hypot(p.dspirit_array(np.array([3.0])), p.dspirit_array(np.array([4.0])))[0] == p.dspirit(5.0)
+    assert p.fma(x, x, x)[2] == p.dspirit(90.0)
+
+    # Ядра отпускают GIL: параллельные вызовы дают те же результаты
+    big = p.dspirit_array(np.linspace(0.1, 10.0, 1 << 18))
+    expected = p.sin(big).r.copy()
+    results = [None] * 4
+
+    def run(k):
+        results[k] = p.sin(big).r.copy()
+
+    threads = [threading.Thread(target=run, args=(k,)) for k in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert all(np.array_equal(r, expected) for r in results)
+
+    print("Batch functions passed!\n")
+
+
+if __name__ == "__main__":
+    print("=== Testing Python module ===\n")
+
+    test_scalars()
+    test_arrays()
+    test_batch()
+
+    print("=== All Python module tests passed! ===")
@@ -0,0 +1,250 @@
+#include "paradox/arrow.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace paradox {
+
+namespace {
+
+const char* const PLANE_NAMES[4] = {"r", "i", "j", "level"};
+const char* const EXTENSION_KEY = "ARROW:extension:name";
+
+// Схема
+
+struct schema_data {
+    std::vector<char> metadata;
+    ArrowSchema children[4];
+    ArrowSchema* childPointers[4];
+};
+
+// Дочерние схемы ссылаются только на статические строки
+void releaseLeafSchema(ArrowSchema* schema) {
+    schema->release = nullptr;
+}
+
+void releaseSchema(ArrowSchema* schema) {
+    schema_data* data = static_cast<schema_data*>(schema->private_data);
+    for (ArrowSchema& child : data->children) {
+        if (child.release) child.release(&child);
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+void leafSchema(ArrowSchema* schema, const char* name) {
+    *schema = ArrowSchema();
+    schema->format = "g";
+    schema->name = name;
+    schema->release = releaseLeafSchema;
+}
+
+// Метаданные: int32 число пар, затем для каждой пары int32 длина и байты
+// ключа и значения (порядок байт платформы, как в спецификации)
+void appendBytes(std::vector<char>& out, const void* bytes, std::size_t n) {
+    const std::size_t at = out.size();
+    out.resize(at + n);
+    if (n != 0) std::memcpy(&out[at], bytes, n);
+}
+
+void appendInt32(std::vector<char>& out, std::int32_t value) {
+    appendBytes(out, &value, 4);
+}
+
+void appendString(std::vector<char>& out, const char* text) {
+    const std::size_t n = std::strlen(text);
+    appendInt32(out, static_cast<std::int32_t>(n));
+    appendBytes(out, text, n);
+}
+
+void structSchema(ArrowSchema* schema) {
+    schema_data* data = new schema_data();
+    appendInt32(data->metadata, 1);
+    appendString(data->metadata, EXTENSION_KEY);
+    appendString(data->metadata, arrow::EXTENSION_NAME);
+    for (int c = 0; c < 4; ++c) {
+        leafSchema(&data->children[c], PLANE_NAMES[c]);
+        data->childPointers[c] = &data->children[c];
+    }
+
+    *schema = ArrowSchema();
+    schema->format = "+s";
+    schema->name = "";
+    schema->metadata = data->metadata.data();
+    schema->n_children = 4;
+    schema->children = data->childPointers;
+    schema->release = releaseSchema;
+    schema->private_data = data;
+}
+
+// Массив
+
+struct array_data {
+    std::shared_ptr<const void> owner;  // владелец данных (или пусто)
+    const void* buffers[2] = {nullptr, nullptr};
+    ArrowArray children[4];
+    ArrowArray* childPointers[4];
+};
+
+void releaseArray(ArrowArray* array) {
+    array_data* data = static_cast<array_data*>(array->private_data);
+    for (std::int64_t c = 0; c < array->n_children; ++c) {
+        ArrowArray& child = data->children[c];
+        if (child.release) child.release(&child);
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+// float64 без null: буфер валидности отсутствует
+void leafArray(ArrowArray* array, const double* values, std::size_t n, const std::shared_ptr<const void>& owner) {
+    array_data* data = new array_data();
+    data->owner = owner;
+    data->buffers[1] = values;
+
+    *array = ArrowArray();
+    array->length = static_cast<std::int64_t>(n);
+    array->n_buffers = 2;
+    array->buffers = data->buffers;
+    array->release = releaseArray;
+    array->private_data = data;
+}
+
+// Нули для отсутствующих плоскостей вместе с исходным владельцем
+struct zero_planes {
+    std::shared_ptr<const void> owner;
+    std::vector<double> values;
+};
+
+void exportView(const_dspirit_view values, std::shared_ptr<const void> owner, ArrowSchema* schema, ArrowArray* array) {
+    if (values.isPlain()) {
+        leafSchema(schema, "");
+        leafArray(array, values.r, values.size, owner);
+        return;
+    }
+
+    // Отсутствующие плоскости (nullptr) заменяются нулями
+    const double* planes[4] = {values.r, values.i, values.j, values.level};
+    if (!values.i || !values.j || !values.level) {
+        std::shared_ptr<zero_planes> zeros = std::make_shared<zero_planes>();
+        zeros->owner = owner;
+        zeros->values.assign(values.size, 0.0);
+        for (const double*& plane : planes) {
+            if (!plane) plane = zeros->values.data();
+        }
+        owner = zeros;
+    }
+
+    structSchema(schema);
+
+    array_data* data = new array_data();
+    data->owner = owner;
+    for (int c = 0; c < 4; ++c) {
+        leafArray(&data->children[c], planes[c], values.size, owner);
+        data->childPointers[c] = &data->children[c];
+    }
+    *array = ArrowArray();
+    array->length = static_cast<std::int64_t>(values.size);
+    array->n_buffers = 1;
+    array->n_children = 4;
+    array->buffers = data->buffers;
+    array->children = data->childPointers;
+    array->release = releaseArray;
+    array->private_data = data;
+}
+
+// Импорт
+
+bool hasNulls(const ArrowArray* array) {
+    return array->null_count > 0 || (array->null_count < 0 && array->n_buffers > 0 && array->buffers[0]);
+}
+
+// Буфер значений float64 с учётом смещения; false - формат не подходит
+bool float64Plane(const ArrowArray* array, const ArrowSchema* schema, std::int64_t offset, std::int64_t length,
+                  const double*& plane) {
+    if (!schema->format || std::strcmp(schema->format, "g") != 0) return false;
+    if (array->n_buffers != 2 || hasNulls(array)) return false;
+    if (offset + length > array->length) return false;
+    if (length > 0 && !array->buffers[1]) return false;
+    plane = static_cast<const double*>(array->buffers[1]) + array->offset + offset;
+    return true;
+}
+
+} // namespace
+
+namespace arrow {
+
+void exportArray(const_dspirit_view values, ArrowSchema* schema, ArrowArray* array) {
+    exportView(values, nullptr, schema, array);
+}
+
+void exportArray(dspirit_array&& values, ArrowSchema* schema, ArrowArray* array) {
+    std::shared_ptr<const dspirit_array> owner = std::make_shared<const dspirit_array>(std::move(values));
+    exportView(owner->view(), owner, schema, array);
+}
+
+} // namespace arrow
+
+arrow_column::~arrow_column() {
+    reset();
+}
+
+arrow_column::arrow_column(arrow_column&& other) noexcept : array_(other.array_), view_(other.view_) {
+    other.array_.release = nullptr;
+    other.view_ = const_dspirit_view();
+}
+
+arrow_column& arrow_column::operator=(arrow_column&& other) noexcept {
+    if (this != &other) {
+        reset();
+        array_ = other.array_;
+        view_ = other.view_;
+        other.array_.release = nullptr;
+        other.view_ = const_dspirit_view();
+    }
+    return *this;
+}
+
+void arrow_column::reset() {
+    if (array_.release) array_.release(&array_);
+    array_ = ArrowArray();
+    view_ = const_dspirit_view();
+}
+
+status arrow_column::fromArrow(ArrowArray* array, const ArrowSchema* schema, arrow_column& out) {
+    if (!array || !schema || !array->release || !schema->format || array->length < 0) return status::invalid_argument;
+
+    const_dspirit_view view;
+    view.size = static_cast<std::size_t>(array->length);
+
+    if (std::strcmp(schema->format, "g") == 0) {
+        if (!float64Plane(array, schema, 0, array->length, view.r)) return status::invalid_argument;
+    } else if (std::strcmp(schema->format, "+s") == 0) {
+        // Дочерние столбцы сопоставляются по именам r, i, j, level
+        if (hasNulls(array) || array->n_children != 4 || schema->n_children != 4) return status::invalid_argument;
+        const double** planes[4] = {&view.r, &view.i, &view.j, &view.level};
+        for (int c = 0; c < 4; ++c) {
+            const ArrowSchema* childSchema = schema->children[c];
+            int plane = -1;
+            for (int p = 0; p < 4; ++p) {
+                if (childSchema->name && std::strcmp(childSchema->name, PLANE_NAMES[p]) == 0) plane = p;
+            }
+            if (plane < 0 || *planes[plane]) return status::invalid_argument;
+            if (!float64Plane(array->children[c], childSchema, array->offset, array->length, *planes[plane])) {
+                return status::invalid_argument;
+            }
+        }
+    } else {
+        return status::invalid_argument;
+    }
+
+    // Перемещение по правилам спецификации: источник помечается освобождённым
+    out.reset();
+    out.array_ = *array;
+    out.view_ = view;
+    array->release = nullptr;
+    return status::ok;
+}
+
+} // namespace paradox
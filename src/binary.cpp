@@ -0,0 +1,293 @@
+#include "paradox/binary.h"
+#include "paradox/status.h"
+#include "byte_order.h"
+#include "dspirit_impl.h"
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace paradox {
+
+using detail::Impl;
+using detail::loadDoubles;
+using detail::loadU16;
+using detail::loadU32;
+using detail::storeDoubles;
+using detail::storeU16;
+using detail::storeU32;
+
+namespace {
+
+const unsigned char MAGIC[4] = {'P', 'D', 'X', 'B'};
+const std::size_t STREAM_HEADER_BYTES = 8;
+const std::size_t BLOCK_HEADER_BYTES = 16;
+
+void raiseCorrupt(const char* message) {
+    detail::raise(status::corrupt_data, message);
+}
+
+} // namespace
+
+namespace binary {
+
+bool isPlain(const dspirit_parts& value) {
+    if (value.i != 0.0 || value.j != 0.0) return false;
+    // ZERO записывается как 0.0
+    if (value.r == 1.0 && value.level == -1.0) return true;
+    return value.level == 0.0 && !Impl().isApproxZero(value.r);
+}
+
+// Fletcher-64: две суммы по модулю 2^32-1. Свёртка каждые 2^16 слов
+// не даёт переполниться 64-битным накопителям.
+std::uint32_t checksum(const void* data, std::size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const std::uint64_t MOD = 0xFFFFFFFFu;
+    const std::size_t CHUNK_WORDS = 65536;
+    std::uint64_t a = 0, b = 0;
+
+    std::size_t words = bytes / 4;
+    while (words > 0) {
+        const std::size_t n = std::min(words, CHUNK_WORDS);
+        for (std::size_t k = 0; k < n; ++k) {
+            a += loadU32(p + 4 * k);
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+        p += 4 * n;
+        words -= n;
+    }
+    // Хвост, дополненный нулями
+    if (bytes % 4 != 0) {
+        unsigned char tail[4] = {0, 0, 0, 0};
+        std::memcpy(tail, p, bytes % 4);
+        a = (a + loadU32(tail)) % MOD;
+        b = (b + a) % MOD;
+    }
+    return static_cast<std::uint32_t>(a ^ (b << 16) ^ (b >> 16));
+}
+
+} // namespace binary
+
+// Запись
+
+binary_writer::binary_writer(std::ostream& out)
+    : out_(out), kind_(binary::block_kind::plain), pending_(0), count_(0), finished_(false),
+      r_(binary::BLOCK_VALUES), i_(binary::BLOCK_VALUES), j_(binary::BLOCK_VALUES),
+      level_(binary::BLOCK_VALUES), bytes_(4 * binary::BLOCK_VALUES * sizeof(double)) {
+    unsigned char header[STREAM_HEADER_BYTES];
+    std::memcpy(header, MAGIC, 4);
+    storeU16(header + 4, binary::VERSION);
+    storeU16(header + 6, 0);
+    out_.write(reinterpret_cast<const char*>(header), sizeof header);
+}
+
+binary_writer::~binary_writer() {
+    if (finished_ || !out_) return;
+    flush();
+    writeBlock(binary::block_kind::end, count_, nullptr, 0);
+    finished_ = true;
+}
+
+void binary_writer::write(const dspirit& value) {
+    write(value.toParts());
+}
+
+void binary_writer::write(const dspirit_parts& value) {
+    if (finished_) detail::raise(status::invalid_argument, "binary_writer: stream already finished");
+    if (count_ == static_cast<std::size_t>(-1)) detail::raise(status::size_mismatch, "binary_writer: too many values");
+    const binary::block_kind kind = binary::isPlain(value) ? binary::block_kind::plain : binary::block_kind::full;
+    if (pending_ != 0 && (kind != kind_ || pending_ == binary::BLOCK_VALUES)) flush();
+    kind_ = kind;
+    if (kind == binary::block_kind::plain) {
+        r_[pending_] = (value.level == 0.0) ? value.r : 0.0;
+    } else {
+        r_[pending_] = value.r;
+        i_[pending_] = value.i;
+        j_[pending_] = value.j;
+        level_[pending_] = value.level;
+    }
+    ++pending_;
+    ++count_;
+}
+
+void binary_writer::write(const_dspirit_view values) {
+    if (!values.isPlain()) {
+        for (std::size_t k = 0; k < values.size; ++k) write(values[k]);
+        return;
+    }
+    if (finished_) detail::raise(status::invalid_argument, "binary_writer: stream already finished");
+    if (values.size > static_cast<std::size_t>(-1) - count_) {
+        detail::raise(status::size_mismatch, "binary_writer: too many values");
+    }
+
+    // Столбец обычных double: kernel::make(x) восстанавливается из самого x
+    std::size_t k = 0;
+    while (k < values.size) {
+        if (pending_ != 0 && kind_ != binary::block_kind::plain) flush();
+        kind_ = binary::block_kind::plain;
+        const std::size_t n = std::min(values.size - k, binary::BLOCK_VALUES - pending_);
+        std::memcpy(&r_[pending_], values.r + k, n * sizeof(double));
+        pending_ += n;
+        count_ += n;
+        k += n;
+        if (pending_ == binary::BLOCK_VALUES) flush();
+    }
+}
+
+void binary_writer::finish() {
+    if (!finished_) {
+        flush();
+        writeBlock(binary::block_kind::end, count_, nullptr, 0);
+        finished_ = true;
+    }
+    out_.flush();
+    if (!out_) detail::raise(status::io_error, "binary_writer: write failed");
+}
+
+void binary_writer::flush() {
+    if (pending_ == 0) return;
+    std::size_t bytes;
+    if (kind_ == binary::block_kind::plain) {
+        bytes = pending_ * sizeof(double);
+        storeDoubles(bytes_.data(), r_.data(), pending_);
+    } else {
+        const std::size_t plane = pending_ * sizeof(double);
+        bytes = 4 * plane;
+        storeDoubles(bytes_.data(), r_.data(), pending_);
+        storeDoubles(bytes_.data() + plane, i_.data(), pending_);
+        storeDoubles(bytes_.data() + 2 * plane, j_.data(), pending_);
+        storeDoubles(bytes_.data() + 3 * plane, level_.data(), pending_);
+    }
+    writeBlock(kind_, pending_, bytes_.data(), bytes);
+    pending_ = 0;
+}
+
+void binary_writer::writeBlock(binary::block_kind kind, std::size_t n, const unsigned char* data, std::size_t bytes) {
+    unsigned char header[BLOCK_HEADER_BYTES];
+    storeU32(header, static_cast<std::uint32_t>(kind));
+    const std::uint64_t count = n;
+    storeU32(header + 4, static_cast<std::uint32_t>(count));
+    storeU32(header + 8, binary::checksum(data, bytes));
+    storeU32(header + 12, static_cast<std::uint32_t>(count >> 32));
+    out_.write(reinterpret_cast<const char*>(header), sizeof header);
+    if (bytes != 0) out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+}
+
+// Чтение
+
+binary_reader::binary_reader(std::istream& in)
+    : in_(in), kind_(binary::block_kind::plain), size_(0), pos_(0), count_(0), done_(false) {
+    unsigned char header[STREAM_HEADER_BYTES];
+    if (!in_.read(reinterpret_cast<char*>(header), sizeof header)) raiseCorrupt("binary_reader: missing stream header");
+    if (std::memcmp(header, MAGIC, 4) != 0) raiseCorrupt("binary_reader: not a paradox binary stream");
+    if (loadU16(header + 4) != binary::VERSION) raiseCorrupt("binary_reader: unsupported format version");
+    if (loadU16(header + 6) != 0) raiseCorrupt("binary_reader: unsupported format flags");
+}
+
+bool binary_reader::nextBlock() {
+    if (done_) return false;
+    unsigned char header[BLOCK_HEADER_BYTES];
+    if (!in_.read(reinterpret_cast<char*>(header), sizeof header)) raiseCorrupt("binary_reader: truncated stream");
+
+    const std::uint32_t kind = loadU32(header);
+    const std::uint32_t low = loadU32(header + 4);
+    const std::uint32_t sum = loadU32(header + 8);
+    const std::uint32_t high = loadU32(header + 12);
+
+    if (kind == static_cast<std::uint32_t>(binary::block_kind::end)) {
+        const std::uint64_t total = (static_cast<std::uint64_t>(high) << 32) | low;
+        if (total != count_) raiseCorrupt("binary_reader: value count mismatch");
+        done_ = true;
+        size_ = pos_ = 0;
+        return false;
+    }
+    if (kind != static_cast<std::uint32_t>(binary::block_kind::plain) &&
+        kind != static_cast<std::uint32_t>(binary::block_kind::full)) {
+        raiseCorrupt("binary_reader: unknown block type");
+    }
+    const std::size_t n = low;
+    if (high != 0 || n == 0 || n > binary::BLOCK_VALUES) raiseCorrupt("binary_reader: bad block size");
+
+    kind_ = static_cast<binary::block_kind>(kind);
+    const std::size_t doubles = (kind_ == binary::block_kind::plain) ? n : 4 * n;
+    const std::size_t bytes = doubles * sizeof(double);
+    if (bytes_.size() < bytes) bytes_.resize(4 * binary::BLOCK_VALUES * sizeof(double));
+    if (values_.size() < doubles) values_.resize(4 * binary::BLOCK_VALUES);
+
+    if (!in_.read(reinterpret_cast<char*>(bytes_.data()), static_cast<std::streamsize>(bytes))) {
+        raiseCorrupt("binary_reader: truncated block");
+    }
+    if (binary::checksum(bytes_.data(), bytes) != sum) raiseCorrupt("binary_reader: checksum mismatch");
+
+    loadDoubles(values_.data(), bytes_.data(), doubles);
+    size_ = n;
+    pos_ = 0;
+    count_ += n;
+    return true;
+}
+
+dspirit_parts binary_reader::decode(std::size_t k) const {
+    if (kind_ == binary::block_kind::plain) return Impl(values_[k]).parts();
+    return {values_[k], values_[size_ + k], values_[2 * size_ + k], values_[3 * size_ + k]};
+}
+
+bool binary_reader::read(dspirit_parts& value) {
+    if (pos_ == size_ && !nextBlock()) return false;
+    value = decode(pos_++);
+    return true;
+}
+
+bool binary_reader::read(dspirit& value) {
+    dspirit_parts parts;
+    if (!read(parts)) return false;
+    value = dspirit::fromParts(parts);
+    return true;
+}
+
+std::size_t binary_reader::read(dspirit_view out) {
+    std::size_t filled = 0;
+    while (filled < out.size) {
+        if (pos_ == size_ && !nextBlock()) break;
+        const std::size_t n = std::min(out.size - filled, size_ - pos_);
+        if (kind_ == binary::block_kind::plain) {
+            for (std::size_t k = 0; k < n; ++k) out.store(filled + k, decode(pos_ + k));
+        } else {
+            const std::size_t bytes = n * sizeof(double);
+            std::memcpy(out.r + filled, &values_[pos_], bytes);
+            std::memcpy(out.i + filled, &values_[size_ + pos_], bytes);
+            std::memcpy(out.j + filled, &values_[2 * size_ + pos_], bytes);
+            std::memcpy(out.level + filled, &values_[3 * size_ + pos_], bytes);
+        }
+        pos_ += n;
+        filled += n;
+    }
+    return filled;
+}
+
+dspirit_array binary_reader::readAll() {
+    dspirit_array result;
+    while (pos_ < size_ || nextBlock()) {
+        const std::size_t old = result.size();
+        const std::size_t n = size_ - pos_;
+        result.resize(old + n);
+        dspirit_view tail = result.view();
+        read(dspirit_view{tail.r + old, tail.i + old, tail.j + old, tail.level + old, n});
+    }
+    return result;
+}
+
+void writeBinary(std::ostream& out, const_dspirit_view values) {
+    binary_writer writer(out);
+    writer.write(values);
+    writer.finish();
+}
+
+dspirit_array readBinary(std::istream& in) {
+    binary_reader reader(in);
+    return reader.readAll();
+}
+
+} // namespace paradox
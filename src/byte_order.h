@@ -0,0 +1,80 @@
+#ifndef PARADOX_BYTE_ORDER_H
+#define PARADOX_BYTE_ORDER_H
+
+// Внутренний заголовок: little-endian запись полей двоичных форматов.
+// На little-endian платформах данные копируются без преобразования.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace paradox {
+namespace detail {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool HOST_LITTLE_ENDIAN = false;
+#else
+const bool HOST_LITTLE_ENDIAN = true;
+#endif
+
+inline void storeU16(unsigned char* p, std::uint16_t v) {
+    p[0] = static_cast<unsigned char>(v);
+    p[1] = static_cast<unsigned char>(v >> 8);
+}
+
+inline void storeU32(unsigned char* p, std::uint32_t v) {
+    for (int k = 0; k < 4; ++k) p[k] = static_cast<unsigned char>(v >> (8 * k));
+}
+
+inline void storeU64(unsigned char* p, std::uint64_t v) {
+    for (int k = 0; k < 8; ++k) p[k] = static_cast<unsigned char>(v >> (8 * k));
+}
+
+inline std::uint16_t loadU16(const unsigned char* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline std::uint32_t loadU32(const unsigned char* p) {
+    if (HOST_LITTLE_ENDIAN) {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+    std::uint32_t v = 0;
+    for (int k = 0; k < 4; ++k) v |= static_cast<std::uint32_t>(p[k]) << (8 * k);
+    return v;
+}
+
+inline std::uint64_t loadU64(const unsigned char* p) {
+    std::uint64_t v = 0;
+    for (int k = 0; k < 8; ++k) v |= static_cast<std::uint64_t>(p[k]) << (8 * k);
+    return v;
+}
+
+inline void storeDoubles(unsigned char* dst, const double* src, std::size_t n) {
+    if (HOST_LITTLE_ENDIAN) {
+        std::memcpy(dst, src, n * sizeof(double));
+        return;
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &src[k], 8);
+        storeU64(dst + 8 * k, bits);
+    }
+}
+
+inline void loadDoubles(double* dst, const unsigned char* src, std::size_t n) {
+    if (HOST_LITTLE_ENDIAN) {
+        std::memcpy(dst, src, n * sizeof(double));
+        return;
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::uint64_t bits = loadU64(src + 8 * k);
+        std::memcpy(&dst[k], &bits, 8);
+    }
+}
+
+} // namespace detail
+} // namespace paradox
+
+#endif // PARADOX_BYTE_ORDER_H
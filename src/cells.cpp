@@ -0,0 +1,133 @@
+#include "paradox/cells.h"
+#include "paradox/status.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace paradox {
+
+namespace {
+
+// Ячеек на поток, меньше которых волна считается в одном потоке
+const std::size_t CELLS_PER_THREAD = 64;
+
+// Точное сравнение всех частей: == сравнивает только r с абсолютным
+// допуском и не заметил бы малых чисел, подуровней и смены уровня
+bool identical(const dspirit& a, const dspirit& b) {
+    const dspirit_parts x = a.toParts(), y = b.toParts();
+    return std::memcmp(&x, &y, sizeof(dspirit_parts)) == 0;
+}
+
+} // namespace
+
+cell_graph::cell_id cell_graph::addCell(cell c, const dspirit& value) {
+    const cell_id id = static_cast<cell_id>(cells_.size());
+    for (cell_id dep : c.deps) {
+        if (dep >= id) detail::raise(status::invalid_argument, "cell_graph: unknown dependency");
+        c.depth = std::max(c.depth, cells_[dep].depth + 1);
+    }
+    for (cell_id dep : c.deps) cells_[dep].users.push_back(id);
+
+    cells_.push_back(std::move(c));
+    values_.push_back(value);
+    return id;
+}
+
+cell_graph::cell_id cell_graph::addInput(const dspirit& value) {
+    return addCell(cell(), value);
+}
+
+cell_graph::cell_id cell_graph::addFormula(formula f, const std::vector<cell_id>& deps) {
+    if (!f) detail::raise(status::invalid_argument, "cell_graph: empty formula");
+
+    std::vector<dspirit> args;
+    args.reserve(deps.size());
+    for (cell_id dep : deps) {
+        if (dep >= cells_.size()) detail::raise(status::invalid_argument, "cell_graph: unknown dependency");
+        args.push_back(values_[dep]);
+    }
+    const dspirit value = f(args);
+
+    cell c;
+    c.f = std::move(f);
+    c.deps = deps;
+    return addCell(std::move(c), value);
+}
+
+void cell_graph::setInput(cell_id id, const dspirit& value) {
+    if (id >= cells_.size() || !isInput(id)) {
+        detail::raise(status::invalid_argument, "cell_graph: not an input cell");
+    }
+    const bool changed = !identical(value, values_[id]);
+    values_[id] = value;
+    if (!changed) return;
+
+    if (listener_) listener_(id, values_[id]);
+    markUsers(id);
+}
+
+void cell_graph::markUsers(cell_id id) {
+    for (cell_id user : cells_[id].users) {
+        cell& c = cells_[user];
+        if (c.dirty) continue;
+        c.dirty = true;
+        if (waves_.size() <= c.depth) waves_.resize(c.depth + 1);
+        waves_[c.depth].push_back(user);
+    }
+}
+
+dspirit cell_graph::evaluate(cell_id id) const {
+    const cell& c = cells_[id];
+    std::vector<dspirit> args;
+    args.reserve(c.deps.size());
+    for (cell_id dep : c.deps) args.push_back(values_[dep]);
+    return c.f(args);
+}
+
+std::size_t cell_graph::recompute(unsigned threads) {
+    std::size_t evaluated = 0;
+
+    // Потомки всегда глубже, поэтому новые грязные ячейки попадают в
+    // ещё не обработанные волны
+    for (std::size_t depth = 1; depth < waves_.size(); ++depth) {
+        std::vector<cell_id> wave;
+        wave.swap(waves_[depth]);
+        if (wave.empty()) continue;
+
+        std::vector<dspirit> fresh(wave.size());
+        std::vector<char> changed(wave.size(), 0);
+        auto body = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; ++k) {
+                fresh[k] = evaluate(wave[k]);
+                changed[k] = !identical(fresh[k], values_[wave[k]]);
+            }
+        };
+#ifdef PARADOX_NO_EXCEPTIONS
+        detail::parallelFor(wave.size(), threads, CELLS_PER_THREAD, body);
+#else
+        try {
+            detail::parallelFor(wave.size(), threads, CELLS_PER_THREAD, body);
+        } catch (...) {
+            // Волна остаётся грязной до следующего вызова
+            waves_[depth].insert(waves_[depth].end(), wave.begin(), wave.end());
+            throw;
+        }
+#endif
+
+        for (std::size_t k = 0; k < wave.size(); ++k) {
+            const cell_id id = wave[k];
+            cells_[id].dirty = false;
+            ++evaluated;
+            values_[id] = std::move(fresh[k]);
+            if (!changed[k]) continue;
+
+            if (listener_) listener_(id, values_[id]);
+            markUsers(id);
+        }
+    }
+    return evaluated;
+}
+
+} // namespace paradox
@@ -0,0 +1,60 @@
+#include "paradox/checked.h"
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+namespace paradox {
+namespace checked {
+
+namespace {
+
+template <class Fn>
+result<dspirit> wrap(const dspirit& x, Fn fn) {
+    dspirit_parts out;
+    const status code = fn(x.toParts(), out);
+    if (code != status::ok) return code;
+    return dspirit::fromParts(out);
+}
+
+} // namespace
+
+result<dspirit> sqrt(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::sqrt(v, r); });
+}
+
+result<dspirit> pow(const dspirit& x, double exponent) {
+    return wrap(x, [exponent](const dspirit_parts& v, dspirit_parts& r) { return kernel::pow(v, exponent, r); });
+}
+
+result<dspirit> exp(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::exp(v, r); });
+}
+
+result<dspirit> log(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::log(v, r); });
+}
+
+result<dspirit> sin(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::sin(v, r); });
+}
+
+result<dspirit> cos(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::cos(v, r); });
+}
+
+result<dspirit> tan(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::tan(v, r); });
+}
+
+result<dspirit> log1p(const dspirit& x) {
+    return wrap(x, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::log1p(v, r); });
+}
+
+result<dspirit> parse(const std::string& s) {
+    detail::Impl value;
+    const status code = detail::Impl::parseSimple(s, value);
+    if (code != status::ok) return code;
+    return detail::impl_access::make(value);
+}
+
+} // namespace checked
+} // namespace paradox
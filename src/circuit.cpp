@@ -0,0 +1,580 @@
+#include "paradox/circuit.h"
+#include "dspirit_impl.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+const std::size_t npos = static_cast<std::size_t>(-1);
+
+const dspirit_parts PARTS_SUPER_ZERO = {1.0, 0.0, 0.0, -std::numeric_limits<double>::infinity()};
+const dspirit_parts PARTS_ZERO = {1.0, 0.0, 0.0, -1.0};
+
+bool isPlainParts(const dspirit_parts& x) {
+    return x.level == 0.0 && x.i == 0.0 && x.j == 0.0 && Impl::isPlainValue(x.r);
+}
+
+bool isSuperZero(const dspirit_parts& x) {
+    return x.level == -std::numeric_limits<double>::infinity();
+}
+
+// a - l * u в общем случае
+dspirit_parts subtractProductScalar(const dspirit_parts& a, const dspirit_parts& l, const dspirit_parts& u) {
+    return Impl::fromParts(l).negate().fma(Impl::fromParts(u), Impl::fromParts(a)).parts();
+}
+
+// a - l * u (a может быть точным нулём - ещё не заполненный элемент)
+inline dspirit_parts subtractProduct(const dspirit_parts& a, const dspirit_parts& l, const dspirit_parts& u) {
+    if (isPlainParts(l) && isPlainParts(u)) {
+        const double product = l.r * u.r;
+        if (isSuperZero(a) && Impl::isPlainValue(product)) return {-product, 0.0, 0.0, 0.0};
+        if (isPlainParts(a)) {
+            const double r = a.r - product;
+            if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, 0.0};
+        }
+    }
+
+    // Уровень произведения совпадает с уровнем a: покомпонентно, как в
+    // Impl::fma. Так считается большая часть разложения рядом с
+    // идеальными элементами, где числа несут бесконечно малые поправки
+    const double level = l.level + u.level;
+    const bool zero = isSuperZero(a);
+    if (std::isfinite(level) && (zero || level == a.level)) {
+        const double r = (zero ? 0.0 : a.r) - l.r * u.r;
+        const double i = (zero ? 0.0 : a.i) - (l.r * u.i + l.i * u.r);
+        const double j = (zero ? 0.0 : a.j) - (l.r * u.j + l.i * u.i + l.j * u.r);
+        if (Impl::isPlainValue(r) && std::isfinite(i) && std::isfinite(j)) {
+            return {r, Impl::isPlainValue(i) ? i : 0.0, Impl::isPlainValue(j) ? j : 0.0, level};
+        }
+    }
+    return subtractProductScalar(a, l, u);
+}
+
+// a / d
+dspirit_parts divideParts(const dspirit_parts& a, const dspirit_parts& d) {
+    if (isPlainParts(a) && isPlainParts(d)) {
+        const double r = a.r / d.r;
+        if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, 0.0};
+    }
+    return Impl::fromParts(a).divide(Impl::fromParts(d)).parts();
+}
+
+// p - n - v на элементе с бесконечной проводимостью. Старшие части,
+// совпадающие в пределах погрешности разложения, сокращаются: иначе
+// ошибка округления, умноженная на INF, дала бы бесконечный ток вместо
+// конечного, который несут младшие части
+dspirit idealDrop(const dspirit_parts& p, const dspirit_parts& n, const dspirit_parts& v) {
+    const dspirit_parts terms[3] = {p, n, v};
+    const double signs[3] = {1.0, -1.0, -1.0};
+    double level = -std::numeric_limits<double>::infinity();
+    for (const dspirit_parts& t : terms) {
+        if (!isSuperZero(t)) level = std::max(level, t.level);
+    }
+
+    double r = 0.0, i = 0.0, j = 0.0, scale = 0.0;
+    bool aligned = std::isfinite(level);
+    for (int k = 0; aligned && k < 3; ++k) {
+        const dspirit_parts& t = terms[k];
+        if (isSuperZero(t)) continue;
+        aligned = (t.level == level);
+        r += signs[k] * t.r;
+        i += signs[k] * t.i;
+        j += signs[k] * t.j;
+        scale = std::max(scale, std::abs(t.r));
+    }
+    if (!aligned) return dspirit::fromParts(p) - dspirit::fromParts(n) - dspirit::fromParts(v);
+    if (std::abs(r) <= circuit_solver::IDEAL_DROP_TOLERANCE * scale) r = 0.0;
+    return dspirit::fromParts(Impl(r, i, j, level).parts());
+}
+
+std::string lower(std::string_view text) {
+    std::string result(text);
+    for (char& c : result) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return result;
+}
+
+bool isGroundName(const std::string& name) {
+    return name == "0" || (name.size() == 3 && lower(name) == "gnd");
+}
+
+// Порядок исключения по приближённой минимальной степени на факторграфе
+// (как в AMD, без суперпеременных). Исключённый узел становится
+// элементом - списком соседей, которые после исключения связаны между
+// собой; поглощённые элементы освобождаются, так что память и время
+// почти линейны по числу рёбер, в отличие от явного графа исключения.
+// Степень оценивается сверху: |соседи| + |Lp| + сумма |Le \ Lp|. Равные
+// степени - по номеру, так что порядок детерминирован
+std::vector<std::size_t> minimumDegree(std::vector<std::vector<std::size_t>> variables) {
+    const std::size_t n = variables.size();
+    std::vector<std::vector<std::size_t>> elements(n);  // элементы, смежные с переменной
+    std::vector<std::vector<std::size_t>> members(n);   // переменные элемента
+    std::vector<char> eliminated(n, 0);
+    std::vector<char> absorbed(n, 0);
+    std::vector<std::size_t> degree(n);
+    std::vector<std::size_t> mark(n, npos);      // = p, если переменная в Lp
+    std::vector<std::size_t> external(n, npos);  // = p, если weight посчитан на шаге p
+    std::vector<std::size_t> weight(n);          // |Le \ Lp|
+
+    using entry = std::pair<std::size_t, std::size_t>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue;
+    for (std::size_t v = 0; v < n; ++v) {
+        degree[v] = variables[v].size();
+        queue.push({degree[v], v});
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    while (!queue.empty()) {
+        const entry top = queue.top();
+        queue.pop();
+        const std::size_t p = top.second;
+        if (eliminated[p] || top.first != degree[p]) continue;
+        eliminated[p] = 1;
+        order.push_back(p);
+
+        // Lp: соседи p напрямую и через поглощаемые элементы
+        std::vector<std::size_t>& lp = members[p];
+        mark[p] = p;
+        auto take = [&](std::size_t u) {
+            if (!eliminated[u] && mark[u] != p) {
+                mark[u] = p;
+                lp.push_back(u);
+            }
+        };
+        for (std::size_t u : variables[p]) take(u);
+        for (std::size_t e : elements[p]) {
+            if (absorbed[e]) continue;
+            for (std::size_t u : members[e]) take(u);
+            absorbed[e] = 1;
+            std::vector<std::size_t>().swap(members[e]);
+        }
+        std::vector<std::size_t>().swap(variables[p]);
+        std::vector<std::size_t>().swap(elements[p]);
+
+        for (std::size_t u : lp) {
+            for (std::size_t e : elements[u]) {
+                if (absorbed[e]) continue;
+                if (external[e] != p) {
+                    external[e] = p;
+                    weight[e] = members[e].size();
+                }
+                --weight[e];
+            }
+        }
+
+        const std::size_t remaining = n - order.size();
+        for (std::size_t u : lp) {
+            // Элементы, целиком лежащие в Lp, поглощаются p
+            std::size_t sum = 0;
+            std::vector<std::size_t>& list = elements[u];
+            std::size_t kept = 0;
+            for (std::size_t e : list) {
+                if (absorbed[e]) continue;
+                if (weight[e] == 0) {
+                    absorbed[e] = 1;
+                    continue;
+                }
+                sum += weight[e];
+                list[kept++] = e;
+            }
+            list.resize(kept);
+            list.push_back(p);
+
+            // Прямые связи внутри Lp теперь покрыты элементом p
+            std::vector<std::size_t>& direct = variables[u];
+            kept = 0;
+            for (std::size_t v : direct) {
+                if (mark[v] != p) direct[kept++] = v;
+            }
+            direct.resize(kept);
+
+            const std::size_t bound = direct.size() + lp.size() - 1 + sum;
+            degree[u] = std::min({bound, degree[u] + lp.size() - 1, remaining - 1});
+            queue.push({degree[u], u});
+        }
+    }
+    return order;
+}
+
+// Значение с необязательным множителем SPICE и единицей измерения
+bool parseValue(const std::string& token, dspirit& value) {
+    const char* first = token.data();
+    const char* last = first + token.size();
+    const std::from_chars_result parsed = dspirit::from_chars(first, last, value);
+    if (parsed.ec != std::errc() || parsed.ptr == first) return false;
+
+    const std::string suffix = lower(std::string_view(parsed.ptr, last - parsed.ptr));
+    double scale = 1.0;
+    std::size_t unit = 0;
+    if (suffix.compare(0, 3, "meg") == 0) {
+        scale = 1e6;
+        unit = 3;
+    } else if (!suffix.empty()) {
+        static const std::pair<char, double> SCALES[] = {
+            {'f', 1e-15}, {'p', 1e-12}, {'n', 1e-9}, {'u', 1e-6},
+            {'m', 1e-3}, {'k', 1e3}, {'g', 1e9}, {'t', 1e12}};
+        for (const auto& s : SCALES) {
+            if (suffix[0] == s.first) {
+                scale = s.second;
+                unit = 1;
+            }
+        }
+    }
+    for (std::size_t k = unit; k < suffix.size(); ++k) {
+        if (!std::isalpha(static_cast<unsigned char>(suffix[k]))) return false;
+    }
+    if (scale != 1.0) value = value * dspirit(scale);
+    return true;
+}
+
+[[noreturn]] void parseError(std::size_t line, const std::string& message) {
+    const std::string text = "circuit: line " + std::to_string(line) + ": " + message;
+    detail::raise(status::invalid_argument, text.c_str());
+}
+
+} // namespace
+
+// Схема
+
+circuit::circuit() : nodeNames_{"0"} {}
+
+std::size_t circuit::node(const std::string& name) {
+    if (isGroundName(name)) return GROUND;
+    const auto found = nodes_.find(name);
+    if (found != nodes_.end()) return found->second;
+    nodeNames_.push_back(name);
+    nodes_.emplace(name, nodeNames_.size() - 1);
+    return nodeNames_.size() - 1;
+}
+
+std::size_t circuit::findNode(const std::string& name) const {
+    if (isGroundName(name)) return GROUND;
+    const auto found = nodes_.find(name);
+    return found == nodes_.end() ? npos : found->second;
+}
+
+std::size_t circuit::add(circuit_element_type type, const std::string& name, std::size_t positive,
+                         std::size_t negative, const dspirit& value) {
+    if (positive >= nodeCount() || negative >= nodeCount()) {
+        detail::raise(status::invalid_argument, "circuit: node out of range");
+    }
+    if (!elementNames_.emplace(name, elements_.size()).second) {
+        detail::raise(status::invalid_argument, "circuit: duplicate element name");
+    }
+    elements_.push_back({type, name, positive, negative, value});
+    return elements_.size() - 1;
+}
+
+std::size_t circuit::resistor(const std::string& name, std::size_t a, std::size_t b, const dspirit& value) {
+    return add(circuit_element_type::resistor, name, a, b, value);
+}
+
+std::size_t circuit::voltageSource(const std::string& name, std::size_t positive, std::size_t negative,
+                                   const dspirit& value) {
+    return add(circuit_element_type::voltage_source, name, positive, negative, value);
+}
+
+std::size_t circuit::currentSource(const std::string& name, std::size_t positive, std::size_t negative,
+                                   const dspirit& value) {
+    return add(circuit_element_type::current_source, name, positive, negative, value);
+}
+
+std::size_t circuit::findElement(const std::string& name) const {
+    const auto found = elementNames_.find(name);
+    return found == elementNames_.end() ? npos : found->second;
+}
+
+void circuit::setValue(std::size_t element, const dspirit& value) {
+    elements_[element].value = value;
+}
+
+circuit circuit::parse(std::istream& in) {
+    circuit result;
+    std::string text;
+    std::size_t line = 0;
+    while (std::getline(in, text)) {
+        ++line;
+        const std::size_t comment = text.find(';');
+        if (comment != std::string::npos) text.erase(comment);
+
+        std::istringstream fields(text);
+        std::vector<std::string> tokens;
+        for (std::string token; fields >> token;) tokens.push_back(token);
+        if (tokens.empty() || tokens[0][0] == '*') continue;
+        if (tokens[0][0] == '.') {
+            if (lower(tokens[0]) == ".end") break;
+            continue;
+        }
+
+        if (tokens.size() != 4) parseError(line, "expected 'name node node value'");
+        circuit_element_type type;
+        switch (std::toupper(static_cast<unsigned char>(tokens[0][0]))) {
+        case 'R': type = circuit_element_type::resistor; break;
+        case 'V': type = circuit_element_type::voltage_source; break;
+        case 'I': type = circuit_element_type::current_source; break;
+        default: parseError(line, "unknown element " + tokens[0]);
+        }
+        dspirit value;
+        if (!parseValue(tokens[3], value)) parseError(line, "invalid value " + tokens[3]);
+        if (result.findElement(tokens[0]) != npos) parseError(line, "duplicate element " + tokens[0]);
+        result.add(type, tokens[0], result.node(tokens[1]), result.node(tokens[2]), value);
+    }
+    return result;
+}
+
+circuit circuit::parse(std::string_view text) {
+    std::istringstream in{std::string(text)};
+    return parse(in);
+}
+
+// Решатель
+
+circuit_solver::circuit_solver(const circuit& c) {
+    analyze(c);
+    factor(c);
+}
+
+void circuit_solver::update(const circuit& c) {
+    bool same = (c.elementCount() * 2 == terminals_.size()) && (c.nodeCount() == voltages_.size());
+    for (std::size_t e = 0; same && e < c.elementCount(); ++e) {
+        same = terminals_[2 * e] == c.element(e).positive && terminals_[2 * e + 1] == c.element(e).negative &&
+               types_[e] == c.element(e).type;
+    }
+    if (!same) detail::raise(status::invalid_argument, "circuit_solver: circuit topology changed");
+    factor(c);
+}
+
+void circuit_solver::analyze(const circuit& c) {
+    // Неизвестные - узлы кроме земли: узел k - неизвестная k - 1
+    const std::size_t n = c.nodeCount() - 1;
+    terminals_.clear();
+    types_.clear();
+    std::vector<std::vector<std::size_t>> adjacency(n);
+    for (std::size_t e = 0; e < c.elementCount(); ++e) {
+        const circuit_element& element = c.element(e);
+        terminals_.push_back(element.positive);
+        terminals_.push_back(element.negative);
+        types_.push_back(element.type);
+        if (element.type == circuit_element_type::current_source) continue;
+        if (element.positive == circuit::GROUND || element.negative == circuit::GROUND) continue;
+        if (element.positive == element.negative) continue;
+        adjacency[element.positive - 1].push_back(element.negative - 1);
+        adjacency[element.negative - 1].push_back(element.positive - 1);
+    }
+    for (std::vector<std::size_t>& list : adjacency) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+
+    // Верхний треугольник в новом порядке: столбец k - диагональ и соседи,
+    // исключаемые раньше
+    order_ = minimumDegree(adjacency);
+    position_.assign(n, 0);
+    for (std::size_t k = 0; k < n; ++k) position_[order_[k]] = k;
+
+    matrixOffsets_.assign(1, 0);
+    matrixIndices_.clear();
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t begin = matrixIndices_.size();
+        for (std::size_t u : adjacency[order_[k]]) {
+            if (position_[u] < k) matrixIndices_.push_back(position_[u]);
+        }
+        matrixIndices_.push_back(k);
+        std::sort(matrixIndices_.begin() + begin, matrixIndices_.end());
+        matrixOffsets_.push_back(matrixIndices_.size());
+    }
+
+    // Дерево исключения и число элементов в столбцах L
+    parent_.assign(n, npos);
+    std::vector<std::size_t> counts(n, 0);
+    std::vector<std::size_t> flag(n, npos);
+    for (std::size_t k = 0; k < n; ++k) {
+        flag[k] = k;
+        for (std::size_t p = matrixOffsets_[k]; p < matrixOffsets_[k + 1]; ++p) {
+            for (std::size_t i = matrixIndices_[p]; flag[i] != k; i = parent_[i]) {
+                if (parent_[i] == npos) parent_[i] = k;
+                ++counts[i];
+                flag[i] = k;
+            }
+        }
+    }
+    factorOffsets_.assign(n + 1, 0);
+    for (std::size_t k = 0; k < n; ++k) factorOffsets_[k + 1] = factorOffsets_[k] + counts[k];
+    factorIndices_.assign(factorOffsets_[n], 0);
+    factorValues_.resize(factorOffsets_[n]);
+    diagonal_.resize(n);
+    voltages_.resize(c.nodeCount());
+}
+
+void circuit_solver::factor(const circuit& c) {
+    const std::size_t n = c.nodeCount() - 1;
+
+    // Проводимости и токи в узлы; источник напряжения - эквивалент Нортона
+    sparse_builder builder(n, n);
+    builder.reserve(4 * c.elementCount());
+    injections_.resize(n);
+    for (std::size_t k = 0; k < n; ++k) injections_.set(k, PARTS_SUPER_ZERO);
+    auto inject = [&](std::size_t node, const dspirit& current) {
+        if (node != circuit::GROUND) injections_.set(node - 1, injections_[node - 1] + current);
+    };
+    for (std::size_t e = 0; e < c.elementCount(); ++e) {
+        const circuit_element& element = c.element(e);
+        const std::size_t a = element.positive;
+        const std::size_t b = element.negative;
+        if (element.type == circuit_element_type::current_source) {
+            inject(a, -element.value);
+            inject(b, element.value);
+            continue;
+        }
+
+        const dspirit g = (element.type == circuit_element_type::resistor) ? element.value.inverse() : dspirit::INF;
+        // Разрыв в G не входит: ZERO на диагонали без пары вне её (такие
+        // элементы sparse_matrix не хранит) - утечка на землю, которая
+        // рядом с перемычками INF даёт конечную ошибку
+        if (g.isZero()) continue;
+        if (element.type == circuit_element_type::voltage_source) {
+            inject(a, element.value * g);
+            inject(b, -(element.value * g));
+        }
+        if (a == b) continue;
+        if (a != circuit::GROUND) builder.add(a - 1, a - 1, g);
+        if (b != circuit::GROUND) builder.add(b - 1, b - 1, g);
+        if (a != circuit::GROUND && b != circuit::GROUND) {
+            builder.add(a - 1, b - 1, -g);
+            builder.add(b - 1, a - 1, -g);
+        }
+    }
+    conductance_ = builder.build(matrix_layout::column_major);
+
+    // Верхний треугольник G в новом порядке; отсутствующие элементы (разрывы) - точные нули
+    dspirit_array upper(matrixIndices_.size(), dspirit::SUPER_ZERO);
+    for (std::size_t j = 0; j < n; ++j) {
+        const std::size_t k = position_[j];
+        for (std::size_t p = conductance_.offsets()[j]; p < conductance_.offsets()[j + 1]; ++p) {
+            const std::size_t row = position_[conductance_.indices()[p]];
+            if (row > k) continue;
+            const std::size_t* begin = matrixIndices_.data() + matrixOffsets_[k];
+            const std::size_t* end = matrixIndices_.data() + matrixOffsets_[k + 1];
+            upper.set(std::lower_bound(begin, end, row) - matrixIndices_.data(), conductance_.values().parts(p));
+        }
+    }
+
+    // L D L^T по строкам: строка k находится треугольным решением по
+    // уже готовым столбцам L, обход - по дереву исключения
+    std::vector<dspirit_parts> y(n, PARTS_SUPER_ZERO);
+    std::vector<std::size_t> pattern(n);
+    std::vector<std::size_t> flag(n, npos);
+    std::vector<std::size_t> filled(n, 0);
+    std::vector<char> plainColumn(n, 1);
+    floating_ = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t top = n;
+        flag[k] = k;
+        for (std::size_t p = matrixOffsets_[k]; p < matrixOffsets_[k + 1]; ++p) {
+            std::size_t i = matrixIndices_[p];
+            y[i] = upper.parts(p);
+            std::size_t length = 0;
+            for (; flag[i] != k; i = parent_[i]) {
+                pattern[length++] = i;
+                flag[i] = k;
+            }
+            while (length > 0) pattern[--top] = pattern[--length];
+        }
+
+        dspirit_parts d = y[k];
+        y[k] = PARTS_SUPER_ZERO;
+        for (; top < n; ++top) {
+            const std::size_t i = pattern[top];
+            const dspirit_parts yi = y[i];
+            y[i] = PARTS_SUPER_ZERO;
+            const std::size_t end = factorOffsets_[i] + filled[i];
+            if (plainColumn[i] && isPlainParts(yi)) {
+                // Столбец из обычных чисел: проверяется только a
+                const double* lr = factorValues_.r();
+                for (std::size_t p = factorOffsets_[i]; p < end; ++p) {
+                    dspirit_parts& a = y[factorIndices_[p]];
+                    const double r = (isSuperZero(a) ? 0.0 : a.r) - lr[p] * yi.r;
+                    if ((isSuperZero(a) || isPlainParts(a)) && Impl::isPlainValue(r)) {
+                        a = {r, 0.0, 0.0, 0.0};
+                    } else {
+                        a = subtractProduct(a, factorValues_.parts(p), yi);
+                    }
+                }
+            } else {
+                for (std::size_t p = factorOffsets_[i]; p < end; ++p) {
+                    const std::size_t row = factorIndices_[p];
+                    y[row] = subtractProduct(y[row], factorValues_.parts(p), yi);
+                }
+            }
+            const dspirit_parts l = divideParts(yi, diagonal_.parts(i));
+            d = subtractProduct(d, l, yi);
+            factorIndices_[end] = k;
+            factorValues_.set(end, l);
+            plainColumn[i] = plainColumn[i] && isPlainParts(l);
+            ++filled[i];
+        }
+
+        // Узел без проводимостей: разрыв на землю
+        if (isSuperZero(d)) {
+            d = PARTS_ZERO;
+            ++floating_;
+        }
+        diagonal_.set(k, d);
+    }
+
+    // Прямой ход, диагональ, обратный ход
+    std::vector<dspirit_parts> x(n);
+    for (std::size_t k = 0; k < n; ++k) x[k] = injections_.parts(order_[k]);
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t p = factorOffsets_[j]; p < factorOffsets_[j + 1]; ++p) {
+            x[factorIndices_[p]] = subtractProduct(x[factorIndices_[p]], factorValues_.parts(p), x[j]);
+        }
+    }
+    for (std::size_t j = 0; j < n; ++j) x[j] = divideParts(x[j], diagonal_.parts(j));
+    for (std::size_t j = n; j-- > 0;) {
+        for (std::size_t p = factorOffsets_[j]; p < factorOffsets_[j + 1]; ++p) {
+            x[j] = subtractProduct(x[j], factorValues_.parts(p), x[factorIndices_[p]]);
+        }
+    }
+
+    voltages_.set(circuit::GROUND, PARTS_SUPER_ZERO);
+    for (std::size_t k = 0; k < n; ++k) voltages_.set(k + 1, x[position_[k]]);
+}
+
+dspirit circuit_solver::voltage(std::size_t node) const {
+    return voltages_[node];
+}
+
+dspirit circuit_solver::current(const circuit& c, std::size_t element) const {
+    const circuit_element& e = c.element(element);
+    const dspirit_parts positive = voltages_.parts(e.positive);
+    const dspirit_parts negative = voltages_.parts(e.negative);
+    switch (e.type) {
+    case circuit_element_type::resistor: {
+        const dspirit g = e.value.inverse();
+        if (g.isZero()) return dspirit::SUPER_ZERO;
+        if (g.isInfinity()) return idealDrop(positive, negative, PARTS_SUPER_ZERO) * g;
+        return (voltage(e.positive) - voltage(e.negative)) * g;
+    }
+    case circuit_element_type::voltage_source:
+        return idealDrop(positive, negative, e.value.toParts()) * dspirit::INF;
+    case circuit_element_type::current_source:
+        break;
+    }
+    return e.value;
+}
+
+} // namespace paradox
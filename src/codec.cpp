@@ -0,0 +1,469 @@
+#include "paradox/codec.h"
+#include "paradox/binary.h"
+#include "paradox/status.h"
+#include "byte_order.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace paradox {
+
+using detail::loadU16;
+using detail::loadU32;
+using detail::loadU64;
+using detail::storeU16;
+using detail::storeU32;
+using detail::storeU64;
+
+namespace {
+
+const unsigned char MAGIC[4] = {'P', 'D', 'X', 'Z'};
+const std::size_t HEADER_BYTES = 24;
+const std::size_t CHUNK_HEADER_BYTES = 24;
+
+// Флаги порции
+const std::uint32_t CHUNK_SHUFFLE = 1;
+const std::uint32_t CHUNK_ENTROPY = 2;
+
+// Кодирование уровней и индексов
+const std::uint8_t LEVEL_NONE = 0;
+const std::uint8_t LEVEL_SPARSE = 1;
+const std::uint8_t LEVEL_RLE = 2;
+const std::uint8_t INDEX_BITMAP = 0;
+const std::uint8_t INDEX_LIST = 1;
+
+[[noreturn]] void raiseCorrupt(const char* message) {
+    detail::raise(status::corrupt_data, message);
+}
+
+std::uint64_t bitsOf(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, 8);
+    return bits;
+}
+
+double fromBits(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, 8);
+    return value;
+}
+
+// Запись секций в конец буфера
+struct sink {
+    std::vector<unsigned char>& out;
+
+    unsigned char* grow(std::size_t n) {
+        const std::size_t at = out.size();
+        out.resize(at + n);
+        return out.data() + at;
+    }
+
+    void u8(std::uint8_t v) { out.push_back(v); }
+    void u16(std::uint16_t v) { storeU16(grow(2), v); }
+    void u32(std::uint32_t v) { storeU32(grow(4), v); }
+    void f64(double v) { storeU64(grow(8), bitsOf(v)); }
+};
+
+// Чтение секций с проверкой границ
+struct source {
+    const unsigned char* p;
+    const unsigned char* end;
+
+    const unsigned char* take(std::size_t n) {
+        if (n > static_cast<std::size_t>(end - p)) raiseCorrupt("compressed_array: truncated chunk");
+        const unsigned char* at = p;
+        p += n;
+        return at;
+    }
+
+    std::uint8_t u8() { return *take(1); }
+    std::uint16_t u16() { return loadU16(take(2)); }
+    std::uint32_t u32() { return loadU32(take(4)); }
+    double f64() { return fromBits(loadU64(take(8))); }
+};
+
+// Разреженная плоскость: значения, отличные от +0.0 (сравнение по битам,
+// поэтому -0.0 и NaN сохраняются)
+std::size_t sparseCount(const double* plane, std::size_t n) {
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < n; ++k) count += (bitsOf(plane[k]) != 0);
+    return count;
+}
+
+std::size_t sparseBytes(std::size_t count, std::size_t n) {
+    if (count == 0) return 4;
+    return 4 + 1 + std::min((n + 7) / 8, 2 * count) + 8 * count;
+}
+
+void encodeSparse(const double* plane, std::size_t n, std::size_t count, sink& out) {
+    out.u32(static_cast<std::uint32_t>(count));
+    if (count == 0) return;
+    if ((n + 7) / 8 <= 2 * count) {
+        out.u8(INDEX_BITMAP);
+        unsigned char* bitmap = out.grow((n + 7) / 8);
+        std::memset(bitmap, 0, (n + 7) / 8);
+        for (std::size_t k = 0; k < n; ++k) {
+            if (bitsOf(plane[k]) != 0) bitmap[k / 8] |= static_cast<unsigned char>(1u << (k % 8));
+        }
+    } else {
+        out.u8(INDEX_LIST);
+        for (std::size_t k = 0; k < n; ++k) {
+            if (bitsOf(plane[k]) != 0) out.u16(static_cast<std::uint16_t>(k));
+        }
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        if (bitsOf(plane[k]) != 0) out.f64(plane[k]);
+    }
+}
+
+// plane уже заполнена нулями
+void decodeSparse(source& in, double* plane, std::size_t n) {
+    const std::size_t count = in.u32();
+    if (count == 0) return;
+    if (count > n) raiseCorrupt("compressed_array: bad sparse count");
+    const std::uint8_t mode = in.u8();
+    if (mode == INDEX_BITMAP) {
+        const unsigned char* bitmap = in.take((n + 7) / 8);
+        const unsigned char* values = in.take(8 * count);
+        std::size_t m = 0;
+        for (std::size_t byte = 0; byte < (n + 7) / 8; ++byte) {
+            const unsigned bits = bitmap[byte];
+            if (bits == 0) continue;
+            for (unsigned b = 0; b < 8; ++b) {
+                if (!((bits >> b) & 1u)) continue;
+                const std::size_t k = 8 * byte + b;
+                if (k >= n || m == count) raiseCorrupt("compressed_array: bad sparse bitmap");
+                plane[k] = fromBits(loadU64(values + 8 * m++));
+            }
+        }
+        if (m != count) raiseCorrupt("compressed_array: bad sparse bitmap");
+    } else if (mode == INDEX_LIST) {
+        const unsigned char* positions = in.take(2 * count);
+        const unsigned char* values = in.take(8 * count);
+        for (std::size_t m = 0; m < count; ++m) {
+            const std::size_t k = loadU16(positions + 2 * m);
+            if (k >= n) raiseCorrupt("compressed_array: bad sparse position");
+            plane[k] = fromBits(loadU64(values + 8 * m));
+        }
+    } else {
+        raiseCorrupt("compressed_array: unknown sparse index");
+    }
+}
+
+// Уровни: серии одинаковых значений или разреженный список
+void encodeLevels(const double* level, std::size_t n, sink& out) {
+    const std::size_t count = sparseCount(level, n);
+    if (count == 0) {
+        out.u8(LEVEL_NONE);
+        return;
+    }
+    std::size_t runs = 1;
+    for (std::size_t k = 1; k < n; ++k) runs += (bitsOf(level[k]) != bitsOf(level[k - 1]));
+
+    if (4 + 12 * runs < sparseBytes(count, n)) {
+        out.u8(LEVEL_RLE);
+        out.u32(static_cast<std::uint32_t>(runs));
+        std::size_t start = 0;
+        for (std::size_t k = 1; k <= n; ++k) {
+            if (k == n || bitsOf(level[k]) != bitsOf(level[start])) {
+                out.f64(level[start]);
+                out.u32(static_cast<std::uint32_t>(k - start));
+                start = k;
+            }
+        }
+    } else {
+        out.u8(LEVEL_SPARSE);
+        encodeSparse(level, n, count, out);
+    }
+}
+
+void decodeLevels(source& in, double* level, std::size_t n) {
+    const std::uint8_t mode = in.u8();
+    if (mode == LEVEL_RLE) {
+        const std::size_t runs = in.u32();
+        std::size_t k = 0;
+        for (std::size_t m = 0; m < runs; ++m) {
+            const double value = in.f64();
+            const std::size_t length = in.u32();
+            if (length > n - k) raiseCorrupt("compressed_array: bad level run");
+            std::fill(level + k, level + k + length, value);
+            k += length;
+        }
+        if (k != n) raiseCorrupt("compressed_array: bad level run");
+        return;
+    }
+    std::fill(level, level + n, 0.0);
+    if (mode == LEVEL_SPARSE) decodeSparse(in, level, n);
+    else if (mode != LEVEL_NONE) raiseCorrupt("compressed_array: unknown level encoding");
+}
+
+// Плоскость байтов r: словарь до 16 значений -> 0, 1, 2 или 4 бита
+void encodePlane(const unsigned char* plane, std::size_t n, bool entropy, sink& out) {
+    unsigned char dict[16];
+    unsigned char code[256];
+    std::size_t distinct = 0;
+    if (entropy) {
+        bool seen[256] = {};
+        for (std::size_t k = 0; k < n && distinct <= 16; ++k) {
+            if (!seen[plane[k]]) {
+                seen[plane[k]] = true;
+                if (distinct < 16) {
+                    code[plane[k]] = static_cast<unsigned char>(distinct);
+                    dict[distinct] = plane[k];
+                }
+                ++distinct;
+            }
+        }
+    }
+    if (!entropy || distinct > 16) {
+        out.u8(8);
+        std::memcpy(out.grow(n), plane, n);
+        return;
+    }
+    const unsigned width = distinct <= 1 ? 0 : distinct <= 2 ? 1 : distinct <= 4 ? 2 : 4;
+    out.u8(static_cast<std::uint8_t>(width));
+    out.u8(static_cast<std::uint8_t>(distinct));
+    std::memcpy(out.grow(distinct), dict, distinct);
+    if (width == 0) return;
+
+    const std::size_t bytes = (n * width + 7) / 8;
+    unsigned char* packed = out.grow(bytes);
+    std::memset(packed, 0, bytes);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t bit = k * width;
+        packed[bit / 8] |= static_cast<unsigned char>(code[plane[k]] << (bit % 8));
+    }
+}
+
+// Возвращает указатель на плоскость: прямо в данные или в scratch
+const unsigned char* decodePlane(source& in, std::size_t n, unsigned char* scratch) {
+    const unsigned width = in.u8();
+    if (width == 8) return in.take(n);
+    if (width != 0 && width != 1 && width != 2 && width != 4) raiseCorrupt("compressed_array: bad plane width");
+
+    const std::size_t distinct = in.u8();
+    if (distinct == 0 || distinct > (1u << width) || (width == 0 && distinct != 1)) {
+        raiseCorrupt("compressed_array: bad plane dictionary");
+    }
+    unsigned char dict[16] = {};
+    std::memcpy(dict, in.take(distinct), distinct);
+    if (width == 0) {
+        std::memset(scratch, dict[0], n);
+        return scratch;
+    }
+
+    const unsigned char* packed = in.take((n * width + 7) / 8);
+    const unsigned mask = (1u << width) - 1;
+    const unsigned perByte = 8 / width;
+    for (std::size_t k = 0; k < n; ++k) {
+        scratch[k] = dict[(packed[k / perByte] >> ((k % perByte) * width)) & mask];
+    }
+    return scratch;
+}
+
+// Одна порция: заголовок и секции r, level, i/j
+void encodeChunk(const_dspirit_view values, const codec::options& opts, std::vector<unsigned char>& out) {
+    const std::size_t n = values.size;
+
+    // Неполные представления (обычные double, пустые плоскости) раскрываются
+    std::vector<double> full;
+    const double *r = values.r, *i = values.i, *j = values.j, *level = values.level;
+    if (!i || !j || !level) {
+        full.resize(4 * n);
+        for (std::size_t k = 0; k < n; ++k) {
+            const dspirit_parts p = values[k];
+            full[k] = p.r;
+            full[n + k] = p.i;
+            full[2 * n + k] = p.j;
+            full[3 * n + k] = p.level;
+        }
+        r = full.data();
+        i = r + n;
+        j = r + 2 * n;
+        level = r + 3 * n;
+    }
+
+    const bool entropy = opts.shuffle && opts.entropy;
+    std::uint32_t flags = 0;
+    if (opts.shuffle) flags |= CHUNK_SHUFFLE;
+    if (entropy) flags |= CHUNK_ENTROPY;
+
+    out.clear();
+    out.reserve(CHUNK_HEADER_BYTES + 8 * n + 64);
+    out.resize(CHUNK_HEADER_BYTES);
+    sink s = {out};
+
+    // r
+    if (opts.shuffle) {
+        std::vector<unsigned char> plane(n);
+        for (unsigned b = 0; b < 8; ++b) {
+            for (std::size_t k = 0; k < n; ++k) plane[k] = static_cast<unsigned char>(bitsOf(r[k]) >> (8 * b));
+            encodePlane(plane.data(), n, entropy, s);
+        }
+    } else {
+        detail::storeDoubles(s.grow(8 * n), r, n);
+    }
+    const std::size_t rBytes = out.size() - CHUNK_HEADER_BYTES;
+
+    encodeLevels(level, n, s);
+    const std::size_t levelBytes = out.size() - CHUNK_HEADER_BYTES - rBytes;
+
+    encodeSparse(i, n, sparseCount(i, n), s);
+    encodeSparse(j, n, sparseCount(j, n), s);
+    const std::size_t sparse = out.size() - CHUNK_HEADER_BYTES - rBytes - levelBytes;
+
+    unsigned char* header = out.data();
+    storeU32(header, static_cast<std::uint32_t>(n));
+    storeU32(header + 4, flags);
+    storeU32(header + 8, static_cast<std::uint32_t>(rBytes));
+    storeU32(header + 12, static_cast<std::uint32_t>(levelBytes));
+    storeU32(header + 16, static_cast<std::uint32_t>(sparse));
+    storeU32(header + 20, binary::checksum(header + CHUNK_HEADER_BYTES, out.size() - CHUNK_HEADER_BYTES));
+}
+
+} // namespace
+
+compressed_array::compressed_array(const_dspirit_view values, const codec::options& opts)
+    : size_(values.size), chunkValues_(opts.chunkValues) {
+    if (chunkValues_ == 0 || chunkValues_ > codec::MAX_CHUNK_VALUES) {
+        detail::raise(status::invalid_argument, "compressed_array: bad chunk size");
+    }
+    const std::size_t chunks = (size_ + chunkValues_ - 1) / chunkValues_;
+
+    std::vector<std::vector<unsigned char>> encoded(chunks);
+    detail::parallelFor(chunks, opts.threads, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            const std::size_t first = c * chunkValues_;
+            const std::size_t n = std::min(chunkValues_, size_ - first);
+            const_dspirit_view part = values;
+            part.r += first;
+            if (part.i) part.i += first;
+            if (part.j) part.j += first;
+            if (part.level) part.level += first;
+            part.size = n;
+            encodeChunk(part, opts, encoded[c]);
+        }
+    });
+
+    std::size_t total = HEADER_BYTES;
+    for (const std::vector<unsigned char>& chunk : encoded) total += chunk.size();
+    bytes_.resize(HEADER_BYTES);
+    bytes_.reserve(total);
+    std::memcpy(bytes_.data(), MAGIC, 4);
+    storeU16(&bytes_[4], codec::VERSION);
+    storeU16(&bytes_[6], 0);
+    storeU32(&bytes_[8], static_cast<std::uint32_t>(chunkValues_));
+    storeU32(&bytes_[12], static_cast<std::uint32_t>(chunks));
+    storeU64(&bytes_[16], size_);
+
+    offsets_.reserve(chunks + 1);
+    for (const std::vector<unsigned char>& chunk : encoded) {
+        offsets_.push_back(bytes_.size());
+        bytes_.insert(bytes_.end(), chunk.begin(), chunk.end());
+    }
+    offsets_.push_back(bytes_.size());
+}
+
+compressed_array compressed_array::fromBytes(std::vector<unsigned char> bytes) {
+    compressed_array result;
+    if (bytes.size() < HEADER_BYTES || std::memcmp(bytes.data(), MAGIC, 4) != 0) {
+        raiseCorrupt("compressed_array: not a paradox compressed stream");
+    }
+    if (loadU16(&bytes[4]) != codec::VERSION) raiseCorrupt("compressed_array: unsupported format version");
+    if (loadU16(&bytes[6]) != 0) raiseCorrupt("compressed_array: unsupported format flags");
+
+    const std::size_t chunkValues = loadU32(&bytes[8]);
+    const std::size_t chunks = loadU32(&bytes[12]);
+    const std::uint64_t size = loadU64(&bytes[16]);
+    if (chunkValues == 0 || chunkValues > codec::MAX_CHUNK_VALUES) raiseCorrupt("compressed_array: bad chunk size");
+    if ((size + chunkValues - 1) / chunkValues != chunks) raiseCorrupt("compressed_array: bad chunk count");
+
+    // Обход заголовков порций без распаковки
+    std::size_t at = HEADER_BYTES;
+    result.offsets_.reserve(chunks + 1);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        if (bytes.size() - at < CHUNK_HEADER_BYTES) raiseCorrupt("compressed_array: truncated stream");
+        const std::size_t n = loadU32(&bytes[at]);
+        if (n != std::min<std::uint64_t>(chunkValues, size - c * chunkValues)) raiseCorrupt("compressed_array: bad chunk header");
+        const std::uint64_t payload = std::uint64_t(loadU32(&bytes[at + 8])) + loadU32(&bytes[at + 12]) + loadU32(&bytes[at + 16]);
+        if (payload > bytes.size() - at - CHUNK_HEADER_BYTES) raiseCorrupt("compressed_array: truncated stream");
+        result.offsets_.push_back(at);
+        at += CHUNK_HEADER_BYTES + static_cast<std::size_t>(payload);
+    }
+    if (at != bytes.size()) raiseCorrupt("compressed_array: trailing data");
+    result.offsets_.push_back(at);
+
+    result.bytes_ = std::move(bytes);
+    result.size_ = static_cast<std::size_t>(size);
+    result.chunkValues_ = chunkValues;
+    return result;
+}
+
+void compressed_array::decodeChunk(std::size_t chunk, dspirit_view out) const {
+    if (chunk >= chunkCount()) detail::raise(status::invalid_argument, "compressed_array: chunk out of range");
+    const unsigned char* header = bytes_.data() + offsets_[chunk];
+    const unsigned char* end = bytes_.data() + offsets_[chunk + 1];
+    const std::size_t n = loadU32(header);
+    if (out.size != n) detail::raise(status::size_mismatch, "compressed_array: size mismatch");
+
+    const std::uint32_t flags = loadU32(header + 4);
+    const std::size_t rBytes = loadU32(header + 8);
+    const std::size_t levelBytes = loadU32(header + 12);
+    const unsigned char* payload = header + CHUNK_HEADER_BYTES;
+    if (binary::checksum(payload, static_cast<std::size_t>(end - payload)) != loadU32(header + 20)) {
+        raiseCorrupt("compressed_array: checksum mismatch");
+    }
+
+    // r
+    source in = {payload, payload + rBytes};
+    if (flags & CHUNK_SHUFFLE) {
+        std::vector<unsigned char> scratch(8 * n);
+        const unsigned char* planes[8];
+        for (unsigned b = 0; b < 8; ++b) planes[b] = decodePlane(in, n, scratch.data() + b * n);
+        // Сборка 64-битных слов из плоскостей: независимые полосы, векторизуется
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::uint64_t bits =
+                std::uint64_t(planes[0][k]) | std::uint64_t(planes[1][k]) << 8 |
+                std::uint64_t(planes[2][k]) << 16 | std::uint64_t(planes[3][k]) << 24 |
+                std::uint64_t(planes[4][k]) << 32 | std::uint64_t(planes[5][k]) << 40 |
+                std::uint64_t(planes[6][k]) << 48 | std::uint64_t(planes[7][k]) << 56;
+            std::memcpy(&out.r[k], &bits, 8);
+        }
+    } else {
+        detail::loadDoubles(out.r, in.take(8 * n), n);
+    }
+    if (in.p != in.end) raiseCorrupt("compressed_array: bad r section");
+
+    // level
+    in = {payload + rBytes, payload + rBytes + levelBytes};
+    decodeLevels(in, out.level, n);
+    if (in.p != in.end) raiseCorrupt("compressed_array: bad level section");
+
+    // i, j
+    in = {payload + rBytes + levelBytes, end};
+    std::fill(out.i, out.i + n, 0.0);
+    std::fill(out.j, out.j + n, 0.0);
+    decodeSparse(in, out.i, n);
+    decodeSparse(in, out.j, n);
+    if (in.p != in.end) raiseCorrupt("compressed_array: bad i/j section");
+}
+
+void compressed_array::decode(dspirit_view out, unsigned threads) const {
+    if (out.size != size_) detail::raise(status::size_mismatch, "compressed_array: size mismatch");
+    detail::parallelFor(chunkCount(), threads, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            const std::size_t first = c * chunkValues_;
+            const std::size_t n = std::min(chunkValues_, size_ - first);
+            decodeChunk(c, dspirit_view{out.r + first, out.i + first, out.j + first, out.level + first, n});
+        }
+    });
+}
+
+dspirit_array compressed_array::toArray(unsigned threads) const {
+    dspirit_array result(size_);
+    decode(result.view(), threads);
+    return result;
+}
+
+} // namespace paradox
@@ -0,0 +1,267 @@
+#include "paradox/columnar.h"
+#include "paradox/binary.h"
+#include "paradox/status.h"
+#include "byte_order.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace paradox {
+
+using detail::loadU16;
+using detail::loadU32;
+using detail::loadU64;
+using detail::storeU16;
+using detail::storeU32;
+using detail::storeU64;
+
+namespace {
+
+const unsigned char FILE_MAGIC[4] = {'P', 'D', 'X', 'C'};
+const unsigned char COLUMN_MAGIC[4] = {'P', 'D', 'X', 'K'};
+const std::size_t TABLE_OFFSET = 24;
+const std::size_t CHUNK_VALUES = 1024;
+
+std::uint64_t pageRound(std::uint64_t bytes) {
+    return (bytes + columnar::PAGE_BYTES - 1) / columnar::PAGE_BYTES * columnar::PAGE_BYTES;
+}
+
+} // namespace
+
+// Запись
+
+columnar_writer::columnar_writer(const std::string& path, std::size_t size, bool plain)
+    : out_(path, std::ios::binary | std::ios::trunc), size_(size), count_(0),
+      columns_(plain ? 1 : 4), data_(), finished_(false) {
+    if (!out_) detail::raise(status::io_error, "columnar_writer: cannot open file");
+
+    std::vector<unsigned char> page(columnar::PAGE_BYTES, 0);
+    std::memcpy(page.data(), FILE_MAGIC, 4);
+    storeU16(&page[4], columnar::VERSION);
+    storeU16(&page[6], 0);
+    storeU32(&page[8], static_cast<std::uint32_t>(columnar::PAGE_BYTES));
+    storeU32(&page[12], static_cast<std::uint32_t>(columns_));
+    storeU64(&page[16], size_);
+
+    // Страница заголовка столбца, за ней данные до границы страницы
+    std::uint64_t header[4];
+    std::uint64_t offset = columnar::PAGE_BYTES;
+    for (std::size_t c = 0; c < columns_; ++c) {
+        header[c] = offset;
+        data_[c] = offset + columnar::PAGE_BYTES;
+        offset = data_[c] + pageRound(static_cast<std::uint64_t>(size_) * sizeof(double));
+        storeU64(&page[TABLE_OFFSET + 8 * c], header[c]);
+    }
+    out_.write(reinterpret_cast<const char*>(page.data()), static_cast<std::streamsize>(page.size()));
+
+    for (std::size_t c = 0; c < columns_; ++c) {
+        std::fill(page.begin(), page.end(), 0);
+        std::memcpy(page.data(), COLUMN_MAGIC, 4);
+        storeU32(&page[4], static_cast<std::uint32_t>(c));
+        storeU64(&page[8], size_);
+        storeU64(&page[16], data_[c]);
+        out_.seekp(static_cast<std::streamoff>(header[c]));
+        out_.write(reinterpret_cast<const char*>(page.data()), static_cast<std::streamsize>(page.size()));
+    }
+    if (!out_) detail::raise(status::io_error, "columnar_writer: write failed");
+}
+
+columnar_writer::~columnar_writer() {
+    if (!finished_) out_.close();
+}
+
+void columnar_writer::write(const_dspirit_view values) {
+    if (finished_) detail::raise(status::invalid_argument, "columnar_writer: file already finished");
+    if (values.size > size_ - count_) detail::raise(status::invalid_argument, "columnar_writer: more values than declared");
+
+    const bool direct = (columns_ == 1) ? values.isPlain() : (values.i && values.j && values.level);
+    if (direct) {
+        writeColumn(0, values.r, values.size);
+        if (columns_ == 4) {
+            writeColumn(1, values.i, values.size);
+            writeColumn(2, values.j, values.size);
+            writeColumn(3, values.level, values.size);
+        }
+        count_ += values.size;
+        return;
+    }
+
+    // Неполное представление: преобразование порциями через буфер
+    double buffer[4][CHUNK_VALUES];
+    for (std::size_t k = 0; k < values.size; k += CHUNK_VALUES) {
+        const std::size_t n = std::min(CHUNK_VALUES, values.size - k);
+        for (std::size_t m = 0; m < n; ++m) {
+            const dspirit_parts p = values[k + m];
+            if (columns_ == 1) {
+                if (!binary::isPlain(p)) detail::raise(status::invalid_argument, "columnar_writer: value needs full columns");
+                buffer[0][m] = (p.level == 0.0) ? p.r : 0.0;
+            } else {
+                buffer[0][m] = p.r;
+                buffer[1][m] = p.i;
+                buffer[2][m] = p.j;
+                buffer[3][m] = p.level;
+            }
+        }
+        for (std::size_t c = 0; c < columns_; ++c) writeColumn(c, buffer[c], n);
+        count_ += n;
+    }
+}
+
+void columnar_writer::writeColumn(std::size_t c, const double* values, std::size_t n) {
+    out_.seekp(static_cast<std::streamoff>(data_[c] + static_cast<std::uint64_t>(count_) * sizeof(double)));
+    if (detail::HOST_LITTLE_ENDIAN) {
+        out_.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n * sizeof(double)));
+    } else {
+        unsigned char bytes[CHUNK_VALUES * sizeof(double)];
+        for (std::size_t k = 0; k < n; k += CHUNK_VALUES) {
+            const std::size_t m = std::min(CHUNK_VALUES, n - k);
+            detail::storeDoubles(bytes, values + k, m);
+            out_.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(m * sizeof(double)));
+        }
+    }
+    if (!out_) detail::raise(status::io_error, "columnar_writer: write failed");
+}
+
+void columnar_writer::finish() {
+    if (finished_) return;
+    if (count_ != size_) detail::raise(status::invalid_argument, "columnar_writer: fewer values than declared");
+    finished_ = true;
+    out_.close();
+    if (!out_) detail::raise(status::io_error, "columnar_writer: write failed");
+}
+
+void writeColumnar(const std::string& path, const_dspirit_view values) {
+    columnar_writer writer(path, values.size, values.isPlain());
+    writer.write(values);
+    writer.finish();
+}
+
+// Чтение
+
+columnar_file::columnar_file(const std::string& path) {
+    detail::file_mapping mapping;
+    if (detail::mapFile(path, mapping) != status::ok) detail::raise(status::io_error, "columnar_file: cannot map file");
+    data_ = mapping.data;
+    bytes_ = mapping.bytes;
+    mapping_ = mapping.handle;
+    if (bytes_ < columnar::PAGE_BYTES) {
+        close();
+        detail::raise(status::corrupt_data, "columnar_file: file too small");
+    }
+
+    // Проверяются только страницы заголовков
+    const char* error = nullptr;
+    const unsigned char* header = data_;
+    const std::size_t columns = loadU32(header + 12);
+    size_ = static_cast<std::size_t>(loadU64(header + 16));
+    const double* planes[4] = {nullptr, nullptr, nullptr, nullptr};
+
+    if (std::memcmp(header, FILE_MAGIC, 4) != 0) error = "columnar_file: not a paradox columnar file";
+    else if (loadU16(header + 4) != columnar::VERSION) error = "columnar_file: unsupported format version";
+    else if (loadU16(header + 6) != 0) error = "columnar_file: unsupported format flags";
+    else if (loadU32(header + 8) != columnar::PAGE_BYTES) error = "columnar_file: unsupported page size";
+    else if (columns != 1 && columns != 4) error = "columnar_file: bad column count";
+    else if (size_ > bytes_ / sizeof(double)) error = "columnar_file: truncated file";
+
+    for (std::size_t c = 0; !error && c < columns; ++c) {
+        const std::uint64_t at = loadU64(header + TABLE_OFFSET + 8 * c);
+        if (at % columnar::PAGE_BYTES != 0 || at > bytes_ - columnar::PAGE_BYTES) {
+            error = "columnar_file: bad column offset";
+            break;
+        }
+        const unsigned char* chunk = data_ + at;
+        const std::uint64_t offset = loadU64(chunk + 16);
+        if (std::memcmp(chunk, COLUMN_MAGIC, 4) != 0 || loadU32(chunk + 4) != c || loadU64(chunk + 8) != size_) {
+            error = "columnar_file: bad column header";
+        } else if (offset % columnar::PAGE_BYTES != 0 || offset > bytes_ ||
+                   size_ > (bytes_ - offset) / sizeof(double)) {
+            error = "columnar_file: truncated file";
+        } else {
+            planes[c] = reinterpret_cast<const double*>(data_ + offset);
+        }
+    }
+    if (error) {
+        close();
+        detail::raise(status::corrupt_data, error);
+    }
+
+    // На big-endian платформах отображение использовать напрямую нельзя
+    if (!detail::HOST_LITTLE_ENDIAN) {
+        swapped_ = new double[columns * size_];
+        for (std::size_t c = 0; c < columns; ++c) {
+            detail::loadDoubles(swapped_ + c * size_, reinterpret_cast<const unsigned char*>(planes[c]), size_);
+            planes[c] = swapped_ + c * size_;
+        }
+    }
+    view_ = {planes[0], planes[1], planes[2], planes[3], size_};
+}
+
+columnar_file::~columnar_file() {
+    close();
+}
+
+columnar_file::columnar_file(columnar_file&& other) noexcept
+    : data_(other.data_), bytes_(other.bytes_), size_(other.size_), view_(other.view_), swapped_(other.swapped_) {
+    mapping_ = other.mapping_;
+    other.mapping_ = nullptr;
+    other.data_ = nullptr;
+    other.swapped_ = nullptr;
+    other.bytes_ = other.size_ = 0;
+    other.view_ = const_dspirit_view();
+}
+
+columnar_file& columnar_file::operator=(columnar_file&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = other.data_;
+        bytes_ = other.bytes_;
+        size_ = other.size_;
+        view_ = other.view_;
+        swapped_ = other.swapped_;
+        mapping_ = other.mapping_;
+        other.mapping_ = nullptr;
+        other.data_ = nullptr;
+        other.swapped_ = nullptr;
+        other.bytes_ = other.size_ = 0;
+        other.view_ = const_dspirit_view();
+    }
+    return *this;
+}
+
+void columnar_file::close() {
+    delete[] swapped_;
+    swapped_ = nullptr;
+    detail::file_mapping mapping;
+    mapping.data = data_;
+    mapping.bytes = bytes_;
+    mapping.handle = mapping_;
+    detail::unmapFile(mapping);
+    data_ = nullptr;
+    mapping_ = nullptr;
+    bytes_ = size_ = 0;
+    view_ = const_dspirit_view();
+}
+
+const_dspirit_view columnar_file::slice(std::size_t offset, std::size_t n) const {
+    if (offset > size_ || n > size_ - offset) detail::raise(status::invalid_argument, "columnar_file: slice out of range");
+    const_dspirit_view result = view_;
+    result.r += offset;
+    if (result.i) result.i += offset;
+    if (result.j) result.j += offset;
+    if (result.level) result.level += offset;
+    result.size = n;
+    return result;
+}
+
+void columnar_file::prefetch(std::size_t offset, std::size_t n) const {
+    const const_dspirit_view part = slice(offset, n);
+    if (swapped_) return;
+    const double* planes[4] = {part.r, part.i, part.j, part.level};
+    for (const double* plane : planes) {
+        if (plane) detail::adviseWillNeed(plane, part.size * sizeof(double));
+    }
+}
+
+} // namespace paradox
@@ -0,0 +1,144 @@
+#include "paradox/compact.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace paradox {
+
+static_assert(alignof(compact_dspirit) == 16, "compact_dspirit must be 16-byte aligned");
+static_assert(std::is_trivially_copyable<compact_dspirit>::value, "compact_dspirit must be trivially copyable");
+
+namespace {
+
+const dspirit_parts FAILED = {std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0};
+
+// Поддиапазон float (приведение double вне него - неопределённое поведение)
+bool fitsFloat(double value) {
+    return !(std::abs(value) > FLT_MAX);
+}
+
+std::uint32_t floatBits(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+float floatFromBits(std::uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof value);
+    return value;
+}
+
+// double -> bfloat16 с округлением к ближайшему чётному. Промежуточный
+// float может сам оказаться точной серединой; тогда направление решает
+// исходное значение. false - переполнение до бесконечности.
+bool toBfloat16(double value, std::uint16_t& out) {
+    const float f = static_cast<float>(value);
+    const std::uint32_t bits = floatBits(f);
+    const std::uint32_t high = bits >> 16;
+    const std::uint32_t low = bits & 0xFFFFu;
+
+    if (std::isnan(f)) {
+        out = static_cast<std::uint16_t>(high | 0x40u);  // тихий NaN
+        return true;
+    }
+
+    bool up;
+    if (low != 0x8000u) up = low > 0x8000u;
+    else if (static_cast<double>(f) != value) up = std::abs(value) > std::abs(static_cast<double>(f));
+    else up = (high & 1u) != 0;
+
+    const std::uint32_t rounded = high + (up ? 1u : 0u);
+    if ((rounded & 0x7FFFu) == 0x7F80u && !std::isinf(f)) return false;
+    out = static_cast<std::uint16_t>(rounded);
+    return true;
+}
+
+double fromBfloat16(std::uint16_t value) {
+    return static_cast<double>(floatFromBits(static_cast<std::uint32_t>(value) << 16));
+}
+
+bool packLevel(double level, std::int16_t& out) {
+    if (level == std::numeric_limits<double>::infinity()) {
+        out = compact_dspirit::LEVEL_SUPER_INF;
+        return true;
+    }
+    if (level == -std::numeric_limits<double>::infinity()) {
+        out = compact_dspirit::LEVEL_SUPER_ZERO;
+        return true;
+    }
+    const double scaled = level * compact_dspirit::LEVEL_SCALE;
+    if (!(scaled >= compact_dspirit::LEVEL_SUPER_ZERO + 1 && scaled <= compact_dspirit::LEVEL_SUPER_INF - 1)) return false;
+    if (scaled != std::floor(scaled)) return false;
+    out = static_cast<std::int16_t>(scaled);
+    return true;
+}
+
+double unpackLevel(std::int16_t level) {
+    if (level == compact_dspirit::LEVEL_SUPER_INF) return std::numeric_limits<double>::infinity();
+    if (level == compact_dspirit::LEVEL_SUPER_ZERO) return -std::numeric_limits<double>::infinity();
+    return static_cast<double>(level) / compact_dspirit::LEVEL_SCALE;
+}
+
+} // namespace
+
+status compact_dspirit::fromParts(const dspirit_parts& value, compact_dspirit& out) noexcept {
+    compact_dspirit result;
+    if (!fitsFloat(value.i) || !fitsFloat(value.j)) return status::invalid_argument;
+    if (!packLevel(value.level, result.level)) return status::invalid_argument;
+    if (!toBfloat16(value.j, result.j)) return status::invalid_argument;
+    result.r = value.r;
+    result.i = static_cast<float>(value.i);
+    out = result;
+    return status::ok;
+}
+
+compact_dspirit compact_dspirit::fromParts(const dspirit_parts& value) {
+    compact_dspirit result;
+    if (fromParts(value, result) != status::ok) {
+        detail::raise(status::invalid_argument, "compact_dspirit: value out of compact range");
+    }
+    return result;
+}
+
+compact_dspirit compact_dspirit::fromDspirit(const dspirit& value) {
+    return fromParts(value.toParts());
+}
+
+dspirit_parts compact_dspirit::toParts() const noexcept {
+    return {r, static_cast<double>(i), fromBfloat16(j), unpackLevel(level)};
+}
+
+dspirit compact_dspirit::toDspirit() const {
+    return dspirit::fromParts(toParts());
+}
+
+namespace batch {
+
+std::size_t pack(const_dspirit_view x, compact_dspirit* out, std::uint64_t* failed) {
+    if (failed) std::fill(failed, failed + statusWords(x.size), std::uint64_t(0));
+    compact_dspirit nan;
+    compact_dspirit::fromParts(FAILED, nan);
+
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < x.size; ++k) {
+        if (compact_dspirit::fromParts(x[k], out[k]) != status::ok) {
+            out[k] = nan;
+            ++count;
+            if (failed) failed[k / 64] |= std::uint64_t(1) << (k % 64);
+        }
+    }
+    return count;
+}
+
+void unpack(const compact_dspirit* x, dspirit_view out) {
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, x[k].toParts());
+}
+
+} // namespace batch
+
+} // namespace paradox
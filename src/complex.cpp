@@ -0,0 +1,283 @@
+#include "paradox/complex.h"
+#include "dspirit_impl.h"
+
+#include <cmath>
+#include <ostream>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+struct complex_impl {
+    Impl re;
+    Impl im;
+};
+
+complex_impl wrap(const complex_dspirit& z) {
+    return {Impl::fromParts(z.re), Impl::fromParts(z.im)};
+}
+
+complex_dspirit unwrap(const complex_impl& z) {
+    return complex_dspirit::fromParts(z.re.parts(), z.im.parts());
+}
+
+Impl absImpl(const Impl& x) {
+    return x.isNegative() ? x.negate() : x;
+}
+
+bool isPlainParts(const dspirit_parts& x) {
+    return x.level == 0.0 && x.i == 0.0 && x.j == 0.0 && Impl::isPlainValue(x.r);
+}
+
+// Все части - обычные double: арифметика без Impl. Порядок операций тот
+// же, что в Impl, поэтому результат совпадает побитно; false - результат
+// или промежуточная сумма не обычные (сокращение, переполнение), нужен
+// общий путь
+bool multiplyPlain(const complex_dspirit& x, const complex_dspirit& y, complex_dspirit& out) {
+    if (!isPlainParts(x.re) || !isPlainParts(x.im) || !isPlainParts(y.re) || !isPlainParts(y.im)) return false;
+    const double a = x.re.r, b = x.im.r, c = y.re.r, d = y.im.r;
+    const double ab = a + b, dc = d - c, cd = c + d;
+    if (!Impl::isPlainValue(ab) || !Impl::isPlainValue(dc) || !Impl::isPlainValue(cd)) return false;
+    const double k1 = c * ab, k2 = a * dc, k3 = b * cd;
+    if (!Impl::isPlainValue(k1) || !Impl::isPlainValue(k2) || !Impl::isPlainValue(k3)) return false;
+    const double re = k1 - k3;
+    const double im = k1 + k2;
+    if (!Impl::isPlainValue(re) || !Impl::isPlainValue(im)) return false;
+    out.re = {re, 0.0, 0.0, 0.0};
+    out.im = {im, 0.0, 0.0, 0.0};
+    return true;
+}
+
+bool dividePlain(const complex_dspirit& x, const complex_dspirit& y, complex_dspirit& out) {
+    if (!isPlainParts(x.re) || !isPlainParts(x.im) || !isPlainParts(y.re) || !isPlainParts(y.im)) return false;
+    const double a = x.re.r, b = x.im.r, c = y.re.r, d = y.im.r;
+    double ratio, den, re, im;
+    if (!(std::abs(c) < std::abs(d))) {
+        ratio = d / c;
+        den = c + d * ratio;
+        re = (a + b * ratio) / den;
+        im = (b - a * ratio) / den;
+    } else {
+        ratio = c / d;
+        den = c * ratio + d;
+        re = (a * ratio + b) / den;
+        im = (b * ratio - a) / den;
+    }
+    if (!Impl::isPlainValue(ratio) || !Impl::isPlainValue(den)) return false;
+    if (!Impl::isPlainValue(re) || !Impl::isPlainValue(im)) return false;
+    out.re = {re, 0.0, 0.0, 0.0};
+    out.im = {im, 0.0, 0.0, 0.0};
+    return true;
+}
+
+// (ac - bd) + (ad + bc)i
+complex_impl multiplyImpl(const complex_impl& x, const complex_impl& y) {
+    const Impl& a = x.re;
+    const Impl& b = x.im;
+    const Impl& c = y.re;
+    const Impl& d = y.im;
+    return {a.multiply(c).subtract(b.multiply(d)), a.multiply(d).add(b.multiply(c))};
+}
+
+// Обе части на одном обычном уровне: a + b не теряет младшую часть
+bool sameLevelParts(const Impl& a, const Impl& b) {
+    if (Impl::isSuperLevel(a.level()) || Impl::isSuperLevel(b.level())) return false;
+    return a.isApproxEqualLevel(a.level(), b.level());
+}
+
+complex_impl multiplyGaussImpl(const complex_impl& x, const complex_impl& y) {
+    const Impl& a = x.re;
+    const Impl& b = x.im;
+    const Impl& c = y.re;
+    const Impl& d = y.im;
+
+    // Части разных уровней - обычная формула
+    if (!sameLevelParts(a, b) || !sameLevelParts(c, d)) return multiplyImpl(x, y);
+
+    // k1 = c(a + b), k2 = a(d - c), k3 = b(c + d)
+    const Impl k1 = c.multiply(a.add(b));
+    const Impl k2 = a.multiply(d.subtract(c));
+    const Impl k3 = b.multiply(c.add(d));
+    return {k1.subtract(k3), k1.add(k2)};
+}
+
+complex_impl divideImpl(const complex_impl& x, const complex_impl& y) {
+    const Impl& a = x.re;
+    const Impl& b = x.im;
+    const Impl& c = y.re;
+    const Impl& d = y.im;
+
+    // Смит: делим на большую по модулю часть знаменателя
+    if (!absImpl(c).lessThan(absImpl(d))) {
+        const Impl ratio = d.divide(c);
+        const Impl den = c.add(d.multiply(ratio));
+        return {a.add(b.multiply(ratio)).divide(den), b.subtract(a.multiply(ratio)).divide(den)};
+    }
+    const Impl ratio = c.divide(d);
+    const Impl den = c.multiply(ratio).add(d);
+    return {a.multiply(ratio).add(b).divide(den), b.multiply(ratio).subtract(a).divide(den)};
+}
+
+void checkSize(std::size_t a, std::size_t b) {
+    if (a != b) {
+        detail::raise(status::size_mismatch, "complex_array: size mismatch");
+    }
+}
+
+void checkSizes(const_complex_view x, complex_view out) {
+    checkSize(x.re.size, out.re.size);
+    checkSize(x.im.size, out.re.size);
+    checkSize(out.im.size, out.re.size);
+}
+
+template <class Op>
+void apply(const_complex_view a, const_complex_view b, complex_view out, Op op) {
+    checkSizes(a, out);
+    checkSizes(b, out);
+    for (std::size_t k = 0; k < out.size(); ++k) out.store(k, op(a[k], b[k]));
+}
+
+} // namespace
+
+complex_dspirit::complex_dspirit(double re)
+    : re(Impl(re).parts()), im(dspirit::SUPER_ZERO.toParts()) {}
+
+complex_dspirit::complex_dspirit(double re, double im)
+    : re(Impl(re).parts()), im(Impl(im).parts()) {}
+
+complex_dspirit::complex_dspirit(const dspirit& re, const dspirit& im)
+    : re(re.toParts()), im(im.toParts()) {}
+
+complex_dspirit complex_dspirit::fromParts(const dspirit_parts& re, const dspirit_parts& im) {
+    complex_dspirit result;
+    result.re = re;
+    result.im = im;
+    return result;
+}
+
+complex_dspirit operator-(const complex_dspirit& z) {
+    const complex_impl x = wrap(z);
+    return unwrap({x.re.negate(), x.im.negate()});
+}
+
+complex_dspirit operator+(const complex_dspirit& a, const complex_dspirit& b) {
+    const complex_impl x = wrap(a);
+    const complex_impl y = wrap(b);
+    return unwrap({x.re.add(y.re), x.im.add(y.im)});
+}
+
+complex_dspirit operator-(const complex_dspirit& a, const complex_dspirit& b) {
+    const complex_impl x = wrap(a);
+    const complex_impl y = wrap(b);
+    return unwrap({x.re.subtract(y.re), x.im.subtract(y.im)});
+}
+
+complex_dspirit operator*(const complex_dspirit& a, const complex_dspirit& b) {
+    complex_dspirit result;
+    if (multiplyPlain(a, b, result)) return result;
+    return unwrap(multiplyGaussImpl(wrap(a), wrap(b)));
+}
+
+complex_dspirit operator/(const complex_dspirit& a, const complex_dspirit& b) {
+    complex_dspirit result;
+    if (dividePlain(a, b, result)) return result;
+    return unwrap(divideImpl(wrap(a), wrap(b)));
+}
+
+bool operator==(const complex_dspirit& a, const complex_dspirit& b) {
+    const complex_impl x = wrap(a);
+    const complex_impl y = wrap(b);
+    return x.re.equals(y.re) && x.im.equals(y.im);
+}
+
+bool operator!=(const complex_dspirit& a, const complex_dspirit& b) {
+    return !(a == b);
+}
+
+complex_dspirit conj(const complex_dspirit& z) {
+    return complex_dspirit::fromParts(z.re, Impl::fromParts(z.im).negate().parts());
+}
+
+dspirit norm(const complex_dspirit& z) {
+    const complex_impl x = wrap(z);
+    return dspirit::fromParts(x.re.multiply(x.re).add(x.im.multiply(x.im)).parts());
+}
+
+dspirit abs(const complex_dspirit& z) {
+    return dspirit::fromParts(kernel::hypot(z.re, z.im));
+}
+
+dspirit arg(const complex_dspirit& z) {
+    return dspirit::fromParts(kernel::atan2(z.im, z.re));
+}
+
+std::ostream& operator<<(std::ostream& os, const complex_dspirit& z) {
+    return os << '(' << z.real() << ',' << z.imag() << ')';
+}
+
+// complex_array
+
+complex_array::complex_array(std::size_t n, const complex_dspirit& value)
+    : re_(n, value.real()), im_(n, value.imag()) {}
+
+void complex_array::resize(std::size_t n, const complex_dspirit& value) {
+    re_.resize(n, value.real());
+    im_.resize(n, value.imag());
+}
+
+void complex_array::set(std::size_t k, const complex_dspirit& value) {
+    re_.set(k, value.re);
+    im_.set(k, value.im);
+}
+
+namespace batch {
+
+void negate(const_complex_view x, complex_view out) {
+    checkSizes(x, out);
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        out.re.store(k, Impl::fromParts(x.re[k]).negate().parts());
+        out.im.store(k, Impl::fromParts(x.im[k]).negate().parts());
+    }
+}
+
+void add(const_complex_view a, const_complex_view b, complex_view out) {
+    apply(a, b, out, [](const complex_dspirit& x, const complex_dspirit& y) { return x + y; });
+}
+
+void subtract(const_complex_view a, const_complex_view b, complex_view out) {
+    apply(a, b, out, [](const complex_dspirit& x, const complex_dspirit& y) { return x - y; });
+}
+
+void multiply(const_complex_view a, const_complex_view b, complex_view out) {
+    apply(a, b, out, [](const complex_dspirit& x, const complex_dspirit& y) { return x * y; });
+}
+
+void divide(const_complex_view a, const_complex_view b, complex_view out) {
+    apply(a, b, out, [](const complex_dspirit& x, const complex_dspirit& y) { return x / y; });
+}
+
+void conj(const_complex_view x, complex_view out) {
+    checkSizes(x, out);
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        out.re.store(k, x.re[k]);
+        out.im.store(k, Impl::fromParts(x.im[k]).negate().parts());
+    }
+}
+
+void abs(const_complex_view x, dspirit_view out) {
+    checkSize(x.re.size, out.size);
+    checkSize(x.im.size, out.size);
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, kernel::hypot(x.re[k], x.im[k]));
+}
+
+void arg(const_complex_view x, dspirit_view out) {
+    checkSize(x.re.size, out.size);
+    checkSize(x.im.size, out.size);
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, kernel::atan2(x.im[k], x.re[k]));
+}
+
+} // namespace batch
+
+} // namespace paradox
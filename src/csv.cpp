@@ -0,0 +1,228 @@
+#include "paradox/csv.h"
+#include "dspirit_impl.h"
+#include "mapped_file.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+// Куски меньше этого размера не делятся между потоками
+const std::size_t MIN_PIECE_BYTES = 1 << 20;
+
+const dspirit_parts FAILED = {std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0};
+
+// Конец строки без '\n'
+const char* lineEnd(const char* first, const char* last) {
+    const void* found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+    return found ? static_cast<const char*>(found) : last;
+}
+
+// Начало следующей строки
+const char* nextLine(const char* end, const char* last) {
+    return end == last ? last : end + 1;
+}
+
+// Строка без '\r' в конце
+const char* trimCr(const char* first, const char* end) {
+    return (end != first && end[-1] == '\r') ? end - 1 : end;
+}
+
+bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+bool isBlank(const char* first, const char* end) {
+    for (const char* p = first; p != end; ++p) {
+        if (!isSpace(*p)) return false;
+    }
+    return true;
+}
+
+void trim(const char*& first, const char*& end) {
+    while (first != end && isSpace(*first)) ++first;
+    while (end != first && isSpace(end[-1])) --end;
+}
+
+// Поле строки, начиная с p. Значение в кавычках "..." может содержать
+// разделитель (например (1,2,3)@1); после закрывающей кавычки допустимы
+// только пробелы.
+struct field {
+    const char* first;  // значение без пробелов и кавычек
+    const char* last;
+    const char* end;    // разделитель или конец строки
+    bool ok;
+};
+
+field splitField(const char* p, const char* end, char delimiter) {
+    field f = {p, end, end, true};
+    while (f.first != end && isSpace(*f.first)) ++f.first;
+    const char* from = p;
+    if (f.first != end && *f.first == '"') {
+        const void* close = std::memchr(f.first + 1, '"', static_cast<std::size_t>(end - f.first - 1));
+        if (close) {
+            ++f.first;
+            f.last = static_cast<const char*>(close);
+            from = f.last + 1;
+        }
+    }
+    const void* found = std::memchr(from, delimiter, static_cast<std::size_t>(end - from));
+    f.end = found ? static_cast<const char*>(found) : end;
+    if (from != p) f.ok = isBlank(from, f.end);
+    else f.last = f.end;
+    trim(f.first, f.last);
+    return f;
+}
+
+// Непустые строки куска
+std::size_t countRows(const char* first, const char* last) {
+    std::size_t rows = 0;
+    while (first < last) {
+        const char* end = lineEnd(first, last);
+        if (!isBlank(first, trimCr(first, end))) ++rows;
+        first = nextLine(end, last);
+    }
+    return rows;
+}
+
+struct piece_errors {
+    std::vector<csv_error> list;
+    std::size_t count = 0;
+};
+
+void report(piece_errors& errors, std::size_t limit, std::size_t row, std::size_t column, status code) {
+    if (errors.list.size() < limit) errors.list.push_back({row, column, code});
+    ++errors.count;
+}
+
+// Разбор строк куска в столбцы начиная со строки row
+void parseRows(const char* first, const char* last, std::size_t row, const std::vector<dspirit_view>& columns,
+               const csv_options& opts, piece_errors& errors) {
+    const std::size_t width = columns.size();
+    Impl value;
+    while (first < last) {
+        const char* next = lineEnd(first, last);
+        const char* end = trimCr(first, next);
+        if (isBlank(first, end)) {
+            first = nextLine(next, last);
+            continue;
+        }
+
+        const char* p = first;
+        std::size_t column = 0;
+        bool more = true;
+        while (column < width && more) {
+            const field f = splitField(p, end, opts.delimiter);
+            const std::from_chars_result res = (f.first == f.last)
+                ? std::from_chars_result{f.first, std::errc::invalid_argument}
+                : detail::parseChars(f.first, f.last, value);
+            if (f.ok && res.ec == std::errc() && res.ptr == f.last) {
+                columns[column].store(row, value.parts());
+            } else {
+                columns[column].store(row, FAILED);
+                report(errors, opts.maxErrors, row, column, status::invalid_argument);
+            }
+            more = (f.end != end);
+            if (more) p = f.end + 1;
+            ++column;
+        }
+
+        if (column < width) {
+            // Недостающие поля
+            for (std::size_t c = column; c < width; ++c) columns[c].store(row, FAILED);
+            report(errors, opts.maxErrors, row, column, status::size_mismatch);
+        } else if (more) {
+            // Лишние поля после последнего столбца
+            report(errors, opts.maxErrors, row, width, status::size_mismatch);
+        }
+        ++row;
+        first = nextLine(next, last);
+    }
+}
+
+} // namespace
+
+status parseCsv(const char* first, const char* last, csv_table& out, const csv_options& opts) {
+    out = csv_table();
+
+    // Первая непустая строка задаёт число столбцов
+    while (first < last) {
+        const char* end = lineEnd(first, last);
+        const char* line = trimCr(first, end);
+        if (isBlank(first, line)) {
+            first = nextLine(end, last);
+            continue;
+        }
+
+        // Число полей (и имена при заголовке)
+        std::size_t width = 0;
+        const char* p = first;
+        for (;;) {
+            const field f = splitField(p, line, opts.delimiter);
+            if (opts.header) out.names.emplace_back(f.first, f.last);
+            ++width;
+            if (f.end == line) break;
+            p = f.end + 1;
+        }
+        if (opts.header) first = nextLine(end, last);
+        out.columns.resize(width);
+        break;
+    }
+    if (out.columns.empty() || first >= last) return status::ok;
+
+    // Куски по границам строк
+    const std::size_t bytes = static_cast<std::size_t>(last - first);
+    const std::size_t pieces = std::max<std::size_t>(1,
+        std::min<std::size_t>(4 * detail::threadCount(opts.threads), bytes / MIN_PIECE_BYTES));
+    std::vector<const char*> bounds(pieces + 1, last);
+    bounds[0] = first;
+    for (std::size_t k = 1; k < pieces; ++k) {
+        const char* at = std::max(bounds[k - 1], first + bytes / pieces * k);
+        bounds[k] = (at < last) ? nextLine(lineEnd(at, last), last) : last;
+    }
+
+    // Проход 1: число строк в каждом куске
+    std::vector<std::size_t> start(pieces + 1, 0);
+    detail::parallelFor(pieces, opts.threads, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) start[k + 1] = countRows(bounds[k], bounds[k + 1]);
+    });
+    for (std::size_t k = 0; k < pieces; ++k) start[k + 1] += start[k];
+    out.rows = start[pieces];
+
+    std::vector<dspirit_view> views;
+    views.reserve(out.columns.size());
+    for (dspirit_array& column : out.columns) {
+        column.resize(out.rows);
+        views.push_back(column.view());
+    }
+
+    // Проход 2: разбор прямо в плоскости столбцов
+    std::vector<piece_errors> errors(pieces);
+    detail::parallelFor(pieces, opts.threads, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) parseRows(bounds[k], bounds[k + 1], start[k], views, opts, errors[k]);
+    });
+
+    for (const piece_errors& e : errors) {
+        out.errorCount += e.count;
+        for (const csv_error& error : e.list) {
+            if (out.errors.size() < opts.maxErrors) out.errors.push_back(error);
+        }
+    }
+    return status::ok;
+}
+
+status loadCsv(const std::string& path, csv_table& out, const csv_options& opts) {
+    // parseCsv может бросить (std::bad_alloc): отображение освобождает деструктор
+    detail::scoped_mapping mapping;
+    const status code = detail::mapFile(path, mapping.get());
+    if (code != status::ok) return code;
+    detail::adviseSequential(mapping.get());
+    const char* text = reinterpret_cast<const char*>(mapping.get().data);
+    return parseCsv(text, text + mapping.get().bytes, out, opts);
+}
+
+} // namespace paradox
@@ -1,364 +1,32 @@
-#include "paradox/dspirit.h"
+#include "dspirit_impl.h"
+#include "paradox/kernel.h"
 
 #ifdef _WIN32
 #define PARADOX_DSPIRIT_EXPORTS
 #endif
 
-#include <cmath>
-#include <limits>
 #include <sstream>
-#include <stdexcept>
-#include <algorithm>
-#include <cctype>
-#include <cstring>  // Добавили для strlen/memcpy
+#include <utility>
 
 namespace paradox {
 
-// Внутренняя реализация
-class dspirit::Impl {
-private:
-    double r_;      // Старший уровень
-    double i_;      // Младший уровень
-    double j_;      // Самый младший уровень
-    double level_;  // Уровень старшего числа
-    
-    static const double epsilon;
-    static const double DOUBLE_POS_INF;
-    static const double DOUBLE_NEG_INF;
-
-    static const double NEAR_ZERO;
-    
-    // Вспомогательные методы
-    bool isNegligibleRelative(double small, double large) const;
-    
-
-public:
-    Impl(double value = 0.0, double level = 0.0) {
-        init(value, level);
-    }
-    
-    Impl(double r, double i, double j, double level) 
-        : r_(r), i_(i), j_(j), level_(level) {
-        normalize();
-    }
-    
-    // Копирование
-    Impl(const Impl& other) = default;
-    
-    // Методы доступа
-    double r() const { return r_; }
-    double i() const { return i_; }
-    double j() const { return j_; }
-    double level() const { return level_; }
-
-    // Вспомогательные методы
-    bool isApproxZero(double value) const {
-        return std::abs(value) < NEAR_ZERO;
-    }
-    
-    bool isApproxEqual(double a, double b) const {
-        return  std::abs(a - b) < epsilon;
-    }
-    
-    bool isApproxEqualLevel(double a, double b) const {
-        return std::abs(a - b) < epsilon * 0.1;
-    }
-    
-    void init(double value, double level = 0.0) {
-        if (isApproxZero(value)) {
-            // Для нуля используем еденицу в первом отрицательном слое
-            r_ = 1.0;  // Используем 0.0 вместо 1.0 для нуля
-            i_ = 0.0;
-            j_ = 0.0;
-            level_ = level - 1.0;
-        } else {
-            r_ = value;
-            i_ = 0.0;
-            j_ = 0.0;
-            level_ = level;
-        }
-    }
-    
-    void normalize() {
-        if (isApproxZero(r_)) {
-            if (!isApproxZero(i_)) {
-                r_ = i_;
-                i_ = j_;
-                j_ = 0.0;
-                level_ -= 1.0;
-            } else if (!isApproxZero(j_)) {
-                r_ = j_;
-                i_ = 0.0;
-                j_ = 0.0;
-                level_ -= 2.0;
-            } else {
-                // Все нули
-                r_ = 1.0;  // Устанавливаем r_ в 1 для нуля
-                i_ = 0.0;
-                j_ = 0.0;
-                level_ = DOUBLE_NEG_INF;  // суперноль
-            }
-            return;
-        }
-        resetLowerLevels();
-    }
-    
-    void resetLowerLevels() {
-        if (isApproxZero(i_)) i_ = 0.0;
-        if (isApproxZero(j_)) j_ = 0.0;
-    }
-    
-    double atLevel(double target_level) const {
-        const double diff = level_ - target_level;
-        
-        if (std::abs(diff) < epsilon) return r_;
-        if (std::abs(diff - 1.0) < epsilon) return i_;
-        if (std::abs(diff - 2.0) < epsilon) return j_;
-        
-        return 0.0;
-    }
-    
-    // Проверки свойств (математически корректные)
-    bool isZero() const { return level_ < (-epsilon); }
-    bool isInfinity() const { return level_ > epsilon; }
-    bool isRegular() const { return std::abs(level_) < epsilon; }
-    
-    // Математически корректные проверки знака
-    bool isNegative() const { return !isZero() && r_ < 0.0; }
-    bool isPositive() const { return !isZero() && r_ > 0.0; }
-    bool isNonNegative() const { return isZero() || isPositive(); }
-    bool isNonPositive() const { return isZero() || isNegative(); }
-    
-    // Арифметические операции
-    Impl negate() const {
-        Impl result;
-        result.r_ = -r_;
-        result.i_ = -i_;
-        result.j_ = -j_;
-        result.level_ = level_;
-        return result;
-    }
-    
-    Impl add(const Impl& other) const {
-        
-        // Быстрый путь для одинаковых уровней
-        if (isApproxEqualLevel(level_, other.level_)) {
-            Impl result;
-            result.r_ = r_ + other.r_;
-            if(result.r_ == DOUBLE_POS_INF) return {1.0, level_ + 1};
-            if(result.r_ == DOUBLE_NEG_INF) return {-1.0, level_ + 1};
-            result.i_ = i_ + other.i_;
-            if(result.i_ == DOUBLE_POS_INF) return {result.r_, 1.0, 0.0, level_};
-            if(result.i_ == DOUBLE_NEG_INF) return {result.r_, -1.0, 0.0, level_};
-            result.j_ = j_ + other.j_;
-            if(result.j_ == DOUBLE_POS_INF) return {result.r_, result.i_, 1.0, level_};
-            if(result.j_ == DOUBLE_NEG_INF) return {result.r_, result.i_, -1.0, level_};
-            result.level_ = level_;
-            result.normalize();
-            return result;
-        }
-        
-        // Находим максимальный уровень
-        const double max_level = (level_ > other.level_) ? level_ : other.level_;
-        const double min_level = (level_ < other.level_) ? level_ : other.level_;
-        
-        // Если разница в уровнях больше 2, то меньшими уровнями можно пренебречь
-        if (max_level - min_level > 2.5f) {
-            return (level_ > other.level_) ? *this : other;
-        }
-        
-        // Суммируем значения на каждом уровне
-        const double sum_r = atLevel(max_level) + other.atLevel(max_level);
-        if(sum_r == DOUBLE_POS_INF) return {1.0, max_level + 1};
-        if(sum_r == DOUBLE_NEG_INF) return {-1.0, max_level + 1};
-        const double sum_i = atLevel(max_level - 1.0) + other.atLevel(max_level - 1.0);
-        if(sum_i == DOUBLE_POS_INF) return {sum_r, 1.0, 0.0, max_level};
-        if(sum_i == DOUBLE_NEG_INF) return {sum_r, -1.0, 0.0, max_level};
-        const double sum_j = atLevel(max_level - 2.0) + other.atLevel(max_level - 2.0);
-        if(sum_j == DOUBLE_POS_INF) return {sum_r, sum_i, 1.0, max_level};
-        if(sum_j == DOUBLE_NEG_INF) return {sum_r, sum_i, -1.0, max_level};
-        Impl result(sum_r, sum_i, sum_j, max_level);
-        result.normalize();
-        return result;
-    }
-    
-    Impl subtract(const Impl& other) const {
-        return add(other.negate());
-    }
-    
-    Impl multiply(const Impl& other) const {
-        if(other.level_ == DOUBLE_NEG_INF){
-            if(level_ == DOUBLE_POS_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_NEG_INF};
-        }
-
-        if(other.level_ == DOUBLE_POS_INF){
-            if(level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_POS_INF};
-        }
-
-        if(level_ == DOUBLE_NEG_INF){
-            if(other.level_ == DOUBLE_POS_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_NEG_INF};
-        }
-
-        if(level_ == DOUBLE_POS_INF){
-            if(other.level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_POS_INF};
-        }
-        // Умножение: уровни складываются
-        const double result_level = level_ + other.level_;
-    
-        const double result_r = r_ * other.r_;
-        // если переполнение то увеличиваем уровень и отправляем еденицу
-        if(result_r == DOUBLE_POS_INF) return {1.0, result_level + 1};
-        if(result_r == DOUBLE_NEG_INF) return {-1.0, result_level + 1};
-
-        const double result_i = r_ * other.i_ + i_ * other.r_;
-        if(result_i == DOUBLE_POS_INF) return {result_r, 1.0, 0.0, result_level};
-        if(result_i == DOUBLE_NEG_INF) return {result_r, -1.0, 0.0, result_level};
-        
-        const double result_j = r_ * other.j_ + i_ * other.i_ + j_ * other.r_;
-        if(result_i == DOUBLE_POS_INF) return {result_r, result_i, 1.0, result_level};
-        if(result_i == DOUBLE_NEG_INF) return {result_r, result_i, -1.0, result_level};
-        
-        Impl result(result_r, result_i, result_j, result_level);
-        result.normalize();
-        return result;
-    }
-    
-    Impl divide(const Impl& divisor) const {
-        if(divisor.level_ == DOUBLE_NEG_INF){
-            if(level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_POS_INF};
-        }
-
-        if(divisor.level_ == DOUBLE_POS_INF){
-            if(level_ == DOUBLE_POS_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_NEG_INF};
-        }
+using detail::impl_access;
 
-        if(level_ == DOUBLE_NEG_INF){
-            if(divisor.level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_NEG_INF};
-        }
+namespace {
 
-        if(level_ == DOUBLE_POS_INF){
-            if(divisor.level_ == DOUBLE_POS_INF) return {1.0, 0.0};
-            return {1.0, DOUBLE_POS_INF};
-        }
+// Значение как Impl (обычное число разворачивается на стеке)
+detail::Impl implOf(const dspirit& x) { return impl_access::get(x); }
 
-        const double result_level = level_ - divisor.level_;
-        
-        const double result_r = r_ / divisor.r_;
-        if(result_r == DOUBLE_POS_INF) return {1.0, result_level + 1};
-        if(result_r == DOUBLE_NEG_INF) return {-1.0, result_level + 1};
-       
-        const double result_i = (i_ - result_r * divisor.i_) /  divisor.r_;
-        if(result_i == DOUBLE_POS_INF) return {result_r, 1.0, 0.0, result_level};
-        if(result_i == DOUBLE_NEG_INF) return {result_r, -1.0, 0.0, result_level};
-       
-        const double result_j = ((j_ - result_r * divisor.j_) - result_i * divisor.i_) / divisor.r_;
-        if(result_j == DOUBLE_POS_INF) return {result_r, result_i, 1.0, result_level};
-        if(result_j == DOUBLE_NEG_INF) return {result_r, result_i, -1.0, result_level};
-        
-        Impl result(result_r, result_i, result_j, result_level);
-        result.normalize();
-        return result;
-    }
-    
-    // Сравнения (математически корректные)
-    bool equals(const Impl& other) const {
-        // Все нули равны
-        if (isZero() && other.isZero()) return true;
-        
-        // Разные уровни (кроме нулей)
-        if (!isApproxEqualLevel(level_, other.level_)) return false;
-        
-        // Одинаковые уровни, сравниваем старшие значения
-        return isApproxEqual(r_, other.r_);
-    }
-    
-    bool lessThan(const Impl& other) const {
-        // Оба нуля
-        if (isZero() && other.isZero()) return false;
-        
-        // Текущее - ноль, другое - нет
-        if (isZero()) return other.isPositive();
-        
-        // Другое - ноль, текущее - нет
-        if (other.isZero()) return isNegative();
-        
-        // Оба не нули
-        // Сравнение уровней
-        if (!isApproxEqualLevel(level_, other.level_)) {
-            if (isPositive() && other.isPositive()) {
-                return level_ < other.level_;
-            }
-            if (isNegative() && other.isNegative()) {
-                return level_ > other.level_;
-            }
-            return isNegative() && other.isPositive();
-        }
-        
-        // Одинаковые уровни, сравниваем значения
-        if (!isApproxEqual(r_, other.r_)) {
-            return r_ < other.r_;
-        }
-        if (!isApproxEqual(i_, other.i_)) {
-            return i_ < other.i_;
-        }
-        return j_ < other.j_;
-    }
-    
-    // Преобразования
-    double toDouble() const {
-        if (isZero()) return 0.0;
-        if (isInfinity()) {
-            return (r_ > 0.0) ? std::numeric_limits<double>::infinity()
-                               : -std::numeric_limits<double>::infinity();
-        }
-        return static_cast<double>(r_);
-    }
-    
-    float toFloat() const {
-        if (isZero()) return 0.0;
-        if (isInfinity()) {
-            return (r_ > 0.0) ? std::numeric_limits<float>::infinity()
-                               : -std::numeric_limits<float>::infinity();
-        }
-        return static_cast<float>(r_);
-    }
-    
-    // Создание из строки
-    static Impl fromStringSimple(const std::string& s) {
-        std::string str = s;
-        
-        str.erase(std::remove_if(str.begin(), str.end(), 
-                  [](unsigned char c) { return std::isspace(c); }), 
-                  str.end());
-        
-        if (str.empty()) return Impl(0.0);
-        
-        if (str == "0" || str == "0.0") return Impl(0.0);
-        if (str == "inf" || str == "Inf" || str == "INF") return Impl(1.0, 1.0);
-        if (str == "-inf" || str == "-Inf" || str == "-INF") return Impl(-1.0, 1.0);
-        if (str == "1" || str == "1.0") return Impl(1.0);
-        if (str == "-1" || str == "-1.0") return Impl(-1.0);
-        
-        try {
-            double value = std::stod(str);
-            return Impl(value, 0.0);
-        } catch (...) {
-            throw std::invalid_argument("Cannot parse: " + s);
-        }
-    }
-};
+} // namespace
 
  dspirit dspirit::fromLevel(double value, double level) {
-        return dspirit(new Impl(value, level));
+        return impl_access::make(Impl(value, level));
     }
 
+dspirit dspirit::fromParts(const dspirit_parts& parts) {
+    return impl_access::make(Impl(parts.r, parts.i, parts.j, parts.level));
+}
+
 
 // Инициализация статической константы
 const double dspirit::Impl::epsilon = std::numeric_limits<double>::epsilon() * 10;
@@ -366,11 +34,13 @@ const double dspirit::Impl::DOUBLE_POS_INF = std::numeric_limits<double>::infini
 const double dspirit::Impl::DOUBLE_NEG_INF = -dspirit::Impl::DOUBLE_POS_INF;
 
 const double dspirit::Impl::NEAR_ZERO = std::numeric_limits<double>::min() * 100.0;
+const double dspirit::Impl::MAX_INTEGER_EXPONENT = 9007199254740992.0;  // 2^53
 
-// Конструкторы dspirit
-dspirit::dspirit(double value) noexcept : pimpl(new Impl(value)) {}
-dspirit::dspirit(float value) noexcept : pimpl(new Impl(static_cast<double>(value))) {}
-dspirit::dspirit(int value) noexcept : pimpl(new Impl(static_cast<double>(value))) {}
+// Конструкторы dspirit: обычные числа - без Pimpl
+dspirit::dspirit(double value) noexcept
+    : pimpl(Impl::isPlainValue(value) ? nullptr : new Impl(value)), value_(value) {}
+dspirit::dspirit(float value) noexcept : dspirit(static_cast<double>(value)) {}
+dspirit::dspirit(int value) noexcept : dspirit(static_cast<double>(value)) {}
 
 // Скрытый конструктор
 dspirit::dspirit(Impl* impl) : pimpl(impl) {}
@@ -378,30 +48,41 @@ dspirit::dspirit(Impl* impl) : pimpl(impl) {}
 // Деструктор, копирование, перемещение
 dspirit::~dspirit() { delete pimpl; }
 
-dspirit::dspirit(const dspirit& other) : pimpl(new Impl(*other.pimpl)) {}
-dspirit::dspirit(dspirit&& other) noexcept : pimpl(other.pimpl) { other.pimpl = nullptr; }
+dspirit::dspirit(const dspirit& other)
+    : pimpl(other.pimpl ? new Impl(*other.pimpl) : nullptr), value_(other.value_) {}
+
+// Источник без Pimpl становится обычным числом 1 (ONE): ZERO потребовал
+// бы выделения памяти, а value_ = 0.0 без Pimpl - не допустимое значение
+dspirit::dspirit(dspirit&& other) noexcept : pimpl(other.pimpl), value_(other.value_) {
+    other.pimpl = nullptr;
+    other.value_ = 1.0;
+}
 
 dspirit& dspirit::operator=(const dspirit& other) {
     if (this != &other) {
-        delete pimpl;
-        pimpl = new Impl(*other.pimpl);
+        if (pimpl && other.pimpl) {
+            *pimpl = *other.pimpl;
+        } else {
+            Impl* copy = other.pimpl ? new Impl(*other.pimpl) : nullptr;
+            delete pimpl;
+            pimpl = copy;
+        }
+        value_ = other.value_;
     }
     return *this;
 }
 
+// Обмен: источник получает прежнее значение приёмника
 dspirit& dspirit::operator=(dspirit&& other) noexcept {
-    if (this != &other) {
-        delete pimpl;
-        pimpl = other.pimpl;
-        other.pimpl = nullptr;
-    }
+    std::swap(pimpl, other.pimpl);
+    std::swap(value_, other.value_);
     return *this;
 }
 
-double dspirit::debugR() const { return pimpl->r(); }
-double dspirit::debugI() const { return pimpl->i(); }
-double dspirit::debugJ() const { return pimpl->j(); }
-double dspirit::debugLevel() const { return pimpl->level(); }
+double dspirit::debugR() const { return pimpl ? pimpl->r() : value_; }
+double dspirit::debugI() const { return pimpl ? pimpl->i() : 0.0; }
+double dspirit::debugJ() const { return pimpl ? pimpl->j() : 0.0; }
+double dspirit::debugLevel() const { return pimpl ? pimpl->level() : 0.0; }
  
 
 double dspirit::toDouble() const {
@@ -412,6 +93,10 @@ float dspirit::toFloat() const {
     return static_cast<float>(*this);
 }
 
+dspirit_parts dspirit::toParts() const {
+    return pimpl ? pimpl->parts() : dspirit_parts{value_, 0.0, 0.0, 0.0};
+}
+
 std::string dspirit::debugString() const {
     std::ostringstream oss;
     
@@ -430,23 +115,44 @@ std::string dspirit::debugString() const {
     return oss.str();
 }
 
-// Арифметические операторы
-dspirit dspirit::operator-() const { return dspirit(new Impl(pimpl->negate())); }
+// Арифметические операторы. Для двух обычных чисел - одна операция
+// double; переполнение, ноль и потеря значимости уходят в полный путь Impl,
+// который даёт тот же результат для остальных случаев.
+dspirit dspirit::operator-() const {
+    if (!pimpl) return impl_access::plain(-value_);
+    return impl_access::make(pimpl->negate());
+}
 
 dspirit dspirit::operator+(const dspirit& other) const {
-    return dspirit(new Impl(pimpl->add(*other.pimpl)));
+    if (!pimpl && !other.pimpl) {
+        const double sum = value_ + other.value_;
+        if (Impl::isPlainValue(sum)) return impl_access::plain(sum);
+    }
+    return impl_access::make(implOf(*this).add(implOf(other)));
 }
 
 dspirit dspirit::operator-(const dspirit& other) const {
-    return dspirit(new Impl(pimpl->subtract(*other.pimpl)));
+    if (!pimpl && !other.pimpl) {
+        const double difference = value_ - other.value_;
+        if (Impl::isPlainValue(difference)) return impl_access::plain(difference);
+    }
+    return impl_access::make(implOf(*this).subtract(implOf(other)));
 }
 
 dspirit dspirit::operator*(const dspirit& other) const {
-    return dspirit(new Impl(pimpl->multiply(*other.pimpl)));
+    if (!pimpl && !other.pimpl) {
+        const double product = value_ * other.value_;
+        if (Impl::isPlainValue(product)) return impl_access::plain(product);
+    }
+    return impl_access::make(implOf(*this).multiply(implOf(other)));
 }
 
 dspirit dspirit::operator/(const dspirit& divisor) const {
-    return dspirit(new Impl(pimpl->divide(*divisor.pimpl)));
+    if (!pimpl && !divisor.pimpl) {
+        const double quotient = value_ / divisor.value_;
+        if (Impl::isPlainValue(quotient)) return impl_access::plain(quotient);
+    }
+    return impl_access::make(implOf(*this).divide(implOf(divisor)));
 }
 
 // Составные операторы
@@ -473,7 +179,7 @@ dspirit dspirit::operator/(int val) const { return *this / dspirit(val); }
 
 // Операторы сравнения
 bool dspirit::operator==(const dspirit& other) const {
-    return pimpl->equals(*other.pimpl);
+    return implOf(*this).equals(implOf(other));
 }
 
 bool dspirit::operator!=(const dspirit& other) const {
@@ -481,7 +187,7 @@ bool dspirit::operator!=(const dspirit& other) const {
 }
 
 bool dspirit::operator<(const dspirit& other) const {
-    return pimpl->lessThan(*other.pimpl);
+    return implOf(*this).lessThan(implOf(other));
 }
 
 bool dspirit::operator>(const dspirit& other) const {
@@ -510,40 +216,27 @@ dspirit dspirit::inverse() const {
 }
 
 // Проверки свойств (математически корректные)
-bool dspirit::isZero() const { return pimpl->isZero(); }
-bool dspirit::isInfinity() const { return pimpl->isInfinity(); }
-bool dspirit::isFinite() const { return !pimpl->isZero() && !pimpl->isInfinity(); }
-bool dspirit::isNegative() const { return pimpl->isNegative(); }
-bool dspirit::isPositive() const { return pimpl->isPositive(); }
-bool dspirit::isNonNegative() const { return pimpl->isNonNegative(); }
-bool dspirit::isNonPositive() const { return pimpl->isNonPositive(); }
+// Обычное число - конечное, ненулевое
+bool dspirit::isZero() const { return pimpl && pimpl->isZero(); }
+bool dspirit::isInfinity() const { return pimpl && pimpl->isInfinity(); }
+bool dspirit::isFinite() const { return !pimpl || (!pimpl->isZero() && !pimpl->isInfinity()); }
+bool dspirit::isNegative() const { return pimpl ? pimpl->isNegative() : value_ < 0.0; }
+bool dspirit::isPositive() const { return pimpl ? pimpl->isPositive() : value_ > 0.0; }
+bool dspirit::isNonNegative() const { return pimpl ? pimpl->isNonNegative() : value_ > 0.0; }
+bool dspirit::isNonPositive() const { return pimpl ? pimpl->isNonPositive() : value_ < 0.0; }
 
 // Преобразования
-dspirit::operator double() const { return pimpl->toDouble(); }
-dspirit::operator float() const { return pimpl->toFloat(); }
+dspirit::operator double() const { return pimpl ? pimpl->toDouble() : value_; }
+dspirit::operator float() const { return pimpl ? pimpl->toFloat() : static_cast<float>(value_); }
 
 std::string dspirit::toString() const {
-    std::ostringstream oss;
-    oss.precision(10);
-    
-    if (isZero()) {
-        oss << "0";
-    } else if (isInfinity()) {
-        if (isNegative()) {
-            oss << "-inf";
-        } else {
-            oss << "inf";
-        }
-    } else {
-        oss << static_cast<double>(*this);
-    }
-    
-    return oss.str();
+    char buffer[MAX_CHARS];
+    return std::string(buffer, to_chars(buffer, buffer + MAX_CHARS).ptr);
 }
 
 // Статические методы
 dspirit dspirit::fromString(const std::string& s) {
-    return dspirit(new Impl(Impl::fromStringSimple(s)));
+    return impl_access::make(Impl::fromStringSimple(s));
 }
 
 dspirit dspirit::parse(const std::string& s) {
@@ -557,20 +250,36 @@ const dspirit dspirit::NEG_INF(new Impl(-1.0, 1.0));
 const dspirit dspirit::ONE(1.0);
 const dspirit dspirit::NEG_ONE(-1.0);
 const dspirit dspirit::EPSILON(new Impl(1.0, -1.0));
-const dspirit dspirit::SUPER_ZERO(new Impl(1.0, DOUBLE_NEG_INF));
-const dspirit dspirit::SUPER_INF(new Impl(1.0, DOUBLE_POS_INF));
+const dspirit dspirit::SUPER_ZERO(new Impl(1.0, -std::numeric_limits<double>::infinity()));
+const dspirit dspirit::SUPER_INF(new Impl(1.0, std::numeric_limits<double>::infinity()));
 
 
 // Операторы ввода/вывода
 std::ostream& operator<<(std::ostream& os, const dspirit& num) {
-    os << num.toString();
+    char buffer[dspirit::MAX_CHARS];
+    const std::to_chars_result res = num.to_chars(buffer, buffer + dspirit::MAX_CHARS);
+    os.write(buffer, res.ptr - buffer);
     return os;
 }
 
+// Лексема читается в буфер на стеке и разбирается через from_chars;
+// неверная запись выставляет failbit, как у встроенных чисел
 std::istream& operator>>(std::istream& is, dspirit& num) {
-    std::string s;
-    is >> s;
-    num = dspirit::fromString(s);
+    std::istream::sentry guard(is);
+    if (!guard) return is;
+
+    char buffer[128];
+    std::size_t n = 0;
+    while (n < sizeof buffer) {
+        const int c = is.peek();
+        if (c == std::char_traits<char>::eof() || std::isspace(c)) break;
+        buffer[n++] = static_cast<char>(is.get());
+    }
+
+    const std::from_chars_result res = dspirit::from_chars(buffer, buffer + n, num);
+    if (n == sizeof buffer || res.ec != std::errc() || res.ptr != buffer + n) {
+        is.setstate(std::ios_base::failbit);
+    }
     return is;
 }
 
@@ -591,68 +300,25 @@ dspirit operator*(int lhs, const dspirit& rhs) { return dspirit(lhs) * rhs; }
 dspirit operator/(int lhs, const dspirit& rhs) { return dspirit(lhs) / rhs; }
 
 // Математические функции
-dspirit sqrt(const dspirit& x) {
-    if (x.isZero()) return dspirit::ZERO;
-    if (x.isInfinity()) return dspirit::INF;
-    if (x.isNegative()) {
-        throw std::domain_error("sqrt of negative number");
-    }
-    return dspirit(std::sqrt(static_cast<double>(x)));
-}
-
-dspirit pow(const dspirit& x, double exponent) {
-    if (x.isZero()) {
-        if (exponent > 0) return dspirit::ZERO;
-        if (exponent < 0) return dspirit::INF;
-        return dspirit::ONE;  // 0^0 = 1 (по соглашению)
-    }
-    
-    if (x.isInfinity()) {
-        if (exponent > 0) return dspirit::INF;
-        if (exponent < 0) return dspirit::ZERO;
-        return dspirit::ONE;
-    }
-    
-    return dspirit(std::pow(static_cast<double>(x), exponent));
-}
-
-dspirit exp(const dspirit& x) {
-    if (x.isZero()) return dspirit::ONE;
-    if (x.isInfinity()) {
-        if (x.isPositive()) return dspirit::INF;
-        else return dspirit::ZERO;
-    }
-    return dspirit(std::exp(static_cast<double>(x)));
-}
-
-dspirit log(const dspirit& x) {
-    if (x.isZero()) return dspirit::NEG_INF;
-    if (x.isInfinity()) return dspirit::INF;
-    if (x.isNegative()) {
-        throw std::domain_error("log of negative number");
-    }
-    return dspirit(std::log(static_cast<double>(x)));
-}
-
-dspirit sin(const dspirit& x) {
-    if (x.isInfinity()) {
-        throw std::domain_error("sin of infinity");
-    }
-    return dspirit(std::sin(static_cast<double>(x)));
-}
-
-dspirit cos(const dspirit& x) {
-    if (x.isInfinity()) {
-        throw std::domain_error("cos of infinity");
-    }
-    return dspirit(std::cos(static_cast<double>(x)));
-}
-
-dspirit tan(const dspirit& x) {
-    if (x.isInfinity()) {
-        throw std::domain_error("tan of infinity");
-    }
-    return dspirit(std::tan(static_cast<double>(x)));
+dspirit sqrt(const dspirit& x) { return dspirit::fromParts(kernel::sqrt(x.toParts())); }
+dspirit pow(const dspirit& x, double exponent) { return dspirit::fromParts(kernel::pow(x.toParts(), exponent)); }
+dspirit exp(const dspirit& x) { return dspirit::fromParts(kernel::exp(x.toParts())); }
+dspirit log(const dspirit& x) { return dspirit::fromParts(kernel::log(x.toParts())); }
+dspirit sin(const dspirit& x) { return dspirit::fromParts(kernel::sin(x.toParts())); }
+dspirit cos(const dspirit& x) { return dspirit::fromParts(kernel::cos(x.toParts())); }
+dspirit tan(const dspirit& x) { return dspirit::fromParts(kernel::tan(x.toParts())); }
+dspirit sinh(const dspirit& x) { return dspirit::fromParts(kernel::sinh(x.toParts())); }
+dspirit cosh(const dspirit& x) { return dspirit::fromParts(kernel::cosh(x.toParts())); }
+dspirit tanh(const dspirit& x) { return dspirit::fromParts(kernel::tanh(x.toParts())); }
+dspirit cbrt(const dspirit& x) { return dspirit::fromParts(kernel::cbrt(x.toParts())); }
+dspirit erf(const dspirit& x) { return dspirit::fromParts(kernel::erf(x.toParts())); }
+dspirit log1p(const dspirit& x) { return dspirit::fromParts(kernel::log1p(x.toParts())); }
+dspirit expm1(const dspirit& x) { return dspirit::fromParts(kernel::expm1(x.toParts())); }
+dspirit atan2(const dspirit& y, const dspirit& x) { return dspirit::fromParts(kernel::atan2(y.toParts(), x.toParts())); }
+dspirit hypot(const dspirit& x, const dspirit& y) { return dspirit::fromParts(kernel::hypot(x.toParts(), y.toParts())); }
+
+dspirit fma(const dspirit& a, const dspirit& b, const dspirit& c) {
+    return impl_access::make(implOf(a).fma(implOf(b), implOf(c)));
 }
 
 } // namespace paradox
\ No newline at end of file
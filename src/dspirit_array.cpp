@@ -0,0 +1,403 @@
+#include "paradox/dspirit_array.h"
+#include "dspirit_impl.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace paradox {
+
+using detail::Impl;
+
+// Конструкторы
+dspirit_array::dspirit_array(std::size_t n, const dspirit& value) {
+    resize(n, value);
+}
+
+dspirit_array::dspirit_array(std::initializer_list<double> values) {
+    reserve(values.size());
+    for (double value : values) push_back(kernel::make(value));
+}
+
+dspirit_array::dspirit_array(const std::vector<double>& values) {
+    reserve(values.size());
+    for (double value : values) push_back(kernel::make(value));
+}
+
+dspirit_array::dspirit_array(const_dspirit_view values) {
+    reserve(values.size);
+    for (std::size_t k = 0; k < values.size; ++k) push_back(values[k]);
+}
+
+// Размер
+void dspirit_array::resize(std::size_t n, const dspirit& value) {
+    const dspirit_parts p = value.toParts();
+    r_.resize(n, p.r);
+    i_.resize(n, p.i);
+    j_.resize(n, p.j);
+    level_.resize(n, p.level);
+}
+
+void dspirit_array::reserve(std::size_t n) {
+    r_.reserve(n);
+    i_.reserve(n);
+    j_.reserve(n);
+    level_.reserve(n);
+}
+
+void dspirit_array::clear() {
+    r_.clear();
+    i_.clear();
+    j_.clear();
+    level_.clear();
+}
+
+// Добавление
+void dspirit_array::push_back(const dspirit& value) {
+    push_back(value.toParts());
+}
+
+void dspirit_array::push_back(const dspirit_parts& value) {
+    r_.push_back(value.r);
+    i_.push_back(value.i);
+    j_.push_back(value.j);
+    level_.push_back(value.level);
+}
+
+// Доступ к элементам
+dspirit dspirit_array::operator[](std::size_t k) const {
+    return detail::impl_access::make(Impl::fromParts(parts(k)));
+}
+
+void dspirit_array::set(std::size_t k, const dspirit& value) {
+    set(k, value.toParts());
+}
+
+void dspirit_array::set(std::size_t k, const dspirit_parts& value) {
+    r_[k] = value.r;
+    i_[k] = value.i;
+    j_[k] = value.j;
+    level_[k] = value.level;
+}
+
+// Представления
+dspirit_view dspirit_array::view() {
+    return {r_.data(), i_.data(), j_.data(), level_.data(), r_.size()};
+}
+
+const_dspirit_view dspirit_array::view() const {
+    return {r_.data(), i_.data(), j_.data(), level_.data(), r_.size()};
+}
+
+namespace batch {
+
+namespace {
+
+void checkSize(std::size_t a, std::size_t b) {
+    if (a != b) {
+        detail::raise(status::size_mismatch, "dspirit_array: size mismatch");
+    }
+}
+
+// Элементов в блоке пакетных функций с обычным путём
+const std::size_t PLAIN_BLOCK = 256;
+
+const dspirit_parts PARTS_NAN = {std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0};
+
+// Элемент k через ядро со статусом; при ошибке - NaN и бит в failed
+template <class Fn>
+std::size_t applyOne(const_dspirit_view x, dspirit_view out, std::uint64_t* failed, std::size_t k, Fn fn) {
+    dspirit_parts value;
+    if (fn(x[k], value) == status::ok) {
+        out.store(k, value);
+        return 0;
+    }
+    out.store(k, PARTS_NAN);
+    if (failed) failed[k / 64] |= std::uint64_t(1) << (k % 64);
+    return 1;
+}
+
+template <class Fn>
+std::size_t applyChecked(const_dspirit_view x, dspirit_view out, std::uint64_t* failed, Fn fn) {
+    checkSize(x.size, out.size);
+    if (failed) std::fill(failed, failed + statusWords(out.size), std::uint64_t(0));
+
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < out.size; ++k) count += applyOne(x, out, failed, k, fn);
+    return count;
+}
+
+// Элементы [begin, end) - обычные числа уровня 0. Проход по плоскостям
+// без ранних выходов
+bool isPlainBlock(const_dspirit_view x, std::size_t begin, std::size_t end) {
+    bool plain = true;
+    for (std::size_t k = begin; k < end; ++k) plain &= Impl::isPlainValue(x.r[k]);
+    if (x.i) for (std::size_t k = begin; k < end; ++k) plain &= (x.i[k] == 0.0);
+    if (x.j) for (std::size_t k = begin; k < end; ++k) plain &= (x.j[k] == 0.0);
+    if (x.level) for (std::size_t k = begin; k < end; ++k) plain &= (x.level[k] == 0.0);
+    return plain;
+}
+
+// Блок из обычных чисел считается одним циклом plain по плоскости r без
+// разбора уровней; элементы, где результат вышел из обычных чисел
+// (переполнение, потеря значимости, вне области определения), и блоки с
+// уровнями и подуровнями пересчитываются ядром fn. Для обычного результата
+// plain обязана совпадать с fn. plain вызывается поэлементно (std::exp и
+// т.п.): выигрыш - от пропуска Impl и разбора уровней, цикл остаётся скалярным
+template <class Plain, class Fn>
+std::size_t applyPlainChecked(const_dspirit_view x, dspirit_view out, std::uint64_t* failed, Plain plain, Fn fn) {
+    checkSize(x.size, out.size);
+    if (failed) std::fill(failed, failed + statusWords(out.size), std::uint64_t(0));
+
+    double value[PLAIN_BLOCK];
+    std::size_t count = 0;
+    for (std::size_t begin = 0; begin < out.size; begin += PLAIN_BLOCK) {
+        const std::size_t end = std::min(begin + PLAIN_BLOCK, out.size);
+        if (!isPlainBlock(x, begin, end)) {
+            for (std::size_t k = begin; k < end; ++k) count += applyOne(x, out, failed, k, fn);
+            continue;
+        }
+        for (std::size_t k = begin; k < end; ++k) value[k - begin] = plain(x.r[k]);
+        // out может совпадать с x: элемент k перезаписывается после чтения
+        for (std::size_t k = begin; k < end; ++k) {
+            const double v = value[k - begin];
+            if (Impl::isPlainValue(v)) out.store(k, {v, 0.0, 0.0, 0.0});
+            else count += applyOne(x, out, failed, k, fn);
+        }
+    }
+    return count;
+}
+
+// То же для функций двух аргументов без ошибок
+template <class Plain, class Fn>
+void applyPlainBinary(const_dspirit_view a, const_dspirit_view b, dspirit_view out, Plain plain, Fn fn) {
+    checkSize(a.size, out.size);
+    checkSize(b.size, out.size);
+
+    double value[PLAIN_BLOCK];
+    for (std::size_t begin = 0; begin < out.size; begin += PLAIN_BLOCK) {
+        const std::size_t end = std::min(begin + PLAIN_BLOCK, out.size);
+        if (!isPlainBlock(a, begin, end) || !isPlainBlock(b, begin, end)) {
+            for (std::size_t k = begin; k < end; ++k) out.store(k, fn(a[k], b[k]));
+            continue;
+        }
+        for (std::size_t k = begin; k < end; ++k) value[k - begin] = plain(a.r[k], b.r[k]);
+        for (std::size_t k = begin; k < end; ++k) {
+            const double v = value[k - begin];
+            out.store(k, Impl::isPlainValue(v) ? dspirit_parts{v, 0.0, 0.0, 0.0} : fn(a[k], b[k]));
+        }
+    }
+}
+
+template <class Op>
+void apply(const_dspirit_view a, const_dspirit_view b, dspirit_view out, Op op) {
+    checkSize(a.size, out.size);
+    checkSize(b.size, out.size);
+    for (std::size_t k = 0; k < out.size; ++k) {
+        out.store(k, op(Impl::fromParts(a[k]), Impl::fromParts(b[k])).parts());
+    }
+}
+
+template <class Op>
+void apply(const_dspirit_view a, const dspirit_parts& b, dspirit_view out, Op op) {
+    checkSize(a.size, out.size);
+    const Impl y = Impl::fromParts(b);
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, op(Impl::fromParts(a[k]), y).parts());
+}
+
+template <class Op>
+void apply(const dspirit_parts& a, const_dspirit_view b, dspirit_view out, Op op) {
+    checkSize(b.size, out.size);
+    const Impl x = Impl::fromParts(a);
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, op(x, Impl::fromParts(b[k])).parts());
+}
+
+} // namespace
+
+void negate(const_dspirit_view x, dspirit_view out) {
+    checkSize(x.size, out.size);
+    for (std::size_t k = 0; k < out.size; ++k) {
+        out.store(k, Impl::fromParts(x[k]).negate().parts());
+    }
+}
+
+void add(const_dspirit_view a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.add(y); });
+}
+
+void add(const_dspirit_view a, const dspirit_parts& b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.add(y); });
+}
+
+void add(const dspirit_parts& a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.add(y); });
+}
+
+void subtract(const_dspirit_view a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.subtract(y); });
+}
+
+void subtract(const_dspirit_view a, const dspirit_parts& b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.subtract(y); });
+}
+
+void subtract(const dspirit_parts& a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.subtract(y); });
+}
+
+void multiply(const_dspirit_view a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.multiply(y); });
+}
+
+void multiply(const_dspirit_view a, const dspirit_parts& b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.multiply(y); });
+}
+
+void multiply(const dspirit_parts& a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.multiply(y); });
+}
+
+void divide(const_dspirit_view a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.divide(y); });
+}
+
+void divide(const_dspirit_view a, const dspirit_parts& b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.divide(y); });
+}
+
+void divide(const dspirit_parts& a, const_dspirit_view b, dspirit_view out) {
+    apply(a, b, out, [](const Impl& x, const Impl& y) { return x.divide(y); });
+}
+
+void fma(const_dspirit_view a, const_dspirit_view b, const_dspirit_view c, dspirit_view out) {
+    checkSize(a.size, out.size);
+    checkSize(b.size, out.size);
+    checkSize(c.size, out.size);
+    for (std::size_t k = 0; k < out.size; ++k) {
+        const Impl x = Impl::fromParts(a[k]);
+        out.store(k, x.fma(Impl::fromParts(b[k]), Impl::fromParts(c[k])).parts());
+    }
+}
+
+std::size_t sqrt(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::sqrt(v, r); });
+}
+
+std::size_t pow(const_dspirit_view x, double exponent, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [exponent](const dspirit_parts& v, dspirit_parts& r) {
+        return kernel::pow(v, exponent, r);
+    });
+}
+
+std::size_t exp(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::exp(v, r); });
+}
+
+std::size_t log(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::log(v, r); });
+}
+
+std::size_t sin(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::sin(v, r); });
+}
+
+std::size_t cos(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::cos(v, r); });
+}
+
+std::size_t tan(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return kernel::tan(v, r); });
+}
+
+std::size_t sinh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::sinh(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::sinh(v, r); });
+}
+
+std::size_t cosh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::cosh(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::cosh(v, r); });
+}
+
+std::size_t tanh(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::tanh(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::tanh(v, r); });
+}
+
+std::size_t cbrt(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::cbrt(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::cbrt(v, r); });
+}
+
+std::size_t erf(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::erf(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::erf(v, r); });
+}
+
+std::size_t log1p(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::log1p(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::log1p(v, r); });
+}
+
+std::size_t expm1(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyPlainChecked(x, out, failed, [](double v) { return std::expm1(v); },
+                             [](const dspirit_parts& v, dspirit_parts& r) { return kernel::expm1(v, r); });
+}
+
+void atan2(const_dspirit_view y, const_dspirit_view x, dspirit_view out) {
+    applyPlainBinary(y, x, out, [](double a, double b) { return std::atan2(a, b); },
+                     [](const dspirit_parts& a, const dspirit_parts& b) { return kernel::atan2(a, b); });
+}
+
+void hypot(const_dspirit_view x, const_dspirit_view y, dspirit_view out) {
+    // Как в kernel::hypot; отношение ниже NEAR_ZERO даёт NaN и общий путь
+    auto plain = [](double a, double b) {
+        const double big = std::max(std::abs(a), std::abs(b));
+        const double q = std::min(std::abs(a), std::abs(b)) / big;
+        const double h = big * std::sqrt(1.0 + q * q);
+        return Impl::isPlainValue(q) ? h : std::numeric_limits<double>::quiet_NaN();
+    };
+    applyPlainBinary(x, y, out, plain,
+                     [](const dspirit_parts& a, const dspirit_parts& b) { return kernel::hypot(a, b); });
+}
+
+} // namespace batch
+
+// Поэлементные операции над массивами
+dspirit_array operator-(const dspirit_array& x) {
+    dspirit_array result(x.size());
+    batch::negate(x, result);
+    return result;
+}
+
+dspirit_array operator+(const dspirit_array& lhs, const dspirit_array& rhs) {
+    dspirit_array result(lhs.size());
+    batch::add(lhs, rhs, result);
+    return result;
+}
+
+dspirit_array operator-(const dspirit_array& lhs, const dspirit_array& rhs) {
+    dspirit_array result(lhs.size());
+    batch::subtract(lhs, rhs, result);
+    return result;
+}
+
+dspirit_array operator*(const dspirit_array& lhs, const dspirit_array& rhs) {
+    dspirit_array result(lhs.size());
+    batch::multiply(lhs, rhs, result);
+    return result;
+}
+
+dspirit_array operator/(const dspirit_array& lhs, const dspirit_array& rhs) {
+    dspirit_array result(lhs.size());
+    batch::divide(lhs, rhs, result);
+    return result;
+}
+
+dspirit_array fma(const dspirit_array& a, const dspirit_array& b, const dspirit_array& c) {
+    dspirit_array result(a.size());
+    batch::fma(a, b, c, result);
+    return result;
+}
+
+} // namespace paradox
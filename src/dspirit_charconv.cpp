@@ -0,0 +1,260 @@
+#include "dspirit_impl.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+const double POS_INF = std::numeric_limits<double>::infinity();
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Слово без учёта регистра (inf, Inf, INF)
+bool matchWord(const char* first, const char* last, const char* word) {
+    const std::size_t n = std::strlen(word);
+    if (static_cast<std::size_t>(last - first) < n) return false;
+    for (std::size_t k = 0; k < n; ++k) {
+        if (std::tolower(static_cast<unsigned char>(first[k])) != word[k]) return false;
+    }
+    return true;
+}
+
+// Число без знака: std::from_chars, если библиотека его поддерживает для
+// double, иначе strtod по копии на стеке
+std::from_chars_result parseUnsigned(const char* first, const char* last, double& value) {
+    if (first == last || !(isDigit(*first) || *first == '.')) return {first, std::errc::invalid_argument};
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    return std::from_chars(first, last, value, std::chars_format::general);
+#else
+    char buffer[64];
+    const std::size_t n = std::min<std::size_t>(static_cast<std::size_t>(last - first), sizeof buffer - 1);
+    std::memcpy(buffer, first, n);
+    buffer[n] = '\0';
+    errno = 0;
+    char* end = nullptr;
+    const double parsed = std::strtod(buffer, &end);
+    if (end == buffer) return {first, std::errc::invalid_argument};
+    if (errno == ERANGE && std::abs(parsed) == HUGE_VAL) return {first + (end - buffer), std::errc::result_out_of_range};
+    value = parsed;
+    return {first + (end - buffer), std::errc()};
+#endif
+}
+
+// Знак: '+' или '-'
+const char* parseSign(const char* first, const char* last, double& sign) {
+    sign = 1.0;
+    if (first != last && (*first == '+' || *first == '-')) {
+        if (*first == '-') sign = -1.0;
+        ++first;
+    }
+    return first;
+}
+
+// Слова inf и nan, которые writer::number пишет для нечисловых double
+bool parseWord(const char*& first, const char* last, double& value) {
+    if (matchWord(first, last, "inf")) value = POS_INF;
+    else if (matchWord(first, last, "nan")) value = std::numeric_limits<double>::quiet_NaN();
+    else return false;
+    first += 3;
+    return true;
+}
+
+// Число со знаком (компоненты в записи (r,i,j)), в том числе inf и nan
+bool parseSigned(const char*& first, const char* last, double& value) {
+    double sign;
+    const char* p = parseSign(first, last, sign);
+    if (parseWord(p, last, value)) {
+        value *= sign;
+        first = p;
+        return true;
+    }
+    const std::from_chars_result res = parseUnsigned(p, last, value);
+    if (res.ec != std::errc()) return false;
+    value *= sign;
+    first = res.ptr;
+    return true;
+}
+
+bool expect(const char*& first, const char* last, char c) {
+    if (first == last || *first != c) return false;
+    ++first;
+    return true;
+}
+
+// Уровень после '@' или '^': число, inf или nan со знаком
+bool parseLevel(const char*& first, const char* last, double& level) {
+    return parseSigned(first, last, level);
+}
+
+// Необязательный суффикс уровня: при ошибке разбор заканчивается до него
+double parseSuffix(const char*& first, const char* last, char mark, double fallback) {
+    if (first == last || *first != mark) return fallback;
+    const char* p = first + 1;
+    double level;
+    if (!parseLevel(p, last, level)) return fallback;
+    first = p;
+    return level;
+}
+
+// Запись в буфер вызывающего; при нехватке места ok сбрасывается
+struct writer {
+    char* ptr;
+    char* last;
+    bool ok;
+
+    void put(char c) {
+        if (ptr == last) ok = false;
+        if (ok) *ptr++ = c;
+    }
+
+    void put(const char* text) {
+        while (*text) put(*text++);
+    }
+
+    // precision = 0 - кратчайшая запись, точно восстанавливаемая при чтении
+    void number(double value, int precision = 0) {
+        if (!ok) return;
+        if (std::isinf(value)) {
+            put(value < 0.0 ? "-inf" : "inf");
+            return;
+        }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const std::to_chars_result res = (precision == 0)
+            ? std::to_chars(ptr, last, value)
+            : std::to_chars(ptr, last, value, std::chars_format::general, precision);
+        if (res.ec != std::errc()) ok = false;
+        else ptr = res.ptr;
+#else
+        char buffer[32];
+        const int n = std::snprintf(buffer, sizeof buffer, "%.*g", precision == 0 ? 17 : precision, value);
+        for (int k = 0; k < n; ++k) put(buffer[k]);
+#endif
+    }
+};
+
+void writeCompact(writer& out, const Impl& v) {
+    if (v.isZero()) out.put('0');
+    else if (v.isInfinity()) out.put(v.isNegative() ? "-inf" : "inf");
+    else out.number(v.toDouble(), 10);
+}
+
+// Старшая часть с уровнем: 3.5, 3.5@2, inf, -inf^2, eps^3; 0 - для ZERO
+void writeShortest(writer& out, const Impl& v) {
+    const double level = v.level();
+    if (std::abs(v.r()) == 1.0 && level != 0.0) {
+        if (v.r() == 1.0 && level == -1.0) {
+            out.put('0');
+            return;
+        }
+        if (v.r() < 0.0) out.put('-');
+        out.put(level > 0.0 ? "inf" : "eps");
+        const double power = std::abs(level);
+        if (power != 1.0) {
+            out.put('^');
+            out.number(power);
+        }
+        return;
+    }
+    out.number(v.r());
+    if (level != 0.0) {
+        out.put('@');
+        out.number(level);
+    }
+}
+
+void writeLossless(writer& out, const Impl& v) {
+    if (v.i() == 0.0 && v.j() == 0.0) {
+        writeShortest(out, v);
+        return;
+    }
+    out.put('(');
+    out.number(v.r());
+    out.put(',');
+    out.number(v.i());
+    out.put(',');
+    out.number(v.j());
+    out.put(')');
+    if (v.level() != 0.0) {
+        out.put('@');
+        out.number(v.level());
+    }
+}
+
+} // namespace
+
+std::to_chars_result dspirit::to_chars(char* first, char* last, text_format format) const {
+    return detail::formatChars(first, last, detail::impl_access::get(*this), format);
+}
+
+namespace detail {
+
+std::to_chars_result formatChars(char* first, char* last, const Impl& value, text_format format) {
+    writer out = {first, last, true};
+    switch (format) {
+        case text_format::compact: writeCompact(out, value); break;
+        case text_format::shortest: writeShortest(out, value); break;
+        case text_format::lossless: writeLossless(out, value); break;
+    }
+    if (!out.ok) return {last, std::errc::value_too_large};
+    return {out.ptr, std::errc()};
+}
+
+std::from_chars_result parseChars(const char* first, const char* last, Impl& value) {
+    double sign;
+    const char* p = parseSign(first, last, sign);
+
+    // Обычное число - самый частый случай, проверяется первым
+    if (p != last && (isDigit(*p) || *p == '.')) {
+        double number;
+        const std::from_chars_result res = parseUnsigned(p, last, number);
+        if (res.ec != std::errc()) return {first, res.ec};
+        p = res.ptr;
+        value = Impl(sign * number, parseSuffix(p, last, '@', 0.0));
+    } else if (p == first && p != last && *p == '(') {
+        // Все компоненты: (r,i,j)@level
+        double r, i, j;
+        ++p;
+        if (!parseSigned(p, last, r) || !expect(p, last, ',') || !parseSigned(p, last, i) ||
+            !expect(p, last, ',') || !parseSigned(p, last, j) || !expect(p, last, ')')) {
+            return {first, std::errc::invalid_argument};
+        }
+        value = Impl(r, i, j, parseSuffix(p, last, '@', 0.0));
+    } else if (matchWord(p, last, "inf")) {
+        p += 3;
+        value = Impl(sign, parseSuffix(p, last, '^', 1.0));
+    } else if (matchWord(p, last, "eps")) {
+        p += 3;
+        value = Impl(sign, -parseSuffix(p, last, '^', 1.0));
+    } else if (matchWord(p, last, "nan")) {
+        // NaN, который пакетные функции и загрузчики пишут в ошибочные элементы
+        p += 3;
+        value = Impl(sign * std::numeric_limits<double>::quiet_NaN(), parseSuffix(p, last, '@', 0.0));
+    } else {
+        return {first, std::errc::invalid_argument};
+    }
+    return {p, std::errc()};
+}
+
+} // namespace detail
+
+std::from_chars_result dspirit::from_chars(const char* first, const char* last, dspirit& value) {
+    Impl result;
+    const std::from_chars_result res = detail::parseChars(first, last, result);
+    if (res.ec != std::errc()) return res;
+    // Запись в существующий Impl (или обычное число) - без выделения памяти
+    detail::impl_access::assign(value, result);
+    return res;
+}
+
+std::from_chars_result dspirit::from_chars(std::string_view text, dspirit& value) {
+    return from_chars(text.data(), text.data() + text.size(), value);
+}
+
+} // namespace paradox
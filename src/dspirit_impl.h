@@ -0,0 +1,593 @@
+#ifndef PARADOX_DSPIRIT_IMPL_H
+#define PARADOX_DSPIRIT_IMPL_H
+
+// Внутренний заголовок: общий для модулей библиотеки, не устанавливается.
+
+#include "paradox/dspirit.h"
+#include "paradox/status.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <cctype>
+
+namespace paradox {
+
+// Внутренняя реализация
+class dspirit::Impl {
+private:
+    double r_;      // Старший уровень
+    double i_;      // Младший уровень
+    double j_;      // Самый младший уровень
+    double level_;  // Уровень старшего числа
+    
+    static const double epsilon;
+    static const double DOUBLE_POS_INF;
+    static const double DOUBLE_NEG_INF;
+
+    static const double NEAR_ZERO;
+    static const double MAX_INTEGER_EXPONENT;  // граница точных целых степеней
+    
+    // Вспомогательные методы
+    bool isNegligibleRelative(double small, double large) const;
+    
+
+public:
+    Impl(double value = 0.0, double level = 0.0) {
+        init(value, level);
+    }
+    
+    Impl(double r, double i, double j, double level) 
+        : r_(r), i_(i), j_(j), level_(level) {
+        normalize();
+    }
+    
+    // Копирование
+    Impl(const Impl& other) = default;
+    
+    // Из готовых компонентов (без повторной нормализации)
+    static Impl fromParts(const dspirit_parts& p) {
+        Impl result;
+        result.r_ = p.r;
+        result.i_ = p.i;
+        result.j_ = p.j;
+        result.level_ = p.level;
+        return result;
+    }
+    
+    dspirit_parts parts() const { return {r_, i_, j_, level_}; }
+    
+    // Методы доступа
+    double r() const { return r_; }
+    double i() const { return i_; }
+    double j() const { return j_; }
+    double level() const { return level_; }
+
+    // Вспомогательные методы
+    bool isApproxZero(double value) const {
+        return std::abs(value) < NEAR_ZERO;
+    }
+    
+    bool isApproxEqual(double a, double b) const {
+        return  std::abs(a - b) < epsilon;
+    }
+    
+    bool isApproxEqualLevel(double a, double b) const {
+        return std::abs(a - b) < epsilon * 0.1;
+    }
+    
+    void init(double value, double level = 0.0) {
+        if (isApproxZero(value)) {
+            // Для нуля используем еденицу в первом отрицательном слое
+            r_ = 1.0;  // Используем 0.0 вместо 1.0 для нуля
+            i_ = 0.0;
+            j_ = 0.0;
+            level_ = level - 1.0;
+        } else {
+            r_ = value;
+            i_ = 0.0;
+            j_ = 0.0;
+            level_ = level;
+        }
+    }
+    
+    void normalize() {
+        if (isApproxZero(r_)) {
+            if (!isApproxZero(i_)) {
+                r_ = i_;
+                i_ = j_;
+                j_ = 0.0;
+                level_ -= 1.0;
+            } else if (!isApproxZero(j_)) {
+                r_ = j_;
+                i_ = 0.0;
+                j_ = 0.0;
+                level_ -= 2.0;
+            } else {
+                // Все нули
+                r_ = 1.0;  // Устанавливаем r_ в 1 для нуля
+                i_ = 0.0;
+                j_ = 0.0;
+                level_ = DOUBLE_NEG_INF;  // суперноль
+            }
+            return;
+        }
+        resetLowerLevels();
+    }
+    
+    void resetLowerLevels() {
+        if (isApproxZero(i_)) i_ = 0.0;
+        if (isApproxZero(j_)) j_ = 0.0;
+    }
+    
+    double component(int k) const {
+        return (k == 0) ? r_ : (k == 1) ? i_ : j_;
+    }
+    
+    // Целое смещение уровня 0..2 или -1, если уровни не выровнены
+    int levelShift(double diff) const {
+        for (int k = 0; k < 3; ++k) {
+            if (std::abs(diff - k) < epsilon) return k;
+        }
+        return -1;
+    }
+    
+    static bool isSuperLevel(double level) {
+        return level == DOUBLE_POS_INF || level == DOUBLE_NEG_INF;
+    }
+    
+    // a * b + c: одной инструкцией при сборке с PARADOX_ENABLE_FMA.
+    // FP_FAST_FMA не используется: MSVC его не определяет даже с /arch:AVX2
+    static double fmadd(double a, double b, double c) {
+#ifdef PARADOX_ENABLE_FMA
+        return std::fma(a, b, c);
+#else
+        return a * b + c;
+#endif
+    }
+    
+    double atLevel(double target_level) const {
+        const double diff = level_ - target_level;
+        
+        if (std::abs(diff) < epsilon) return r_;
+        if (std::abs(diff - 1.0) < epsilon) return i_;
+        if (std::abs(diff - 2.0) < epsilon) return j_;
+        
+        return 0.0;
+    }
+    
+    // Проверки свойств (математически корректные)
+    bool isZero() const { return level_ < (-epsilon); }
+    bool isInfinity() const { return level_ > epsilon; }
+    bool isRegular() const { return std::abs(level_) < epsilon; }
+    
+    // Математически корректные проверки знака
+    bool isNegative() const { return !isZero() && r_ < 0.0; }
+    bool isPositive() const { return !isZero() && r_ > 0.0; }
+    bool isNonNegative() const { return isZero() || isPositive(); }
+    bool isNonPositive() const { return isZero() || isNegative(); }
+    
+    // Арифметические операции
+    Impl negate() const {
+        Impl result;
+        result.r_ = -r_;
+        result.i_ = -i_;
+        result.j_ = -j_;
+        result.level_ = level_;
+        return result;
+    }
+    
+    Impl add(const Impl& other) const {
+        
+        // Быстрый путь для одинаковых уровней
+        if (isApproxEqualLevel(level_, other.level_)) {
+            Impl result;
+            result.r_ = r_ + other.r_;
+            if(result.r_ == DOUBLE_POS_INF) return {1.0, level_ + 1};
+            if(result.r_ == DOUBLE_NEG_INF) return {-1.0, level_ + 1};
+            result.i_ = i_ + other.i_;
+            if(result.i_ == DOUBLE_POS_INF) return {result.r_, 1.0, 0.0, level_};
+            if(result.i_ == DOUBLE_NEG_INF) return {result.r_, -1.0, 0.0, level_};
+            result.j_ = j_ + other.j_;
+            if(result.j_ == DOUBLE_POS_INF) return {result.r_, result.i_, 1.0, level_};
+            if(result.j_ == DOUBLE_NEG_INF) return {result.r_, result.i_, -1.0, level_};
+            result.level_ = level_;
+            result.normalize();
+            return result;
+        }
+        
+        // Находим максимальный уровень
+        const double max_level = (level_ > other.level_) ? level_ : other.level_;
+        const double min_level = (level_ < other.level_) ? level_ : other.level_;
+        
+        // Если разница в уровнях больше 2, то меньшими уровнями можно пренебречь
+        if (max_level - min_level > 2.5f) {
+            return (level_ > other.level_) ? *this : other;
+        }
+        
+        // Суммируем значения на каждом уровне
+        const double sum_r = atLevel(max_level) + other.atLevel(max_level);
+        if(sum_r == DOUBLE_POS_INF) return {1.0, max_level + 1};
+        if(sum_r == DOUBLE_NEG_INF) return {-1.0, max_level + 1};
+        const double sum_i = atLevel(max_level - 1.0) + other.atLevel(max_level - 1.0);
+        if(sum_i == DOUBLE_POS_INF) return {sum_r, 1.0, 0.0, max_level};
+        if(sum_i == DOUBLE_NEG_INF) return {sum_r, -1.0, 0.0, max_level};
+        const double sum_j = atLevel(max_level - 2.0) + other.atLevel(max_level - 2.0);
+        if(sum_j == DOUBLE_POS_INF) return {sum_r, sum_i, 1.0, max_level};
+        if(sum_j == DOUBLE_NEG_INF) return {sum_r, sum_i, -1.0, max_level};
+        Impl result(sum_r, sum_i, sum_j, max_level);
+        result.normalize();
+        return result;
+    }
+    
+    Impl subtract(const Impl& other) const {
+        return add(other.negate());
+    }
+    
+    Impl multiply(const Impl& other) const {
+        if(other.level_ == DOUBLE_NEG_INF){
+            if(level_ == DOUBLE_POS_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_NEG_INF};
+        }
+
+        if(other.level_ == DOUBLE_POS_INF){
+            if(level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_POS_INF};
+        }
+
+        if(level_ == DOUBLE_NEG_INF){
+            if(other.level_ == DOUBLE_POS_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_NEG_INF};
+        }
+
+        if(level_ == DOUBLE_POS_INF){
+            if(other.level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_POS_INF};
+        }
+        // Умножение: уровни складываются
+        const double result_level = level_ + other.level_;
+    
+        const double result_r = r_ * other.r_;
+        // если переполнение то увеличиваем уровень и отправляем еденицу
+        if(result_r == DOUBLE_POS_INF) return {1.0, result_level + 1};
+        if(result_r == DOUBLE_NEG_INF) return {-1.0, result_level + 1};
+
+        const double result_i = fmadd(r_, other.i_, i_ * other.r_);
+        if(result_i == DOUBLE_POS_INF) return {result_r, 1.0, 0.0, result_level};
+        if(result_i == DOUBLE_NEG_INF) return {result_r, -1.0, 0.0, result_level};
+        
+        const double result_j = fmadd(r_, other.j_, fmadd(i_, other.i_, j_ * other.r_));
+        if(result_j == DOUBLE_POS_INF) return {result_r, result_i, 1.0, result_level};
+        if(result_j == DOUBLE_NEG_INF) return {result_r, result_i, -1.0, result_level};
+        
+        Impl result(result_r, result_i, result_j, result_level);
+        result.normalize();
+        return result;
+    }
+    
+    // this * other + addend: свёртка подуровней через FMA и одно выравнивание уровней
+    Impl fma(const Impl& other, const Impl& addend) const {
+        // Суперуровни - через обычные операции
+        if (isSuperLevel(level_) || isSuperLevel(other.level_) || isSuperLevel(addend.level_)) {
+            return multiply(other).add(addend);
+        }
+        
+        const double product_level = level_ + other.level_;
+        const double max_level = (product_level > addend.level_) ? product_level : addend.level_;
+        const double min_level = (product_level < addend.level_) ? product_level : addend.level_;
+        
+        // Младшее слагаемое пренебрежимо (как в add)
+        if (max_level - min_level > 2.5f) {
+            return (product_level > addend.level_) ? multiply(other) : addend;
+        }
+        
+        // Смещения слагаемых относительно старшего уровня (-1 - не выровнено)
+        const int product_shift = levelShift(max_level - product_level);
+        const int addend_shift = levelShift(max_level - addend.level_);
+        
+        double sum[3];
+        for (int k = 0; k < 3; ++k) {
+            const int m = k - addend_shift;
+            double acc = (addend_shift >= 0 && m >= 0) ? addend.component(m) : 0.0;
+            
+            const int q = k - product_shift;
+            if (product_shift >= 0 && q >= 0) {
+                // Коэффициент произведения при ω^(product_level - q)
+                if (q == 0) {
+                    acc = fmadd(r_, other.r_, acc);
+                } else if (q == 1) {
+                    acc = fmadd(r_, other.i_, fmadd(i_, other.r_, acc));
+                } else {
+                    acc = fmadd(r_, other.j_, fmadd(i_, other.i_, fmadd(j_, other.r_, acc)));
+                }
+            }
+            sum[k] = acc;
+        }
+        
+        // Переполнение: повышение уровня должно произойти в произведении,
+        // поэтому редкий случай считаем обычным путём
+        if (std::isinf(sum[0]) || std::isinf(sum[1]) || std::isinf(sum[2])) {
+            return multiply(other).add(addend);
+        }
+        return Impl(sum[0], sum[1], sum[2], max_level);
+    }
+    
+    Impl divide(const Impl& divisor) const {
+        if(divisor.level_ == DOUBLE_NEG_INF){
+            if(level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_POS_INF};
+        }
+
+        if(divisor.level_ == DOUBLE_POS_INF){
+            if(level_ == DOUBLE_POS_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_NEG_INF};
+        }
+
+        if(level_ == DOUBLE_NEG_INF){
+            if(divisor.level_ == DOUBLE_NEG_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_NEG_INF};
+        }
+
+        if(level_ == DOUBLE_POS_INF){
+            if(divisor.level_ == DOUBLE_POS_INF) return {1.0, 0.0};
+            return {1.0, DOUBLE_POS_INF};
+        }
+
+        const double result_level = level_ - divisor.level_;
+        
+        const double result_r = r_ / divisor.r_;
+        if(result_r == DOUBLE_POS_INF) return {1.0, result_level + 1};
+        if(result_r == DOUBLE_NEG_INF) return {-1.0, result_level + 1};
+       
+        const double result_i = (i_ - result_r * divisor.i_) /  divisor.r_;
+        if(result_i == DOUBLE_POS_INF) return {result_r, 1.0, 0.0, result_level};
+        if(result_i == DOUBLE_NEG_INF) return {result_r, -1.0, 0.0, result_level};
+       
+        const double result_j = ((j_ - result_r * divisor.j_) - result_i * divisor.i_) / divisor.r_;
+        if(result_j == DOUBLE_POS_INF) return {result_r, result_i, 1.0, result_level};
+        if(result_j == DOUBLE_NEG_INF) return {result_r, result_i, -1.0, result_level};
+        
+        Impl result(result_r, result_i, result_j, result_level);
+        result.normalize();
+        return result;
+    }
+
+    // Степени
+    static bool isIntegerExponent(double exponent) {
+        return std::abs(exponent) <= MAX_INTEGER_EXPONENT && exponent == std::floor(exponent);
+    }
+
+    // Квадратный корень: уровень делится пополам, подуровни - по ряду
+    // sqrt(r + i*t + j*t^2) = R + i/(2R)*t + (j - I^2)/(2R)*t^2, t = ω^-1.
+    // Знак не проверяется (ноль берётся по модулю), отрицательные - снаружи
+    Impl sqrt() const {
+        if (isSuperLevel(level_)) return {1.0, 0.0, 0.0, level_};
+
+        const double sign = (r_ < 0.0) ? -1.0 : 1.0;
+        const double root_r = std::sqrt(sign * r_);
+        const double root_i = sign * i_ / (2.0 * root_r);
+        const double root_j = (sign * j_ - root_i * root_i) / (2.0 * root_r);
+        return Impl(root_r, root_i, root_j, level_ * 0.5);
+    }
+
+    // Возведение в степень: целые - возведением в квадрат, дробные - по ряду
+    // (1 + a*t + b*t^2)^p = 1 + p*a*t + (p*b + p(p-1)/2*a^2)*t^2.
+    // Для дробной степени отрицательное основание проверяется снаружи
+    Impl pow(double exponent) const {
+        if (exponent == 0.0) return {1.0, 0.0};
+        if (exponent == 1.0) return *this;
+        if (exponent == 0.5) return sqrt();
+        if (isIntegerExponent(exponent)) return powInteger(exponent);
+
+        if (isSuperLevel(level_)) {
+            const bool grows = (level_ > 0.0) == (exponent > 0.0);
+            return {1.0, grows ? DOUBLE_POS_INF : DOUBLE_NEG_INF};
+        }
+
+        const double result_level = level_ * exponent;
+        const double sign = (r_ < 0.0) ? -1.0 : 1.0;
+        const double a = i_ / r_;
+        const double b = j_ / r_;
+
+        const double result_r = std::pow(sign * r_, exponent);
+        // Переполнение и потеря значимости - сдвигом уровня, как в multiply
+        if (result_r == DOUBLE_POS_INF) return {1.0, result_level + 1};
+        if (result_r == 0.0) return {1.0, result_level - 1};
+
+        const double result_i = result_r * exponent * a;
+        const double result_j = result_r * fmadd(exponent, b, 0.5 * exponent * (exponent - 1.0) * a * a);
+        Impl result(result_r, result_i, result_j, result_level);
+        result.normalize();
+        return result;
+    }
+
+    Impl powInteger(double exponent) const {
+        double n = std::abs(exponent);
+        Impl base = *this;
+        Impl result(1.0, 0.0);
+        while (true) {
+            if (std::fmod(n, 2.0) == 1.0) result = result.multiply(base);
+            n = std::floor(n * 0.5);
+            if (n == 0.0) break;
+            base = base.multiply(base);
+        }
+        return (exponent < 0.0) ? Impl(1.0, 0.0).divide(result) : result;
+    }
+
+    // Гладкая функция в окрестности точки at (0 для нулей, r для обычных):
+    // f(at + d) = f0 + f1*d + f2/2*d^2, d = this - at. Подуровни и
+    // бесконечно малые переносятся через обычную арифметику уровней
+    Impl taylor(double at, double f0, double f1, double f2) const {
+        if (std::isinf(f0)) return {(f0 > 0.0) ? 1.0 : -1.0, 1.0};
+
+        const Impl super_zero(1.0, DOUBLE_NEG_INF);
+        Impl result = isApproxZero(f0) ? super_zero : Impl(f0);
+        const Impl delta = (at == 0.0) ? *this : subtract(Impl(at));
+        if (delta.level_ == DOUBLE_NEG_INF) return result;
+
+        if (!isApproxZero(f1)) result = result.add(delta.multiply(Impl(f1)));
+        if (!isApproxZero(f2)) result = result.add(delta.multiply(delta).multiply(Impl(0.5 * f2)));
+        return result;
+    }
+
+    bool isPlain() const { return i_ == 0.0 && j_ == 0.0; }
+
+    // Обычное число, которое dspirit хранит без Pimpl: конечное, не
+    // пренебрежимо малое (иначе init превращает его в ноль)
+    static bool isPlainValue(double value) {
+        const double magnitude = std::abs(value);
+        return magnitude >= NEAR_ZERO && magnitude <= std::numeric_limits<double>::max();
+    }
+
+    bool isPlainRegular() const {
+        return level_ == 0.0 && i_ == 0.0 && j_ == 0.0 && isPlainValue(r_);
+    }
+
+    static Impl fromPlain(double value) { return fromParts({value, 0.0, 0.0, 0.0}); }
+
+    // Сравнения (математически корректные)
+    bool equals(const Impl& other) const {
+        // Все нули равны
+        if (isZero() && other.isZero()) return true;
+        
+        // Разные уровни (кроме нулей)
+        if (!isApproxEqualLevel(level_, other.level_)) return false;
+        
+        // Одинаковые уровни, сравниваем старшие значения
+        return isApproxEqual(r_, other.r_);
+    }
+    
+    bool lessThan(const Impl& other) const {
+        // Оба нуля
+        if (isZero() && other.isZero()) return false;
+        
+        // Текущее - ноль, другое - нет
+        if (isZero()) return other.isPositive();
+        
+        // Другое - ноль, текущее - нет
+        if (other.isZero()) return isNegative();
+        
+        // Оба не нули
+        // Сравнение уровней
+        if (!isApproxEqualLevel(level_, other.level_)) {
+            if (isPositive() && other.isPositive()) {
+                return level_ < other.level_;
+            }
+            if (isNegative() && other.isNegative()) {
+                return level_ > other.level_;
+            }
+            return isNegative() && other.isPositive();
+        }
+        
+        // Одинаковые уровни, сравниваем значения
+        if (!isApproxEqual(r_, other.r_)) {
+            return r_ < other.r_;
+        }
+        if (!isApproxEqual(i_, other.i_)) {
+            return i_ < other.i_;
+        }
+        return j_ < other.j_;
+    }
+    
+    // Преобразования
+    double toDouble() const {
+        if (isZero()) return 0.0;
+        if (isInfinity()) {
+            return (r_ > 0.0) ? std::numeric_limits<double>::infinity()
+                               : -std::numeric_limits<double>::infinity();
+        }
+        return static_cast<double>(r_);
+    }
+    
+    float toFloat() const {
+        if (isZero()) return 0.0;
+        if (isInfinity()) {
+            return (r_ > 0.0) ? std::numeric_limits<float>::infinity()
+                               : -std::numeric_limits<float>::infinity();
+        }
+        return static_cast<float>(r_);
+    }
+    
+    // Создание из строки (без исключений)
+    static status parseSimple(const std::string& s, Impl& out) {
+        std::string str = s;
+        
+        str.erase(std::remove_if(str.begin(), str.end(), 
+                  [](unsigned char c) { return std::isspace(c); }), 
+                  str.end());
+        
+        if (str.empty()) { out = Impl(0.0); return status::ok; }
+        
+        if (str == "0" || str == "0.0") { out = Impl(0.0); return status::ok; }
+        if (str == "inf" || str == "Inf" || str == "INF") { out = Impl(1.0, 1.0); return status::ok; }
+        if (str == "-inf" || str == "-Inf" || str == "-INF") { out = Impl(-1.0, 1.0); return status::ok; }
+        if (str == "1" || str == "1.0") { out = Impl(1.0); return status::ok; }
+        if (str == "-1" || str == "-1.0") { out = Impl(-1.0); return status::ok; }
+        
+        // Как std::stod: разбирается префикс, переполнение - ошибка
+        errno = 0;
+        char* end = nullptr;
+        const double value = std::strtod(str.c_str(), &end);
+        if (end == str.c_str() || errno == ERANGE) return status::invalid_argument;
+        out = Impl(value, 0.0);
+        return status::ok;
+    }
+    
+    static Impl fromStringSimple(const std::string& s) {
+        Impl result;
+        if (parseSimple(s, result) != status::ok) {
+            detail::raise(status::invalid_argument, ("Cannot parse: " + s).c_str());
+        }
+        return result;
+    }
+};
+
+namespace detail {
+
+// Доступ к реализации для внутренних модулей (пакетные ядра, массивы)
+struct impl_access {
+    using Impl = dspirit::Impl;
+
+    static Impl get(const dspirit& x) { return x.pimpl ? *x.pimpl : Impl::fromPlain(x.value_); }
+
+    // Обычное число - без выделения памяти
+    static dspirit make(const Impl& impl) {
+        return impl.isPlainRegular() ? plain(impl.r()) : dspirit(new Impl(impl));
+    }
+
+    static dspirit plain(double value) {
+        dspirit result(static_cast<Impl*>(nullptr));
+        result.value_ = value;
+        return result;
+    }
+
+    // Запись в существующее значение без лишних выделений
+    static void assign(dspirit& x, const Impl& impl) {
+        if (impl.isPlainRegular()) {
+            delete x.pimpl;
+            x.pimpl = nullptr;
+            x.value_ = impl.r();
+        } else if (x.pimpl) {
+            *x.pimpl = impl;
+        } else {
+            x.pimpl = new Impl(impl);
+        }
+    }
+};
+
+using Impl = impl_access::Impl;
+
+// Разбор текста в Impl (ядро dspirit::from_chars)
+std::from_chars_result parseChars(const char* first, const char* last, Impl& value);
+
+// Запись Impl в текст (ядро dspirit::to_chars)
+std::to_chars_result formatChars(char* first, char* last, const Impl& value, text_format format);
+
+} // namespace detail
+
+} // namespace paradox
+
+#endif // PARADOX_DSPIRIT_IMPL_H
@@ -0,0 +1,359 @@
+#include "paradox/fast.h"
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace paradox {
+namespace fast {
+
+using detail::Impl;
+
+namespace {
+
+const dspirit_parts PARTS_ZERO = {1.0, 0.0, 0.0, -1.0};
+const dspirit_parts PARTS_ONE = {1.0, 0.0, 0.0, 0.0};
+const dspirit_parts PARTS_INF = {1.0, 0.0, 0.0, 1.0};
+const dspirit_parts PARTS_NEG_INF = {-1.0, 0.0, 0.0, 1.0};
+
+// Константы Коди-Уэйта: старшие части точно умножаются на целое
+const double LN2_HI = 6.93147180369123816490e-01;
+const double LN2_LO = 1.90821492927058770002e-10;
+const double INV_LN2_64 = 92.332482616893656;  // 64 / ln 2
+const double PIO2_1 = 1.57079632673412561417e+00;
+const double PIO2_2 = 6.07710050630396597660e-11;
+const double PIO2_3 = 2.02226624871116645580e-21;
+const double PIO2_3T = 8.47842766036889956997e-32;
+const double TWO_OVER_PI = 6.36619772367581382433e-01;
+const double REDUCTION_LIMIT = 1e6;
+
+// Минимакс-коэффициенты (алгоритм Ремеза, взвешенная относительная ошибка):
+// e^r = 1 + r + r^2 * P(r), |r| <= ln2/128; ошибка приближения 1.3e-17
+const double EXP_P0 = 0.49999999999999145;
+const double EXP_P1 = 0.16666666668137875;
+const double EXP_P2 = 0.04166670034004857;
+const double EXP_P3 = 0.008331480779321493;
+
+// ln m = 2s * (1 + z * Q(z)), z = s^2 <= (3 - 2 sqrt(2))^2; ошибка 5.5e-23
+const double LOG_Q0 = 0.3333333333333333;
+const double LOG_Q1 = 0.19999999999999968;
+const double LOG_Q2 = 0.14285714285729276;
+const double LOG_Q3 = 0.11111111107675223;
+const double LOG_Q4 = 0.09090909536041321;
+const double LOG_Q5 = 0.07692272914902996;
+const double LOG_Q6 = 0.06668336131794791;
+const double LOG_Q7 = 0.05834315191370901;
+const double LOG_Q8 = 0.06017102505723084;
+
+// sin r = r + r^3 * S(z), cos r = 1 - z/2 + z^2 * C(z), z = r^2 <= (pi/4)^2;
+// ошибка 1.9e-21 и 2.2e-23
+const double SIN_S0 = -0.16666666666666666;
+const double SIN_S1 = 0.008333333333333323;
+const double SIN_S2 = -0.00019841269841255137;
+const double SIN_S3 = 2.755731921422707e-06;
+const double SIN_S4 = -2.505210492133247e-08;
+const double SIN_S5 = 1.6058367893376285e-10;
+const double SIN_S6 = -7.578761782701907e-13;
+const double COS_C0 = 0.041666666666666664;
+const double COS_C1 = -0.0013888888888888874;
+const double COS_C2 = 2.480158730157154e-05;
+const double COS_C3 = -2.755731921539446e-07;
+const double COS_C4 = 2.08767543703609e-09;
+const double COS_C5 = -1.1470293743874207e-11;
+const double COS_C6 = 4.738130617915108e-14;
+
+double fromBits(std::uint64_t bits) {
+    double x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+std::uint64_t toBits(double x) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+// 2^(k/64), k = 0..63 (округлены до ближайшего double)
+const double EXP2_TABLE[64] = {
+    1.0, 1.0108892860517005, 1.0218971486541166, 1.0330248790212284,
+    1.0442737824274138, 1.0556451783605572, 1.0671404006768237, 1.0787607977571199,
+    1.0905077326652577, 1.102382583307841, 1.1143867425958924, 1.1265216186082418,
+    1.1387886347566916, 1.1511892299529827, 1.1637248587775775, 1.1763969916502812,
+    1.189207115002721, 1.202156731452703, 1.215247359980469, 1.22848053610687,
+    1.241857812073484, 1.255380757024691, 1.2690509571917332, 1.2828700160787783,
+    1.2968395546510096, 1.3109612115247644, 1.3252366431597413, 1.339667524053303,
+    1.3542555469368927, 1.3690024229745905, 1.383909881963832, 1.3989796725383112,
+    1.4142135623730951, 1.42961333839197, 1.4451808069770467, 1.460917794180647,
+    1.4768261459394993, 1.4929077282912648, 1.5091644275934228, 1.5255981507445384,
+    1.5422108254079407, 1.559004400237837, 1.5759808451078865, 1.593142151342267,
+    1.6104903319492543, 1.6280274218573478, 1.645755478153965, 1.6636765803267364,
+    1.681792830507429, 1.7001063537185235, 1.718619298122478, 1.7373338352737062,
+    1.7562521603732995, 1.7753764925265212, 1.7947090750031072, 1.8142521755003989,
+    1.8340080864093424, 1.8539791250833855, 1.8741676341103, 1.8945759815869656,
+    1.9152065613971474, 1.9360617934922943, 1.9571441241754002, 1.978456026387951
+};
+
+// Округление до целого без вызова libm (режим округления по умолчанию)
+const double ROUND_SHIFTER = 6755399441055744.0;  // 1.5 * 2^52
+
+double roundNearest(double x) {
+    return (x + ROUND_SHIFTER) - ROUND_SHIFTER;
+}
+
+// e^x = 2^m * 2^(i/64) * e^r, |r| <= ln2/128
+double expApprox(double x) {
+    if (x > 709.782712893384) return std::numeric_limits<double>::infinity();
+    if (x < -745.1332191019411) return 0.0;
+    if (x != x) return x;
+
+    const double kd = roundNearest(x * INV_LN2_64);
+    const long k = static_cast<long>(kd);
+    const double r = (x - kd * (LN2_HI / 64)) - kd * (LN2_LO / 64);
+    // e^r - 1: минимакс-полином, T + T*p точнее, чем T * (1 + p)
+    const double p = r + r * r * (EXP_P0 + r * (EXP_P1 + r * (EXP_P2 + r * EXP_P3)));
+
+    const long i = k & 63;
+    const long m = (k - i) >> 6;
+    const double value = EXP2_TABLE[i] + EXP2_TABLE[i] * p;
+    if (m >= -1022 && m <= 1023) {
+        return value * fromBits(static_cast<std::uint64_t>(m + 1023) << 52);
+    }
+    return std::ldexp(value, static_cast<int>(m));
+}
+
+// ln x = e*ln2 + 2*atanh(s), s = (m - 1)/(m + 1), m в [sqrt(2)/2, sqrt(2))
+double logApprox(double x) {
+    int e = 0;
+    if (x < std::numeric_limits<double>::min()) {
+        x *= 18014398509481984.0;  // 2^54: денормализованные
+        e = -54;
+    }
+    const std::uint64_t bits = toBits(x);
+    e += static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+    double m = fromBits((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+    if (m > 1.4142135623730951) {
+        m *= 0.5;
+        ++e;
+    }
+
+    // 2s = f - s*f, поэтому ln m = f - (f^2/2 - s * (f^2/2 + R)): точное f
+    // несёт старшие биты, ошибки округления - только в малой поправке
+    const double f = m - 1.0;
+    const double s = f / (2.0 + f);
+    const double z = s * s;
+    const double R = 2.0 * z * (LOG_Q0 + z * (LOG_Q1 + z * (LOG_Q2 + z * (LOG_Q3 + z * (LOG_Q4
+                   + z * (LOG_Q5 + z * (LOG_Q6 + z * (LOG_Q7 + z * LOG_Q8))))))));
+    const double hfsq = 0.5 * f * f;
+    return e * LN2_HI - ((hfsq - (s * (hfsq + R) + e * LN2_LO)) - f);
+}
+
+// sin и cos на [-pi/4, pi/4] от r + lo, |lo| <= ulp(r): младшая часть
+// редукции учитывается первым членом ряда (как в fdlibm)
+double sinPoly(double r, double lo) {
+    const double z = r * r;
+    const double v = z * r;
+    const double p = SIN_S1 + z * (SIN_S2 + z * (SIN_S3 + z * (SIN_S4 + z * (SIN_S5 + z * SIN_S6))));
+    return r - ((z * (0.5 * lo - v * p) - lo) - v * SIN_S0);
+}
+
+// 1 - z/2 с ошибкой округления, возвращённой в младшие члены
+double cosPoly(double r, double lo) {
+    const double z = r * r;
+    const double p = COS_C0 + z * (COS_C1 + z * (COS_C2 + z * (COS_C3 + z * (COS_C4 + z * (COS_C5
+                   + z * COS_C6)))));
+    const double hz = 0.5 * z;
+    const double w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + (z * z * p - r * lo));
+}
+
+// x = q*pi/2 + r + lo; возвращает q mod 4. q * PIO2_1 и q * PIO2_2 точны,
+// ошибки вычитаний собираются в lo
+int reduce(double x, double& r, double& lo) {
+    const double q = roundNearest(x * TWO_OVER_PI);
+    const double t = x - q * PIO2_1;
+    const double w = q * PIO2_2;
+    const double r1 = t - w;
+    const double tail = q * PIO2_3 + q * PIO2_3T;
+    r = r1 - tail;
+    lo = ((r1 - r) - tail) + ((t - r1) - w);
+    return static_cast<int>(static_cast<long>(q) & 3);
+}
+
+// Выбор квадранта без ветвлений: q нечётное - sin и cos меняются местами,
+// q & 2 - смена знака
+double sinApprox(double x) {
+    if (!(std::abs(x) < REDUCTION_LIMIT)) return std::sin(x);
+    double r, lo;
+    const int q = reduce(x, r, lo);
+    const double s = sinPoly(r, lo);
+    const double c = cosPoly(r, lo);
+    const double v = (q & 1) ? c : s;
+    return (q & 2) ? -v : v;
+}
+
+double cosApprox(double x) {
+    if (!(std::abs(x) < REDUCTION_LIMIT)) return std::cos(x);
+    double r, lo;
+    const int q = reduce(x, r, lo);
+    const double s = sinPoly(r, lo);
+    const double c = cosPoly(r, lo);
+    const double v = (q & 1) ? s : c;
+    return ((q + 1) & 2) ? -v : v;
+}
+
+double tanApprox(double x) {
+    if (!(std::abs(x) < REDUCTION_LIMIT)) return std::tan(x);
+    double r, lo;
+    const int q = reduce(x, r, lo);
+    const double s = sinPoly(r, lo);
+    const double c = cosPoly(r, lo);
+    return (q & 1) ? -c / s : s / c;
+}
+
+template <class Fn>
+std::size_t applyChecked(const_dspirit_view x, dspirit_view out, std::uint64_t* failed, Fn fn) {
+    if (x.size != out.size) detail::raise(status::size_mismatch, "dspirit_array: size mismatch");
+    if (failed) std::fill(failed, failed + statusWords(out.size), std::uint64_t(0));
+
+    const dspirit_parts nan = {std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0};
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < out.size; ++k) {
+        dspirit_parts value;
+        if (fn(x[k], value) != status::ok) {
+            value = nan;
+            ++count;
+            if (failed) failed[k / 64] |= std::uint64_t(1) << (k % 64);
+        }
+        out.store(k, value);
+    }
+    return count;
+}
+
+template <class Fn>
+dspirit checkedValue(const dspirit& x, Fn fn, const char* message) {
+    dspirit_parts out;
+    if (fn(x.toParts(), out) != status::ok) detail::raise(status::domain_error, message);
+    return dspirit::fromParts(out);
+}
+
+} // namespace
+
+// Над компонентами
+status exp(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = Impl::fromParts(x);
+    if (v.isZero()) out = PARTS_ONE;
+    else if (v.isInfinity()) out = v.isNegative() ? PARTS_ZERO : PARTS_INF;
+    else out = Impl(expApprox(v.toDouble())).parts();
+    return status::ok;
+}
+
+status log(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = Impl::fromParts(x);
+    if (v.isZero()) { out = PARTS_NEG_INF; return status::ok; }
+    if (v.isInfinity()) { out = PARTS_INF; return status::ok; }
+    if (v.isNegative()) return status::domain_error;
+    out = Impl(logApprox(v.toDouble())).parts();
+    return status::ok;
+}
+
+status sin(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = Impl::fromParts(x);
+    if (v.isInfinity()) return status::domain_error;
+    out = Impl(sinApprox(v.toDouble())).parts();
+    return status::ok;
+}
+
+status cos(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = Impl::fromParts(x);
+    if (v.isInfinity()) return status::domain_error;
+    out = Impl(cosApprox(v.toDouble())).parts();
+    return status::ok;
+}
+
+status tan(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = Impl::fromParts(x);
+    if (v.isInfinity()) return status::domain_error;
+    out = Impl(tanApprox(v.toDouble())).parts();
+    return status::ok;
+}
+
+status pow(const dspirit_parts& x, double exponent, dspirit_parts& out) noexcept {
+    // Уровни, подуровни и тривиальные степени - точным путём
+    const Impl v = Impl::fromParts(x);
+    if (!v.isRegular() || !v.isPlain() || exponent == 0.0 || exponent == 1.0) {
+        return kernel::pow(x, exponent, out);
+    }
+
+    const bool integer = Impl::isIntegerExponent(exponent);
+    if (v.r() < 0.0 && !integer) return status::domain_error;
+
+    const double magnitude = expApprox(exponent * logApprox(std::abs(v.r())));
+    const bool odd = integer && std::fmod(exponent, 2.0) != 0.0;
+    const double sign = (v.r() < 0.0 && odd) ? -1.0 : 1.0;
+
+    // Переполнение и потеря значимости - сдвигом уровня, как в точном pow
+    if (magnitude == std::numeric_limits<double>::infinity()) out = {sign, 0.0, 0.0, 1.0};
+    else if (magnitude == 0.0) out = PARTS_ZERO;
+    else out = Impl(sign * magnitude).parts();
+    return status::ok;
+}
+
+// Над dspirit
+dspirit exp(const dspirit& x) {
+    return checkedValue(x, [](const dspirit_parts& v, dspirit_parts& r) { return exp(v, r); }, "exp");
+}
+
+dspirit log(const dspirit& x) {
+    return checkedValue(x, [](const dspirit_parts& v, dspirit_parts& r) { return log(v, r); },
+                        "log of negative number");
+}
+
+dspirit sin(const dspirit& x) {
+    return checkedValue(x, [](const dspirit_parts& v, dspirit_parts& r) { return sin(v, r); }, "sin of infinity");
+}
+
+dspirit cos(const dspirit& x) {
+    return checkedValue(x, [](const dspirit_parts& v, dspirit_parts& r) { return cos(v, r); }, "cos of infinity");
+}
+
+dspirit tan(const dspirit& x) {
+    return checkedValue(x, [](const dspirit_parts& v, dspirit_parts& r) { return tan(v, r); }, "tan of infinity");
+}
+
+dspirit pow(const dspirit& x, double exponent) {
+    return checkedValue(x, [exponent](const dspirit_parts& v, dspirit_parts& r) { return pow(v, exponent, r); },
+                        "fractional power of negative number");
+}
+
+// Пакетные варианты
+std::size_t exp(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return exp(v, r); });
+}
+
+std::size_t log(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return log(v, r); });
+}
+
+std::size_t sin(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return sin(v, r); });
+}
+
+std::size_t cos(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return cos(v, r); });
+}
+
+std::size_t tan(const_dspirit_view x, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [](const dspirit_parts& v, dspirit_parts& r) { return tan(v, r); });
+}
+
+std::size_t pow(const_dspirit_view x, double exponent, dspirit_view out, std::uint64_t* failed) {
+    return applyChecked(x, out, failed, [exponent](const dspirit_parts& v, dspirit_parts& r) {
+        return pow(v, exponent, r);
+    });
+}
+
+} // namespace fast
+} // namespace paradox
@@ -0,0 +1,364 @@
+#include "paradox/graph.h"
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+#include <cstring>
+#include <functional>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+// Строк в одном блоке вычисления
+const std::size_t BLOCK = 256;
+
+const std::uint32_t NONE = 0;
+const std::size_t NEVER = static_cast<std::size_t>(-1);
+
+dspirit_view slot(double* workspace, std::uint32_t s, std::size_t count) {
+    double* base = workspace + static_cast<std::size_t>(s) * 4 * BLOCK;
+    return {base, base + BLOCK, base + 2 * BLOCK, base + 3 * BLOCK, count};
+}
+
+bool isCommutative(expr_graph::op code) {
+    return code == expr_graph::op::add || code == expr_graph::op::multiply;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// expr_graph
+
+std::size_t expr_graph::key_hash::operator()(const node_data& n) const {
+    std::uint64_t bits[4];
+    std::memcpy(bits, &n.value, sizeof(bits));
+
+    std::size_t h = static_cast<std::size_t>(n.code);
+    auto mix = [&h](std::uint64_t v) {
+        h ^= std::hash<std::uint64_t>()(v) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    };
+    mix(n.a);
+    mix(n.b);
+    mix(n.c);
+    for (std::uint64_t v : bits) mix(v);
+    return h;
+}
+
+bool expr_graph::key_equal::operator()(const node_data& x, const node_data& y) const {
+    return x.code == y.code && x.a == y.a && x.b == y.b && x.c == y.c &&
+           std::memcmp(&x.value, &y.value, sizeof(dspirit_parts)) == 0;
+}
+
+graph_node expr_graph::intern(const node_data& n) {
+    auto found = index_.find(n);
+    if (found != index_.end()) return graph_node(this, found->second);
+
+    const std::uint32_t id = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back(n);
+    index_.emplace(n, id);
+    return graph_node(this, id);
+}
+
+std::uint32_t expr_graph::own(graph_node x) const {
+    if (x.graph() != this) {
+        detail::raise(status::invalid_argument, "expr_graph: node belongs to another graph");
+    }
+    return x.index();
+}
+
+graph_node expr_graph::input(const std::string& name) {
+    std::uint32_t number = 0;
+    while (number < inputs_.size() && inputs_[number] != name) ++number;
+    if (number == inputs_.size()) inputs_.push_back(name);
+    return intern({op::input, number, NONE, NONE, {0.0, 0.0, 0.0, 0.0}});
+}
+
+graph_node expr_graph::constant(const dspirit& value) {
+    return intern({op::constant, NONE, NONE, NONE, value.toParts()});
+}
+
+graph_node expr_graph::apply(op code, graph_node a) {
+    if (code < op::negate || code > op::tan) {
+        detail::raise(status::invalid_argument, "expr_graph: operation is not unary");
+    }
+    return intern({code, own(a), NONE, NONE, {0.0, 0.0, 0.0, 0.0}});
+}
+
+graph_node expr_graph::apply(op code, graph_node a, graph_node b) {
+    if (code < op::add || code > op::divide) {
+        detail::raise(status::invalid_argument, "expr_graph: operation is not binary");
+    }
+    std::uint32_t x = own(a);
+    std::uint32_t y = own(b);
+    if (isCommutative(code) && y < x) std::swap(x, y);
+    return intern({code, x, y, NONE, {0.0, 0.0, 0.0, 0.0}});
+}
+
+graph_node expr_graph::apply(op code, graph_node a, graph_node b, graph_node c) {
+    if (code != op::fma) {
+        detail::raise(status::invalid_argument, "expr_graph: operation is not ternary");
+    }
+    std::uint32_t x = own(a);
+    std::uint32_t y = own(b);
+    if (y < x) std::swap(x, y);
+    return intern({code, x, y, own(c), {0.0, 0.0, 0.0, 0.0}});
+}
+
+graph_node expr_graph::power(graph_node base, double exponent) {
+    return intern({op::pow, own(base), NONE, NONE, {exponent, 0.0, 0.0, 0.0}});
+}
+
+graph_program expr_graph::compile(const std::vector<graph_node>& outputs) const {
+    const std::size_t n = nodes_.size();
+
+    // Достижимые узлы (операнды всегда имеют меньшие номера)
+    std::vector<bool> live(n, false);
+    for (graph_node out : outputs) live[own(out)] = true;
+    for (std::size_t k = n; k-- > 0;) {
+        if (!live[k]) continue;
+        const node_data& x = nodes_[k];
+        switch (x.code) {
+        case op::input:
+        case op::constant:
+            break;
+        case op::fma:
+            live[x.c] = true;
+            // fallthrough
+        case op::add:
+        case op::subtract:
+        case op::multiply:
+        case op::divide:
+            live[x.b] = true;
+            // fallthrough
+        default:
+            live[x.a] = true;
+        }
+    }
+
+    // Последнее использование каждого узла
+    std::vector<std::size_t> last_use(n, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        if (!live[k]) continue;
+        const node_data& x = nodes_[k];
+        if (x.code == op::input || x.code == op::constant) continue;
+        last_use[x.a] = k;
+        if (x.code >= op::add) last_use[x.b] = k;
+        if (x.code == op::fma) last_use[x.c] = k;
+    }
+    for (graph_node out : outputs) last_use[out.index()] = NEVER;
+
+    // Назначение слотов со свободным списком
+    graph_program program;
+    program.input_count_ = inputs_.size();
+
+    std::vector<std::uint32_t> slot_of(n, 0);
+    std::vector<std::uint32_t> free_slots;
+    auto release = [&](std::uint32_t node, std::size_t at) {
+        if (last_use[node] == at) free_slots.push_back(slot_of[node]);
+    };
+
+    for (std::size_t k = 0; k < n; ++k) {
+        if (!live[k]) continue;
+        const node_data& x = nodes_[k];
+
+        graph_program::instruction ins = {x.code, 0, 0, 0, 0, x.value};
+        if (x.code == op::input) {
+            ins.a = x.a;
+        } else if (x.code != op::constant) {
+            ins.a = slot_of[x.a];
+            if (x.code >= op::add) ins.b = slot_of[x.b];
+            if (x.code == op::fma) ins.c = slot_of[x.c];
+
+            // Поэлементные операции допускают запись в слот операнда
+            release(x.a, k);
+            if (x.code >= op::add && x.b != x.a) release(x.b, k);
+            if (x.code == op::fma && x.c != x.a && x.c != x.b) release(x.c, k);
+        }
+
+        if (free_slots.empty()) {
+            slot_of[k] = static_cast<std::uint32_t>(program.slot_count_++);
+        } else {
+            slot_of[k] = free_slots.back();
+            free_slots.pop_back();
+        }
+        ins.dst = slot_of[k];
+        program.code_.push_back(ins);
+    }
+
+    for (graph_node out : outputs) program.outputs_.push_back(slot_of[out.index()]);
+    return program;
+}
+
+// ---------------------------------------------------------------------------
+// graph_program
+
+void graph_program::run(const std::vector<const_dspirit_view>& inputs,
+                        const std::vector<dspirit_view>& outputs,
+                        std::size_t first, std::size_t count, double* workspace) const {
+    using op = expr_graph::op;
+
+    for (const instruction& ins : code_) {
+        const dspirit_view dst = slot(workspace, ins.dst, count);
+        const dspirit_view a = slot(workspace, ins.a, count);
+        const dspirit_view b = slot(workspace, ins.b, count);
+        const dspirit_view c = slot(workspace, ins.c, count);
+
+        switch (ins.code) {
+        case op::input: {
+            const const_dspirit_view& in = inputs[ins.a];
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, in[first + k]);
+            break;
+        }
+        case op::constant:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, ins.value);
+            break;
+        case op::negate:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, Impl::fromParts(a[k]).negate().parts());
+            break;
+        case op::abs:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::abs(a[k]));
+            break;
+        case op::sqrt:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::sqrt(a[k]));
+            break;
+        case op::exp:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::exp(a[k]));
+            break;
+        case op::log:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::log(a[k]));
+            break;
+        case op::sin:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::sin(a[k]));
+            break;
+        case op::cos:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::cos(a[k]));
+            break;
+        case op::tan:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::tan(a[k]));
+            break;
+        case op::pow:
+            for (std::size_t k = 0; k < count; ++k) dst.store(k, kernel::pow(a[k], ins.value.r));
+            break;
+        case op::add:
+            for (std::size_t k = 0; k < count; ++k) {
+                dst.store(k, Impl::fromParts(a[k]).add(Impl::fromParts(b[k])).parts());
+            }
+            break;
+        case op::subtract:
+            for (std::size_t k = 0; k < count; ++k) {
+                dst.store(k, Impl::fromParts(a[k]).subtract(Impl::fromParts(b[k])).parts());
+            }
+            break;
+        case op::multiply:
+            for (std::size_t k = 0; k < count; ++k) {
+                dst.store(k, Impl::fromParts(a[k]).multiply(Impl::fromParts(b[k])).parts());
+            }
+            break;
+        case op::divide:
+            for (std::size_t k = 0; k < count; ++k) {
+                dst.store(k, Impl::fromParts(a[k]).divide(Impl::fromParts(b[k])).parts());
+            }
+            break;
+        case op::fma:
+            for (std::size_t k = 0; k < count; ++k) {
+                const Impl x = Impl::fromParts(a[k]);
+                dst.store(k, x.fma(Impl::fromParts(b[k]), Impl::fromParts(c[k])).parts());
+            }
+            break;
+        }
+    }
+
+    for (std::size_t o = 0; o < outputs_.size(); ++o) {
+        const dspirit_view src = slot(workspace, outputs_[o], count);
+        for (std::size_t k = 0; k < count; ++k) outputs[o].store(first + k, src[k]);
+    }
+}
+
+void graph_program::evaluate(const std::vector<const_dspirit_view>& inputs,
+                             const std::vector<dspirit_view>& outputs) const {
+    if (inputs.size() != input_count_ || outputs.size() != outputs_.size()) {
+        detail::raise(status::invalid_argument, "graph_program: wrong number of columns");
+    }
+    const std::size_t rows = outputs.empty() ? 0 : outputs[0].size;
+    for (const const_dspirit_view& in : inputs) {
+        if (in.size != rows) detail::raise(status::size_mismatch, "graph_program: size mismatch");
+    }
+    for (const dspirit_view& out : outputs) {
+        if (out.size != rows) detail::raise(status::size_mismatch, "graph_program: size mismatch");
+    }
+
+    std::vector<double> workspace(slot_count_ * 4 * BLOCK);
+    for (std::size_t first = 0; first < rows; first += BLOCK) {
+        const std::size_t count = (rows - first < BLOCK) ? rows - first : BLOCK;
+        run(inputs, outputs, first, count, workspace.data());
+    }
+}
+
+std::vector<dspirit> graph_program::evaluate(const std::vector<dspirit>& inputs) const {
+    if (inputs.size() != input_count_) {
+        detail::raise(status::invalid_argument, "graph_program: wrong number of inputs");
+    }
+
+    std::vector<dspirit_parts> in(inputs.size());
+    std::vector<const_dspirit_view> in_views(inputs.size());
+    for (std::size_t k = 0; k < inputs.size(); ++k) {
+        in[k] = inputs[k].toParts();
+        in_views[k] = {&in[k].r, &in[k].i, &in[k].j, &in[k].level, 1};
+    }
+
+    std::vector<dspirit_parts> out(outputs_.size());
+    std::vector<dspirit_view> out_views(outputs_.size());
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        out_views[k] = {&out[k].r, &out[k].i, &out[k].j, &out[k].level, 1};
+    }
+
+    std::vector<double> workspace(slot_count_ * 4 * BLOCK);
+    run(in_views, out_views, 0, 1, workspace.data());
+
+    std::vector<dspirit> result;
+    result.reserve(out.size());
+    for (const dspirit_parts& p : out) result.push_back(dspirit::fromParts(p));
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Построение графа операторами
+
+namespace {
+
+expr_graph& graphOf(graph_node x) {
+    if (!x.valid()) detail::raise(status::invalid_argument, "expr_graph: empty node");
+    return *x.graph();
+}
+
+} // namespace
+
+graph_node operator-(graph_node x) { return graphOf(x).apply(expr_graph::op::negate, x); }
+graph_node operator+(graph_node lhs, graph_node rhs) { return graphOf(lhs).apply(expr_graph::op::add, lhs, rhs); }
+graph_node operator-(graph_node lhs, graph_node rhs) { return graphOf(lhs).apply(expr_graph::op::subtract, lhs, rhs); }
+graph_node operator*(graph_node lhs, graph_node rhs) { return graphOf(lhs).apply(expr_graph::op::multiply, lhs, rhs); }
+graph_node operator/(graph_node lhs, graph_node rhs) { return graphOf(lhs).apply(expr_graph::op::divide, lhs, rhs); }
+
+graph_node operator+(graph_node lhs, const dspirit& rhs) { return lhs + graphOf(lhs).constant(rhs); }
+graph_node operator-(graph_node lhs, const dspirit& rhs) { return lhs - graphOf(lhs).constant(rhs); }
+graph_node operator*(graph_node lhs, const dspirit& rhs) { return lhs * graphOf(lhs).constant(rhs); }
+graph_node operator/(graph_node lhs, const dspirit& rhs) { return lhs / graphOf(lhs).constant(rhs); }
+
+graph_node operator+(const dspirit& lhs, graph_node rhs) { return graphOf(rhs).constant(lhs) + rhs; }
+graph_node operator-(const dspirit& lhs, graph_node rhs) { return graphOf(rhs).constant(lhs) - rhs; }
+graph_node operator*(const dspirit& lhs, graph_node rhs) { return graphOf(rhs).constant(lhs) * rhs; }
+graph_node operator/(const dspirit& lhs, graph_node rhs) { return graphOf(rhs).constant(lhs) / rhs; }
+
+graph_node abs(graph_node x) { return graphOf(x).apply(expr_graph::op::abs, x); }
+graph_node sqrt(graph_node x) { return graphOf(x).apply(expr_graph::op::sqrt, x); }
+graph_node exp(graph_node x) { return graphOf(x).apply(expr_graph::op::exp, x); }
+graph_node log(graph_node x) { return graphOf(x).apply(expr_graph::op::log, x); }
+graph_node sin(graph_node x) { return graphOf(x).apply(expr_graph::op::sin, x); }
+graph_node cos(graph_node x) { return graphOf(x).apply(expr_graph::op::cos, x); }
+graph_node tan(graph_node x) { return graphOf(x).apply(expr_graph::op::tan, x); }
+graph_node pow(graph_node x, double exponent) { return graphOf(x).power(x, exponent); }
+graph_node fma(graph_node a, graph_node b, graph_node c) { return graphOf(a).apply(expr_graph::op::fma, a, b, c); }
+
+} // namespace paradox
@@ -0,0 +1,344 @@
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+namespace paradox {
+namespace kernel {
+
+using detail::Impl;
+
+namespace {
+
+const dspirit_parts PARTS_ZERO = {1.0, 0.0, 0.0, -1.0};
+const dspirit_parts PARTS_ONE = {1.0, 0.0, 0.0, 0.0};
+const dspirit_parts PARTS_INF = {1.0, 0.0, 0.0, 1.0};
+const dspirit_parts PARTS_NEG_INF = {-1.0, 0.0, 0.0, 1.0};
+
+Impl wrap(const dspirit_parts& x) { return Impl::fromParts(x); }
+
+} // namespace
+
+// Создание
+dspirit_parts make(double value) { return Impl(value).parts(); }
+
+// Арифметика
+dspirit_parts negate(const dspirit_parts& x) { return wrap(x).negate().parts(); }
+
+dspirit_parts add(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).add(wrap(b)).parts();
+}
+
+dspirit_parts subtract(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).subtract(wrap(b)).parts();
+}
+
+dspirit_parts multiply(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).multiply(wrap(b)).parts();
+}
+
+dspirit_parts divide(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).divide(wrap(b)).parts();
+}
+
+dspirit_parts fma(const dspirit_parts& a, const dspirit_parts& b, const dspirit_parts& c) {
+    return wrap(a).fma(wrap(b), wrap(c)).parts();
+}
+
+dspirit_parts abs(const dspirit_parts& x) {
+    return isNegative(x) ? negate(x) : x;
+}
+
+dspirit_parts inverse(const dspirit_parts& x) {
+    if (isZero(x)) return PARTS_INF;
+    return divide(PARTS_ONE, x);
+}
+
+// Сравнения
+bool equals(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).equals(wrap(b));
+}
+
+bool less(const dspirit_parts& a, const dspirit_parts& b) {
+    return wrap(a).lessThan(wrap(b));
+}
+
+// Проверки свойств
+bool isZero(const dspirit_parts& x) { return wrap(x).isZero(); }
+bool isInfinity(const dspirit_parts& x) { return wrap(x).isInfinity(); }
+bool isNegative(const dspirit_parts& x) { return wrap(x).isNegative(); }
+
+// Преобразования
+double toDouble(const dspirit_parts& x) { return wrap(x).toDouble(); }
+
+// Математические функции (без исключений)
+// Нули и бесконечности берутся по модулю (как и раньше), ошибка области
+// определения - только для отрицательных конечных чисел
+status sqrt(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isNegative(x) && !isInfinity(x)) return status::domain_error;
+    out = wrap(x).sqrt().parts();
+    return status::ok;
+}
+
+status pow(const dspirit_parts& x, double exponent, dspirit_parts& out) noexcept {
+    // Дробная степень отрицательного числа не определена
+    if (isNegative(x) && !isInfinity(x) && !Impl::isIntegerExponent(exponent)) {
+        return status::domain_error;
+    }
+    out = wrap(x).pow(exponent).parts();
+    return status::ok;
+}
+
+status exp(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isZero(x)) out = PARTS_ONE;
+    else if (isInfinity(x)) out = isNegative(x) ? PARTS_ZERO : PARTS_INF;
+    else out = make(std::exp(toDouble(x)));
+    return status::ok;
+}
+
+status log(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isZero(x)) { out = PARTS_NEG_INF; return status::ok; }
+    if (isInfinity(x)) { out = PARTS_INF; return status::ok; }
+    if (isNegative(x)) return status::domain_error;
+    out = make(std::log(toDouble(x)));
+    return status::ok;
+}
+
+status sin(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isInfinity(x)) return status::domain_error;
+    out = make(std::sin(toDouble(x)));
+    return status::ok;
+}
+
+status cos(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isInfinity(x)) return status::domain_error;
+    out = make(std::cos(toDouble(x)));
+    return status::ok;
+}
+
+status tan(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    if (isInfinity(x)) return status::domain_error;
+    out = make(std::tan(toDouble(x)));
+    return status::ok;
+}
+
+// Расширенные функции (без исключений). Бесконечности - по асимптотике,
+// нули и подуровни - по ряду Тейлора в окрестности 0 или r
+status sinh(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isInfinity()) out = v.isNegative() ? PARTS_NEG_INF : PARTS_INF;
+    else if (v.isZero()) out = v.taylor(0.0, 0.0, 1.0, 0.0).parts();
+    else if (v.isPlain()) out = v.taylor(0.0, std::sinh(v.r()), 0.0, 0.0).parts();
+    else out = v.taylor(v.r(), std::sinh(v.r()), std::cosh(v.r()), std::sinh(v.r())).parts();
+    return status::ok;
+}
+
+status cosh(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isInfinity()) out = PARTS_INF;
+    else if (v.isZero()) out = v.taylor(0.0, 1.0, 0.0, 1.0).parts();
+    else if (v.isPlain()) out = v.taylor(0.0, std::cosh(v.r()), 0.0, 0.0).parts();
+    else out = v.taylor(v.r(), std::cosh(v.r()), std::sinh(v.r()), std::cosh(v.r())).parts();
+    return status::ok;
+}
+
+status tanh(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isInfinity()) {
+        out = make(v.isNegative() ? -1.0 : 1.0);
+    } else if (v.isZero()) {
+        out = v.taylor(0.0, 0.0, 1.0, 0.0).parts();
+    } else {
+        const double t = std::tanh(v.r());
+        const double d = 1.0 - t * t;
+        out = v.isPlain() ? make(t) : v.taylor(v.r(), t, d, -2.0 * t * d).parts();
+    }
+    return status::ok;
+}
+
+status cbrt(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isRegular()) {
+        const double c = std::cbrt(v.r());
+        out = v.isPlain() ? make(c) : v.taylor(v.r(), c, c / (3.0 * v.r()), -2.0 * c / (9.0 * v.r() * v.r())).parts();
+    } else {
+        // Уровень делится на 3, знак сохраняется
+        out = (v.r() < 0.0) ? v.negate().pow(1.0 / 3.0).negate().parts() : v.pow(1.0 / 3.0).parts();
+    }
+    return status::ok;
+}
+
+status erf(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const double two_over_sqrt_pi = 1.1283791670955126;
+    const Impl v = wrap(x);
+    if (v.isInfinity()) {
+        out = make(v.isNegative() ? -1.0 : 1.0);
+    } else if (v.isZero()) {
+        out = v.taylor(0.0, 0.0, two_over_sqrt_pi, 0.0).parts();
+    } else if (v.isPlain()) {
+        out = make(std::erf(v.r()));
+    } else {
+        const double d = two_over_sqrt_pi * std::exp(-v.r() * v.r());
+        out = v.taylor(v.r(), std::erf(v.r()), d, -2.0 * v.r() * d).parts();
+    }
+    return status::ok;
+}
+
+status log1p(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isZero()) { out = v.taylor(0.0, 0.0, 1.0, -1.0).parts(); return status::ok; }
+    // Бесконечности и окрестность -1 - через log(1 + x)
+    if (v.isInfinity() || v.r() <= -1.0) return log(add(PARTS_ONE, x), out);
+    const double d = 1.0 / (1.0 + v.r());
+    out = v.isPlain() ? make(std::log1p(v.r())) : v.taylor(v.r(), std::log1p(v.r()), d, -d * d).parts();
+    return status::ok;
+}
+
+status expm1(const dspirit_parts& x, dspirit_parts& out) noexcept {
+    const Impl v = wrap(x);
+    if (v.isInfinity()) {
+        out = v.isNegative() ? make(-1.0) : PARTS_INF;
+    } else if (v.isZero()) {
+        out = v.taylor(0.0, 0.0, 1.0, 1.0).parts();
+    } else if (v.isPlain()) {
+        out = v.taylor(0.0, std::expm1(v.r()), 0.0, 0.0).parts();
+    } else {
+        const double e = std::exp(v.r());
+        out = v.taylor(v.r(), std::expm1(v.r()), e, e).parts();
+    }
+    return status::ok;
+}
+
+// Функции двух аргументов
+dspirit_parts atan2(const dspirit_parts& y, const dspirit_parts& x) {
+    const double pi = 3.14159265358979323846;
+    const Impl a = wrap(y);
+    const Impl b = wrap(x);
+    const double sign = (a.r() < 0.0) ? -1.0 : 1.0;
+    const double super_zero = -std::numeric_limits<double>::infinity();
+
+    // Точные нули (суперноль)
+    if (a.level() == super_zero) return (b.r() > 0.0 || b.level() == super_zero) ? y : make(pi);
+    if (b.level() == super_zero) return make(sign * pi / 2);
+
+    // y бесконечно больше x: ±π/2 - x/y
+    if (a.level() > b.level() && !Impl::isSuperLevel(b.level())) {
+        return Impl(sign * pi / 2).subtract(b.divide(a)).parts();
+    }
+    // x бесконечно больше y: y/x или ±π + y/x
+    if (b.level() > a.level() && !Impl::isSuperLevel(a.level())) {
+        const Impl q = a.divide(b);
+        return (b.r() > 0.0) ? q.parts() : Impl(sign * pi).add(q).parts();
+    }
+
+    // Один уровень: atan2 старших частей плюс поправка подуровней отношения
+    const double angle = std::atan2(a.r(), b.r());
+    if (a.isPlain() && b.isPlain()) return make(angle);
+    const Impl q = a.divide(b);
+    const double q0 = a.r() / b.r();
+    const double d = 1.0 / (1.0 + q0 * q0);
+    return q.taylor(q0, angle, d, -2.0 * q0 * d * d).parts();
+}
+
+dspirit_parts hypot(const dspirit_parts& x, const dspirit_parts& y) {
+    Impl a = Impl::fromParts(abs(x));
+    Impl b = Impl::fromParts(abs(y));
+    // Порядок по уровню и |r| точно: lessThan сравнивает r с допуском и
+    // не различает малые числа
+    if (b.level() > a.level() || (b.level() == a.level() && b.r() > a.r())) std::swap(a, b);
+    if (b.level() == -std::numeric_limits<double>::infinity()) return a.parts();
+
+    // |a| * sqrt(1 + (b/a)^2): отношение не больше 1, переполнения double нет.
+    // Отношение вне обычных чисел (b/a ниже NEAR_ZERO) - общим путём
+    const Impl q = b.divide(a);
+    if (a.isPlain() && b.isPlain() && q.isPlainRegular()) {
+        return a.multiply(Impl(std::sqrt(1.0 + q.r() * q.r()))).parts();
+    }
+    return a.multiply(Impl(1.0).add(q.multiply(q)).sqrt()).parts();
+}
+
+// Математические функции
+dspirit_parts sqrt(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (sqrt(x, out) != status::ok) detail::raise(status::domain_error, "sqrt of negative number");
+    return out;
+}
+
+dspirit_parts pow(const dspirit_parts& x, double exponent) {
+    dspirit_parts out;
+    if (pow(x, exponent, out) != status::ok) detail::raise(status::domain_error, "fractional power of negative number");
+    return out;
+}
+
+dspirit_parts exp(const dspirit_parts& x) {
+    dspirit_parts out;
+    exp(x, out);
+    return out;
+}
+
+dspirit_parts log(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (log(x, out) != status::ok) detail::raise(status::domain_error, "log of negative number");
+    return out;
+}
+
+dspirit_parts sin(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (sin(x, out) != status::ok) detail::raise(status::domain_error, "sin of infinity");
+    return out;
+}
+
+dspirit_parts cos(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (cos(x, out) != status::ok) detail::raise(status::domain_error, "cos of infinity");
+    return out;
+}
+
+dspirit_parts tan(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (tan(x, out) != status::ok) detail::raise(status::domain_error, "tan of infinity");
+    return out;
+}
+
+dspirit_parts sinh(const dspirit_parts& x) {
+    dspirit_parts out;
+    sinh(x, out);
+    return out;
+}
+
+dspirit_parts cosh(const dspirit_parts& x) {
+    dspirit_parts out;
+    cosh(x, out);
+    return out;
+}
+
+dspirit_parts tanh(const dspirit_parts& x) {
+    dspirit_parts out;
+    tanh(x, out);
+    return out;
+}
+
+dspirit_parts cbrt(const dspirit_parts& x) {
+    dspirit_parts out;
+    cbrt(x, out);
+    return out;
+}
+
+dspirit_parts erf(const dspirit_parts& x) {
+    dspirit_parts out;
+    erf(x, out);
+    return out;
+}
+
+dspirit_parts log1p(const dspirit_parts& x) {
+    dspirit_parts out;
+    if (log1p(x, out) != status::ok) detail::raise(status::domain_error, "log1p of number less than -1");
+    return out;
+}
+
+dspirit_parts expm1(const dspirit_parts& x) {
+    dspirit_parts out;
+    expm1(x, out);
+    return out;
+}
+
+} // namespace kernel
+} // namespace paradox
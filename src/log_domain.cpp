@@ -0,0 +1,184 @@
+#include "paradox/log_domain.h"
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+const double POS_INF = std::numeric_limits<double>::infinity();
+
+const log_dspirit LOG_ZERO = {0.0, -1.0, 1.0};
+const log_dspirit LOG_SUPER_ZERO = {0.0, -POS_INF, 1.0};
+
+bool isSuperLevel(double level) {
+    return std::isinf(level);
+}
+
+// Уровни совпадают (как Impl::isApproxEqualLevel)
+bool sameLevel(double a, double b) {
+    return std::abs(a - b) < DBL_EPSILON;
+}
+
+// Редкие случаи - через обычную арифметику
+log_dspirit viaParts(const dspirit_parts& value) {
+    return log_dspirit::fromParts(value);
+}
+
+} // namespace
+
+log_dspirit log_dspirit::fromParts(const dspirit_parts& value) noexcept {
+    if (isSuperLevel(value.level)) return {0.0, value.level, value.r < 0.0 ? -1.0 : 1.0};
+    return {std::log(std::abs(value.r)), value.level, value.r < 0.0 ? -1.0 : 1.0};
+}
+
+log_dspirit log_dspirit::fromDspirit(const dspirit& value) {
+    return fromParts(value.toParts());
+}
+
+log_dspirit log_dspirit::fromLog(double value) noexcept {
+    if (value == -POS_INF) return LOG_ZERO;
+    if (value == POS_INF) return {0.0, 1.0, 1.0};
+    return {value, 0.0, 1.0};
+}
+
+dspirit_parts log_dspirit::toParts() const noexcept {
+    if (isSuperLevel(level)) return {sign, 0.0, 0.0, level};
+    if (std::isnan(magnitude)) return {magnitude, 0.0, 0.0, level};
+
+    const double r = sign * std::exp(magnitude);
+    if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, level};
+    if (magnitude > 0.0) return {sign, 0.0, 0.0, level + 1.0};
+    return {1.0, 0.0, 0.0, level - 1.0};
+}
+
+dspirit log_dspirit::toDspirit() const {
+    return dspirit::fromParts(toParts());
+}
+
+log_dspirit operator-(const log_dspirit& x) {
+    return {x.magnitude, x.level, -x.sign};
+}
+
+log_dspirit operator*(const log_dspirit& a, const log_dspirit& b) {
+    if (isSuperLevel(a.level) || isSuperLevel(b.level)) {
+        return viaParts(kernel::multiply(a.toParts(), b.toParts()));
+    }
+    return {a.magnitude + b.magnitude, a.level + b.level, a.sign * b.sign};
+}
+
+log_dspirit operator/(const log_dspirit& a, const log_dspirit& b) {
+    if (isSuperLevel(a.level) || isSuperLevel(b.level)) {
+        return viaParts(kernel::divide(a.toParts(), b.toParts()));
+    }
+    return {a.magnitude - b.magnitude, a.level - b.level, a.sign * b.sign};
+}
+
+log_dspirit operator+(const log_dspirit& a, const log_dspirit& b) {
+    if (isSuperLevel(a.level) || isSuperLevel(b.level)) {
+        return viaParts(kernel::add(a.toParts(), b.toParts()));
+    }
+    // Младший уровень попал бы только в подуровни
+    if (!sameLevel(a.level, b.level)) return (a.level > b.level) ? a : b;
+
+    const log_dspirit& hi = (a.magnitude >= b.magnitude) ? a : b;
+    const log_dspirit& lo = (a.magnitude >= b.magnitude) ? b : a;
+    const double ratio = std::exp(lo.magnitude - hi.magnitude);
+    if (hi.sign == lo.sign) return {hi.magnitude + std::log1p(ratio), hi.level, hi.sign};
+    // Полное сокращение - суперноль, как в Impl::add
+    if (ratio == 1.0) return LOG_SUPER_ZERO;
+    return {hi.magnitude + std::log1p(-ratio), hi.level, hi.sign};
+}
+
+log_dspirit operator-(const log_dspirit& a, const log_dspirit& b) {
+    return a + (-b);
+}
+
+status pow(const log_dspirit& x, double exponent, log_dspirit& out) noexcept {
+    if (x.sign < 0.0 && exponent != std::floor(exponent)) return status::domain_error;
+    if (isSuperLevel(x.level)) {
+        dspirit_parts result;
+        const status code = kernel::pow(x.toParts(), exponent, result);
+        if (code == status::ok) out = viaParts(result);
+        return code;
+    }
+    const double sign = (x.sign < 0.0 && std::fmod(exponent, 2.0) != 0.0) ? -1.0 : 1.0;
+    out = {x.magnitude * exponent, x.level * exponent, sign};
+    return status::ok;
+}
+
+log_dspirit pow(const log_dspirit& x, double exponent) {
+    log_dspirit result;
+    if (pow(x, exponent, result) != status::ok) {
+        detail::raise(status::domain_error, "fractional power of negative number");
+    }
+    return result;
+}
+
+log_dspirit logSumExp(const log_dspirit* x, std::size_t n) {
+    if (n == 0) return LOG_ZERO;
+
+    // Редкий случай: попарное сложение с правилами суперуровней
+    for (std::size_t k = 0; k < n; ++k) {
+        if (isSuperLevel(x[k].level)) {
+            log_dspirit total = x[0];
+            for (std::size_t m = 1; m < n; ++m) total = total + x[m];
+            return total;
+        }
+    }
+
+    // Слагаемые старшего уровня ниже bound; если они точно сокращаются,
+    // сумма определяется следующим уровнем
+    double bound = POS_INF;
+    for (;;) {
+        // Проход 1: старший уровень и наибольший логарифм на нём
+        bool found = false;
+        double top = 0.0;
+        double max = 0.0;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (!(x[k].level < bound) || sameLevel(x[k].level, bound)) continue;
+            if (found && sameLevel(x[k].level, top)) {
+                if (x[k].magnitude > max) max = x[k].magnitude;
+            } else if (!found || x[k].level > top) {
+                found = true;
+                top = x[k].level;
+                max = x[k].magnitude;
+            }
+        }
+        if (!found) return LOG_SUPER_ZERO;
+
+        // Проход 2: сумма со сдвигом на max (слагаемые не больше 1)
+        double sum = 0.0;
+        for (std::size_t k = 0; k < n; ++k) {
+            if (sameLevel(x[k].level, top)) sum += x[k].sign * std::exp(x[k].magnitude - max);
+        }
+        if (sum != 0.0) return {max + std::log(std::abs(sum)), top, sum < 0.0 ? -1.0 : 1.0};
+        bound = top;
+    }
+}
+
+log_dspirit product(const log_dspirit* x, std::size_t n) {
+    log_dspirit total = {0.0, 0.0, 1.0};
+    for (std::size_t k = 0; k < n; ++k) total = total * x[k];
+    return total;
+}
+
+namespace batch {
+
+void toLogDomain(const_dspirit_view x, log_dspirit* out) {
+    for (std::size_t k = 0; k < x.size; ++k) out[k] = log_dspirit::fromParts(x[k]);
+}
+
+void fromLogDomain(const log_dspirit* x, dspirit_view out) {
+    for (std::size_t k = 0; k < out.size; ++k) out.store(k, x[k].toParts());
+}
+
+} // namespace batch
+
+} // namespace paradox
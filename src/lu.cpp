@@ -0,0 +1,256 @@
+#include "paradox/lu.h"
+#include "dspirit_impl.h"
+#include "matrix_block.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+// Ширина полосы, раскладываемой поэлементно
+const std::size_t BASE = 8;
+
+// Число обновлений элементов, начиная с которого работа делится между потоками
+const std::size_t PARALLEL_UPDATES = 1 << 16;
+
+// Столбцов U (и правых частей) на поток
+const std::size_t COLUMNS_PER_THREAD = 16;
+
+bool isPlainParts(const dspirit_parts& x) {
+    return x.level == 0.0 && x.i == 0.0 && x.j == 0.0 && Impl::isPlainValue(x.r);
+}
+
+bool isSuperZero(const dspirit_parts& x) {
+    return x.level == -std::numeric_limits<double>::infinity();
+}
+
+// |a| > |b| с учётом уровня: сначала уровень, затем старшая часть
+bool largerMagnitude(const dspirit_parts& a, const dspirit_parts& b) {
+    if (std::abs(a.level - b.level) >= DBL_EPSILON) return a.level > b.level;
+    return std::abs(a.r) > std::abs(b.r);
+}
+
+// a - l * u
+dspirit_parts subtractProduct(const dspirit_parts& a, const dspirit_parts& l, const dspirit_parts& u) {
+    if (isPlainParts(a) && isPlainParts(l) && isPlainParts(u)) {
+        const double r = a.r - l.r * u.r;
+        if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, 0.0};
+    }
+    return Impl::fromParts(a).subtract(Impl::fromParts(l).multiply(Impl::fromParts(u))).parts();
+}
+
+// a / d
+dspirit_parts divideParts(const dspirit_parts& a, const dspirit_parts& d) {
+    if (isPlainParts(a) && isPlainParts(d)) {
+        const double r = a.r / d.r;
+        if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, 0.0};
+    }
+    return Impl::fromParts(a).divide(Impl::fromParts(d)).parts();
+}
+
+void swapRows(dspirit_matrix& a, std::size_t i, std::size_t k) {
+    for (std::size_t j = 0; j < a.cols(); ++j) {
+        const dspirit_parts x = a.parts(i, j);
+        a.set(i, j, a.parts(k, j));
+        a.set(k, j, x);
+    }
+}
+
+// Поэлементное разложение полосы: столбцы [k0, k0 + nb), строки [k0, n)
+void factorStrip(dspirit_matrix& a, std::size_t k0, std::size_t nb, std::vector<std::size_t>& pivots,
+                 bool& singular, unsigned threads) {
+    const std::size_t n = a.rows();
+    const std::size_t end = k0 + nb;
+    for (std::size_t j = k0; j < end; ++j) {
+        // Ведущий элемент
+        std::size_t p = j;
+        dspirit_parts pivot = a.parts(j, j);
+        for (std::size_t i = j + 1; i < n; ++i) {
+            const dspirit_parts x = a.parts(i, j);
+            if (largerMagnitude(x, pivot)) {
+                pivot = x;
+                p = i;
+            }
+        }
+        pivots[j] = p;
+        if (p != j) swapRows(a, j, p);
+        if (isSuperZero(pivot)) {
+            singular = true;
+            continue;
+        }
+
+        // Множители L и обновление оставшихся столбцов панели
+        const std::size_t rows = n - j - 1;
+        const unsigned count = (rows * (end - j) < PARALLEL_UPDATES) ? 1 : threads;
+        detail::parallelFor(rows, count, 64, [&](std::size_t begin, std::size_t stop) {
+            for (std::size_t i = j + 1 + begin; i < j + 1 + stop; ++i) {
+                const dspirit_parts l = divideParts(a.parts(i, j), pivot);
+                a.set(i, j, l);
+                for (std::size_t c = j + 1; c < end; ++c) a.set(i, c, subtractProduct(a.parts(i, c), l, a.parts(j, c)));
+            }
+        });
+    }
+}
+
+// Строки [k0, k0 + nb) столбцов [c0, c0 + nc): x = L^-1 x, где L - единичная
+// нижняя треугольная часть блока [k0, k0 + nb)^2
+void solveLower(dspirit_matrix& a, std::size_t k0, std::size_t nb, std::size_t c0, std::size_t nc,
+                unsigned threads) {
+    if (nb > BASE) {
+        const std::size_t half = nb / 2;
+        solveLower(a, k0, half, c0, nc, threads);
+        detail::gemmBlock({&a, k0 + half, k0, nb - half, half}, {&a, k0, c0, half, nc},
+                          a, k0 + half, c0, true, threads);
+        solveLower(a, k0 + half, nb - half, c0, nc, threads);
+        return;
+    }
+
+    const unsigned count = (nc * nb * nb / 2 < PARALLEL_UPDATES) ? 1 : threads;
+    detail::parallelFor(nc, count, COLUMNS_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = c0 + begin; c < c0 + end; ++c) {
+            for (std::size_t j = k0; j < k0 + nb; ++j) {
+                const dspirit_parts u = a.parts(j, c);
+                for (std::size_t i = j + 1; i < k0 + nb; ++i) a.set(i, c, subtractProduct(a.parts(i, c), a.parts(i, j), u));
+            }
+        }
+    });
+}
+
+// Рекурсивное разложение столбцов [k0, k0 + nb) (строки [k0, n)):
+// левая половина, затем правая после обновления через gemm
+void factorColumns(dspirit_matrix& a, std::size_t k0, std::size_t nb, std::vector<std::size_t>& pivots,
+                   bool& singular, unsigned threads) {
+    if (nb <= BASE) {
+        factorStrip(a, k0, nb, pivots, singular, threads);
+        return;
+    }
+
+    const std::size_t half = nb / 2;
+    const std::size_t right = k0 + half;
+    factorColumns(a, k0, half, pivots, singular, threads);
+
+    // Перестановки строк уже применены ко всей матрице
+    solveLower(a, k0, half, right, nb - half, threads);
+    detail::gemmBlock({&a, right, k0, a.rows() - right, half}, {&a, k0, right, half, nb - half},
+                      a, right, right, true, threads);
+    factorColumns(a, right, nb - half, pivots, singular, threads);
+}
+
+// Прямой и обратный ход для одной правой части: get(i) и set(i, value)
+// обращаются к её элементам
+template <class Get, class Set>
+void substitute(const dspirit_matrix& lu, const std::vector<std::size_t>& pivots, Get get, Set set) {
+    const std::size_t n = lu.rows();
+    for (std::size_t k = 0; k < n; ++k) {
+        if (pivots[k] == k) continue;
+        const dspirit_parts x = get(k);
+        set(k, get(pivots[k]));
+        set(pivots[k], x);
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        dspirit_parts x = get(i);
+        for (std::size_t k = 0; k < i; ++k) x = subtractProduct(x, lu.parts(i, k), get(k));
+        set(i, x);
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        dspirit_parts x = get(i);
+        for (std::size_t k = i + 1; k < n; ++k) x = subtractProduct(x, lu.parts(i, k), get(k));
+        set(i, divideParts(x, lu.parts(i, i)));
+    }
+}
+
+void checkSize(std::size_t a, std::size_t b) {
+    if (a != b) {
+        detail::raise(status::size_mismatch, "dspirit_lu: size mismatch");
+    }
+}
+
+} // namespace
+
+dspirit_lu::dspirit_lu(const dspirit_matrix& a, unsigned threads) : lu_(a) {
+    factor(threads);
+}
+
+dspirit_lu::dspirit_lu(dspirit_matrix&& a, unsigned threads) : lu_(std::move(a)) {
+    factor(threads);
+}
+
+void dspirit_lu::factor(unsigned threads) {
+    if (lu_.rows() != lu_.cols()) {
+        detail::raise(status::size_mismatch, "dspirit_lu: matrix must be square");
+    }
+    const std::size_t n = lu_.rows();
+    pivots_.assign(n, 0);
+    singular_ = false;
+
+    factorColumns(lu_, 0, n, pivots_, singular_, threads);
+}
+
+dspirit dspirit_lu::determinant() const {
+    Impl result(1.0);
+    for (std::size_t k = 0; k < size(); ++k) {
+        result = result.multiply(Impl::fromParts(lu_.parts(k, k)));
+        if (pivots_[k] != k) result = result.negate();
+    }
+    return dspirit::fromParts(result.parts());
+}
+
+void dspirit_lu::solve(const_dspirit_view b, dspirit_view x) const {
+    checkSize(b.size, size());
+    checkSize(x.size, size());
+    if (singular_) detail::raise(status::domain_error, "dspirit_lu: singular matrix");
+
+    if (x.r != b.r) {
+        for (std::size_t k = 0; k < size(); ++k) x.store(k, b[k]);
+    }
+    substitute(lu_, pivots_,
+               [&](std::size_t i) { return x[i]; },
+               [&](std::size_t i, const dspirit_parts& value) { x.store(i, value); });
+}
+
+dspirit_array dspirit_lu::solve(const dspirit_array& b) const {
+    dspirit_array x(b.view());
+    solve(x.view(), x.view());
+    return x;
+}
+
+dspirit_matrix dspirit_lu::solve(const dspirit_matrix& b, unsigned threads) const {
+    checkSize(b.rows(), size());
+    if (singular_) detail::raise(status::domain_error, "dspirit_lu: singular matrix");
+
+    dspirit_matrix x(b);
+    detail::parallelFor(x.cols(), threads, COLUMNS_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t j = begin; j < end; ++j) {
+            substitute(lu_, pivots_,
+                       [&](std::size_t i) { return x.parts(i, j); },
+                       [&](std::size_t i, const dspirit_parts& value) { x.set(i, j, value); });
+        }
+    });
+    return x;
+}
+
+dspirit_matrix dspirit_lu::inverse(unsigned threads) const {
+    return solve(dspirit_matrix::identity(size(), lu_.layout()), threads);
+}
+
+dspirit_array solve(const dspirit_matrix& a, const dspirit_array& b, unsigned threads) {
+    return dspirit_lu(a, threads).solve(b);
+}
+
+dspirit determinant(const dspirit_matrix& a, unsigned threads) {
+    return dspirit_lu(a, threads).determinant();
+}
+
+dspirit_matrix inverse(const dspirit_matrix& a, unsigned threads) {
+    return dspirit_lu(a, threads).inverse(threads);
+}
+
+} // namespace paradox
@@ -0,0 +1,97 @@
+#include "mapped_file.h"
+
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace paradox {
+namespace detail {
+
+status mapFile(const std::string& path, file_mapping& out) {
+    out = file_mapping();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return status::io_error;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        return status::io_error;
+    }
+    out.bytes = static_cast<std::size_t>(length.QuadPart);
+    if (out.bytes == 0) {
+        CloseHandle(file);
+        return status::ok;
+    }
+    out.handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!out.handle) return status::io_error;
+    out.data = static_cast<const unsigned char*>(MapViewOfFile(out.handle, FILE_MAP_READ, 0, 0, 0));
+    if (!out.data) {
+        unmapFile(out);
+        return status::io_error;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return status::io_error;
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return status::io_error;
+    }
+    out.bytes = static_cast<std::size_t>(info.st_size);
+    if (out.bytes == 0) {
+        ::close(fd);
+        return status::ok;
+    }
+    void* mapped = ::mmap(nullptr, out.bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        out = file_mapping();
+        return status::io_error;
+    }
+    out.data = static_cast<const unsigned char*>(mapped);
+#endif
+    return status::ok;
+}
+
+void unmapFile(file_mapping& mapping) {
+#ifdef _WIN32
+    if (mapping.data) UnmapViewOfFile(mapping.data);
+    if (mapping.handle) CloseHandle(mapping.handle);
+#else
+    if (mapping.data) ::munmap(const_cast<unsigned char*>(mapping.data), mapping.bytes);
+#endif
+    mapping = file_mapping();
+}
+
+void adviseWillNeed(const void* data, std::size_t bytes) {
+#ifndef _WIN32
+    if (!data || bytes == 0) return;
+    const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(data) / page * page;
+    const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(data) + bytes;
+    ::madvise(reinterpret_cast<void*>(first), last - first, MADV_WILLNEED);
+#else
+    (void)data;
+    (void)bytes;
+#endif
+}
+
+void adviseSequential(const file_mapping& mapping) {
+#ifndef _WIN32
+    if (mapping.data) ::madvise(const_cast<unsigned char*>(mapping.data), mapping.bytes, MADV_SEQUENTIAL);
+#else
+    (void)mapping;
+#endif
+}
+
+} // namespace detail
+} // namespace paradox
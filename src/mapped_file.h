@@ -0,0 +1,50 @@
+#ifndef PARADOX_MAPPED_FILE_H
+#define PARADOX_MAPPED_FILE_H
+
+// Внутренний заголовок: отображение файла в память только для чтения
+// (mmap или MapViewOfFile).
+
+#include "paradox/status.h"
+
+#include <cstddef>
+#include <string>
+
+namespace paradox {
+namespace detail {
+
+struct file_mapping {
+    const unsigned char* data = nullptr;
+    std::size_t bytes = 0;
+    void* handle = nullptr;  // объект отображения Windows
+};
+
+// status::io_error, если файл не открывается или не отображается.
+// Пустой файл отображается как data == nullptr, bytes == 0.
+status mapFile(const std::string& path, file_mapping& out);
+void unmapFile(file_mapping& mapping);
+
+// Владелец отображения: unmapFile в деструкторе, в том числе при исключении
+class scoped_mapping {
+public:
+    scoped_mapping() = default;
+    ~scoped_mapping() { unmapFile(mapping_); }
+    scoped_mapping(const scoped_mapping&) = delete;
+    scoped_mapping& operator=(const scoped_mapping&) = delete;
+
+    file_mapping& get() { return mapping_; }
+    const file_mapping& get() const { return mapping_; }
+
+private:
+    file_mapping mapping_;
+};
+
+// Подсказка ОС заранее прочитать страницы [data, data + bytes)
+void adviseWillNeed(const void* data, std::size_t bytes);
+
+// Подсказка о последовательном чтении всего отображения
+void adviseSequential(const file_mapping& mapping);
+
+} // namespace detail
+} // namespace paradox
+
+#endif // PARADOX_MAPPED_FILE_H
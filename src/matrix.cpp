@@ -0,0 +1,361 @@
+#include "paradox/matrix.h"
+#include "dspirit_impl.h"
+#include "matrix_block.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace paradox {
+
+using detail::Impl;
+using detail::matrix_block;
+
+namespace {
+
+// Размеры блоков: микроядро MR x NR, блоки a - MC x KC, b - KC x NC
+const std::size_t MR = 4;
+const std::size_t NR = 8;
+const std::size_t MC = 64;
+const std::size_t NC = 256;
+const std::size_t KC = 256;
+
+// Число умножений, начиная с которого работа делится между потоками
+const double PARALLEL_WORK = 1.0e6;
+
+// Строк на поток в gemv
+const std::size_t ROWS_PER_THREAD = 64;
+
+const dspirit_parts PARTS_ZERO = {1.0, 0.0, 0.0, -1.0};
+
+// Блок, упакованный полосами шириной width: элемент p на шаге k
+// лежит в ((p / width) * kc + k) * width + p % width
+struct packed_panel {
+    std::vector<double> r;
+    std::vector<double> i;
+    std::vector<double> j;
+    double level = 0.0;  // старший уровень блока
+    bool fast = false;   // все уровни ниже старшего на 0, 1 или 2
+    bool hasI = false;   // плоскость i не нулевая
+    bool hasJ = false;   // плоскость j не нулевая
+};
+
+// Сдвиг уровня относительно старшего: 0, 1, 2 или -1 (не выровнен)
+int levelOffset(double top, double level) {
+    const double diff = top - level;
+    for (int k = 0; k < 3; ++k) {
+        if (std::abs(diff - k) < DBL_EPSILON) return k;
+    }
+    return -1;
+}
+
+// Упаковка m x kc элементов get(p, k) с выравниванием к старшему уровню.
+// Суперноль упаковывается нулём (в быстром пути нет суперуровня +inf,
+// с которым его произведение не ноль). Если уровни не выравниваются,
+// panel.fast = false
+template <class Get>
+void pack(packed_panel& panel, std::size_t m, std::size_t kc, std::size_t width, Get get) {
+    const double SUPER_ZERO = -std::numeric_limits<double>::infinity();
+    panel.fast = false;
+
+    double top = SUPER_ZERO;
+    for (std::size_t p = 0; p < m; ++p) {
+        for (std::size_t k = 0; k < kc; ++k) {
+            const double level = get(p, k).level;
+            if (level == SUPER_ZERO) continue;
+            if (Impl::isSuperLevel(level) || std::isnan(level)) return;
+            top = std::max(top, level);
+        }
+    }
+    if (top == SUPER_ZERO) top = 0.0;
+
+    const std::size_t size = (m + width - 1) / width * kc * width;
+    panel.r.assign(size, 0.0);
+    panel.i.assign(size, 0.0);
+    panel.j.assign(size, 0.0);
+
+    bool hasI = false;
+    bool hasJ = false;
+    for (std::size_t p = 0; p < m; ++p) {
+        for (std::size_t k = 0; k < kc; ++k) {
+            const dspirit_parts x = get(p, k);
+            if (x.level == SUPER_ZERO) continue;
+            const int offset = levelOffset(top, x.level);
+            if (offset < 0) return;
+
+            // Компоненты на уровнях top, top - 1, top - 2
+            double c[3] = {0.0, 0.0, 0.0};
+            c[offset] = x.r;
+            if (offset < 2) c[offset + 1] = x.i;
+            if (offset < 1) c[2] = x.j;
+
+            const std::size_t at = ((p / width) * kc + k) * width + p % width;
+            panel.r[at] = c[0];
+            panel.i[at] = c[1];
+            panel.j[at] = c[2];
+            hasI = hasI || c[1] != 0.0;
+            hasJ = hasJ || c[2] != 0.0;
+        }
+    }
+    panel.level = top;
+    panel.fast = true;
+    panel.hasI = hasI;
+    panel.hasJ = hasJ;
+}
+
+// Микроядро: c += сумма a * b по kc шагам (блок MR x NR)
+void kernel(std::size_t kc, const double* a, const double* b, double* c) {
+    double acc[MR][NR];
+    for (std::size_t p = 0; p < MR; ++p) {
+        for (std::size_t q = 0; q < NR; ++q) acc[p][q] = c[p * NR + q];
+    }
+    for (std::size_t k = 0; k < kc; ++k, a += MR, b += NR) {
+        for (std::size_t p = 0; p < MR; ++p) {
+            for (std::size_t q = 0; q < NR; ++q) acc[p][q] += a[p] * b[q];
+        }
+    }
+    for (std::size_t p = 0; p < MR; ++p) {
+        for (std::size_t q = 0; q < NR; ++q) c[p * NR + q] = acc[p][q];
+    }
+}
+
+// Коэффициенты произведения как в Impl::multiply, по одному проходу
+// микроядра на пару плоскостей (нулевые плоскости пропускаются)
+void blockProduct(std::size_t kc, const packed_panel& a, std::size_t offsetA,
+                  const packed_panel& b, std::size_t offsetB, double* cr, double* ci, double* cj) {
+    std::fill(cr, cr + MR * NR, 0.0);
+    std::fill(ci, ci + MR * NR, 0.0);
+    std::fill(cj, cj + MR * NR, 0.0);
+
+    kernel(kc, &a.r[offsetA], &b.r[offsetB], cr);
+    if (b.hasI) kernel(kc, &a.r[offsetA], &b.i[offsetB], ci);
+    if (a.hasI) kernel(kc, &a.i[offsetA], &b.r[offsetB], ci);
+    if (b.hasJ) kernel(kc, &a.r[offsetA], &b.j[offsetB], cj);
+    if (a.hasI && b.hasI) kernel(kc, &a.i[offsetA], &b.i[offsetB], cj);
+    if (a.hasJ) kernel(kc, &a.j[offsetA], &b.r[offsetB], cj);
+}
+
+// Скалярное произведение цепочкой fma (n > 0)
+template <class GetA, class GetB>
+Impl dotScalar(std::size_t n, GetA getA, GetB getB) {
+    Impl acc = Impl::fromParts(getA(0)).multiply(Impl::fromParts(getB(0)));
+    for (std::size_t k = 1; k < n; ++k) {
+        acc = Impl::fromParts(getA(k)).fma(Impl::fromParts(getB(k)), acc);
+    }
+    return acc;
+}
+
+// Результат накопления в регистрах; переполнение - через fma
+template <class Fallback>
+Impl blockValue(double r, double i, double j, double level, Fallback fallback) {
+    if (std::isfinite(r) && std::isfinite(i) && std::isfinite(j)) return Impl(r, i, j, level);
+    return fallback();
+}
+
+struct gemm_workspace {
+    packed_panel a;
+    packed_panel b;
+    double cr[MR * NR];
+    double ci[MR * NR];
+    double cj[MR * NR];
+};
+
+bool isPlainParts(const dspirit_parts& x) {
+    return x.level == 0.0 && x.i == 0.0 && x.j == 0.0 && Impl::isPlainValue(x.r);
+}
+
+// c[i][j] = value, c[i][j] += value или c[i][j] -= value
+void storeResult(dspirit_matrix& c, std::size_t i, std::size_t j, const Impl& value, bool first, bool subtract) {
+    if (first && !subtract) {
+        c.set(i, j, value.parts());
+        return;
+    }
+    const dspirit_parts old = c.parts(i, j);
+    if (isPlainParts(old) && value.isPlainRegular()) {
+        const double sum = subtract ? old.r - value.r() : old.r + value.r();
+        if (Impl::isPlainValue(sum)) {
+            c.set(i, j, dspirit_parts{sum, 0.0, 0.0, 0.0});
+            return;
+        }
+    }
+    const Impl current = Impl::fromParts(old);
+    c.set(i, j, (subtract ? current.subtract(value) : current.add(value)).parts());
+}
+
+// Строки [row0, row1) произведения a * b в c со сдвигом (cRow, cCol):
+// для каждого блока столбцов и шага по k блок b упаковывается один раз и
+// используется всеми блоками строк
+void gemmRows(const matrix_block& a, const matrix_block& b, dspirit_matrix& c, std::size_t cRow, std::size_t cCol,
+              bool subtract, std::size_t row0, std::size_t row1, gemm_workspace& ws) {
+    const std::size_t depth = a.cols;
+    for (std::size_t col0 = 0; col0 < b.cols; col0 += NC) {
+        const std::size_t nc = std::min(NC, b.cols - col0);
+        for (std::size_t k0 = 0; k0 < depth; k0 += KC) {
+            const std::size_t kc = std::min(KC, depth - k0);
+            const bool first = (k0 == 0);
+
+            auto scalar = [&](std::size_t i, std::size_t j) {
+                return dotScalar(kc,
+                                 [&](std::size_t k) { return a.parts(i, k0 + k); },
+                                 [&](std::size_t k) { return b.parts(k0 + k, j); });
+            };
+            auto store = [&](std::size_t i, std::size_t j, const Impl& value) {
+                storeResult(c, cRow + i, cCol + j, value, first, subtract);
+            };
+
+            pack(ws.b, nc, kc, NR, [&](std::size_t p, std::size_t k) { return b.parts(k0 + k, col0 + p); });
+            for (std::size_t block = row0; block < row1; block += MC) {
+                const std::size_t mc = std::min(MC, row1 - block);
+                if (ws.b.fast) {
+                    pack(ws.a, mc, kc, MR, [&](std::size_t p, std::size_t k) { return a.parts(block + p, k0 + k); });
+                }
+
+                // Уровни не выравниваются: поэлементно
+                if (!ws.b.fast || !ws.a.fast) {
+                    for (std::size_t i = block; i < block + mc; ++i) {
+                        for (std::size_t j = col0; j < col0 + nc; ++j) store(i, j, scalar(i, j));
+                    }
+                    continue;
+                }
+
+                const double level = ws.a.level + ws.b.level;
+                for (std::size_t pb = 0; pb < nc; pb += NR) {
+                    for (std::size_t pa = 0; pa < mc; pa += MR) {
+                        blockProduct(kc, ws.a, pa * kc, ws.b, pb * kc, ws.cr, ws.ci, ws.cj);
+
+                        const std::size_t rows = std::min(MR, mc - pa);
+                        const std::size_t cols = std::min(NR, nc - pb);
+                        for (std::size_t p = 0; p < rows; ++p) {
+                            for (std::size_t q = 0; q < cols; ++q) {
+                                const std::size_t i = block + pa + p;
+                                const std::size_t j = col0 + pb + q;
+                                const std::size_t t = p * NR + q;
+                                store(i, j, blockValue(ws.cr[t], ws.ci[t], ws.cj[t], level, [&] { return scalar(i, j); }));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void checkSize(std::size_t a, std::size_t b) {
+    if (a != b) {
+        detail::raise(status::size_mismatch, "dspirit_matrix: size mismatch");
+    }
+}
+
+} // namespace
+
+// dspirit_matrix
+
+dspirit_matrix::dspirit_matrix(std::size_t rows, std::size_t cols, matrix_layout layout)
+    : rows_(rows), cols_(cols), layout_(layout), data_(rows * cols) {}
+
+dspirit_matrix::dspirit_matrix(std::size_t rows, std::size_t cols, const dspirit& value, matrix_layout layout)
+    : rows_(rows), cols_(cols), layout_(layout), data_(rows * cols, value) {}
+
+dspirit_matrix dspirit_matrix::identity(std::size_t n, matrix_layout layout) {
+    dspirit_matrix result(n, n, layout);
+    for (std::size_t k = 0; k < n; ++k) result.set(k, k, kernel::make(1.0));
+    return result;
+}
+
+// Умножение
+
+void detail::gemmBlock(const matrix_block& a, const matrix_block& b, dspirit_matrix& c,
+                       std::size_t row0, std::size_t col0, bool subtract, unsigned threads) {
+    const std::size_t m = a.rows;
+    const std::size_t n = b.cols;
+    if (a.cols == 0) {
+        if (subtract) return;
+        for (std::size_t i = 0; i < m; ++i) {
+            for (std::size_t j = 0; j < n; ++j) c.set(row0 + i, col0 + j, PARTS_ZERO);
+        }
+        return;
+    }
+
+    const std::size_t blocks = (m + MC - 1) / MC;
+    if (static_cast<double>(m) * n * a.cols < PARALLEL_WORK) threads = 1;
+
+    detail::parallelFor(blocks, threads, 1, [&](std::size_t begin, std::size_t end) {
+        gemm_workspace ws;
+        gemmRows(a, b, c, row0, col0, subtract, begin * MC, std::min(m, end * MC), ws);
+    });
+}
+
+void gemm(const dspirit_matrix& a, const dspirit_matrix& b, dspirit_matrix& c, unsigned threads) {
+    checkSize(a.cols(), b.rows());
+    checkSize(c.rows(), a.rows());
+    checkSize(c.cols(), b.cols());
+    detail::gemmBlock({&a, 0, 0, a.rows(), a.cols()}, {&b, 0, 0, b.rows(), b.cols()}, c, 0, 0, false, threads);
+}
+
+void gemv(const dspirit_matrix& a, const_dspirit_view x, dspirit_view y, unsigned threads) {
+    checkSize(x.size, a.cols());
+    checkSize(y.size, a.rows());
+
+    const std::size_t n = a.cols();
+    if (n == 0) {
+        for (std::size_t k = 0; k < y.size; ++k) y.store(k, PARTS_ZERO);
+        return;
+    }
+
+    packed_panel packedX;
+    pack(packedX, 1, n, 1, [&](std::size_t, std::size_t k) { return x[k]; });
+    if (static_cast<double>(a.rows()) * n < PARALLEL_WORK) threads = 1;
+
+    detail::parallelFor(a.rows(), threads, ROWS_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        packed_panel row;
+        for (std::size_t i = begin; i < end; ++i) {
+            auto scalar = [&] {
+                return dotScalar(n, [&](std::size_t k) { return a.parts(i, k); }, [&](std::size_t k) { return x[k]; });
+            };
+
+            if (packedX.fast) pack(row, 1, n, 1, [&](std::size_t, std::size_t k) { return a.parts(i, k); });
+            if (!packedX.fast || !row.fast) {
+                y.store(i, scalar().parts());
+                continue;
+            }
+
+            // Четыре независимые суммы, чтобы цикл не упирался в задержку сложения
+            double r[4] = {}, ii[4] = {}, jj[4] = {};
+            const double* ar = row.r.data();
+            const double* xr = packedX.r.data();
+            if (!row.hasI && !row.hasJ && !packedX.hasI && !packedX.hasJ) {
+                for (std::size_t k = 0; k < n; ++k) r[k % 4] += ar[k] * xr[k];
+            } else {
+                const double* ai = row.i.data();
+                const double* aj = row.j.data();
+                const double* xi = packedX.i.data();
+                const double* xj = packedX.j.data();
+                for (std::size_t k = 0; k < n; ++k) {
+                    r[k % 4] += ar[k] * xr[k];
+                    ii[k % 4] += ar[k] * xi[k] + ai[k] * xr[k];
+                    jj[k % 4] += ar[k] * xj[k] + ai[k] * xi[k] + aj[k] * xr[k];
+                }
+            }
+            const double level = row.level + packedX.level;
+            y.store(i, blockValue((r[0] + r[1]) + (r[2] + r[3]), (ii[0] + ii[1]) + (ii[2] + ii[3]),
+                                  (jj[0] + jj[1]) + (jj[2] + jj[3]), level, scalar).parts());
+        }
+    });
+}
+
+dspirit_matrix operator*(const dspirit_matrix& a, const dspirit_matrix& b) {
+    dspirit_matrix result(a.rows(), b.cols());
+    gemm(a, b, result);
+    return result;
+}
+
+dspirit_array operator*(const dspirit_matrix& a, const dspirit_array& x) {
+    dspirit_array result(a.rows());
+    gemv(a, x.view(), result.view());
+    return result;
+}
+
+} // namespace paradox
@@ -0,0 +1,33 @@
+#ifndef PARADOX_MATRIX_BLOCK_H
+#define PARADOX_MATRIX_BLOCK_H
+
+// Внутренний заголовок: умножение подматриц для блочных алгоритмов.
+
+#include "paradox/matrix.h"
+
+#include <cstddef>
+
+namespace paradox {
+namespace detail {
+
+// Подматрица [row0, row0 + rows) x [col0, col0 + cols)
+struct matrix_block {
+    const dspirit_matrix* matrix;
+    std::size_t row0;
+    std::size_t col0;
+    std::size_t rows;
+    std::size_t cols;
+
+    dspirit_parts parts(std::size_t i, std::size_t j) const { return matrix->parts(row0 + i, col0 + j); }
+};
+
+// c[row0 + i][col0 + j] = (a * b)[i][j], при subtract - вычитается из c.
+// Блок c (a.rows x b.cols) не пересекается с a и b, но может лежать в
+// той же матрице. Строки делятся между threads потоками
+void gemmBlock(const matrix_block& a, const matrix_block& b, dspirit_matrix& c,
+               std::size_t row0, std::size_t col0, bool subtract, unsigned threads);
+
+} // namespace detail
+} // namespace paradox
+
+#endif // PARADOX_MATRIX_BLOCK_H
@@ -0,0 +1,334 @@
+#ifdef _WIN32
+#define PARADOX_DSPIRIT_EXPORTS
+#endif
+
+#include "paradox/paradox_c.h"
+#include "paradox/dspirit_array.h"
+#include "paradox/kernel.h"
+#include "dspirit_impl.h"
+
+#include <cstddef>
+#include <limits>
+
+using paradox::dspirit_parts;
+using paradox::status;
+using paradox::detail::Impl;
+
+// paradox_value и dspirit_parts - одна и та же раскладка
+static_assert(sizeof(paradox_value) == sizeof(dspirit_parts), "paradox_value layout");
+static_assert(offsetof(paradox_value, level) == offsetof(dspirit_parts, level), "paradox_value layout");
+static_assert(PARADOX_DOMAIN_ERROR == static_cast<int>(status::domain_error) &&
+              PARADOX_INVALID_ARGUMENT == static_cast<int>(status::invalid_argument) &&
+              PARADOX_SIZE_MISMATCH == static_cast<int>(status::size_mismatch) &&
+              PARADOX_CORRUPT_DATA == static_cast<int>(status::corrupt_data) &&
+              PARADOX_IO_ERROR == static_cast<int>(status::io_error),
+              "paradox_status values");
+static_assert(PARADOX_FORMAT_SHORTEST == static_cast<int>(paradox::text_format::shortest) &&
+              PARADOX_FORMAT_LOSSLESS == static_cast<int>(paradox::text_format::lossless),
+              "paradox_format values");
+static_assert(PARADOX_MAX_CHARS >= paradox::dspirit::MAX_CHARS, "PARADOX_MAX_CHARS");
+
+namespace {
+
+Impl wrap(const paradox_value& x) {
+    return Impl::fromParts({x.r, x.i, x.j, x.level});
+}
+
+paradox_value unwrap(const Impl& x) {
+    const dspirit_parts p = x.parts();
+    return {p.r, p.i, p.j, p.level};
+}
+
+dspirit_parts parts(const paradox_value& x) {
+    return {x.r, x.i, x.j, x.level};
+}
+
+paradox_value value(const dspirit_parts& p) {
+    return {p.r, p.i, p.j, p.level};
+}
+
+paradox_status code(status s) {
+    return static_cast<paradox_status>(s);
+}
+
+const paradox_value FAILED = {std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0};
+
+int32_t compare(const Impl& a, const Impl& b) {
+    if (a.lessThan(b)) return -1;
+    if (b.lessThan(a)) return 1;
+    return 0;
+}
+
+// Функция по коду; false - неизвестный код
+bool apply(paradox_function fn, const dspirit_parts& x, dspirit_parts& out, status& result) {
+    using namespace paradox;
+    switch (fn) {
+    case PARADOX_SQRT: result = kernel::sqrt(x, out); return true;
+    case PARADOX_EXP: result = kernel::exp(x, out); return true;
+    case PARADOX_LOG: result = kernel::log(x, out); return true;
+    case PARADOX_SIN: result = kernel::sin(x, out); return true;
+    case PARADOX_COS: result = kernel::cos(x, out); return true;
+    case PARADOX_TAN: result = kernel::tan(x, out); return true;
+    case PARADOX_SINH: result = kernel::sinh(x, out); return true;
+    case PARADOX_COSH: result = kernel::cosh(x, out); return true;
+    case PARADOX_TANH: result = kernel::tanh(x, out); return true;
+    case PARADOX_CBRT: result = kernel::cbrt(x, out); return true;
+    case PARADOX_ERF: result = kernel::erf(x, out); return true;
+    case PARADOX_LOG1P: result = kernel::log1p(x, out); return true;
+    case PARADOX_EXPM1: result = kernel::expm1(x, out); return true;
+    case PARADOX_ABS: out = kernel::abs(x); result = status::ok; return true;
+    case PARADOX_INVERSE: out = kernel::inverse(x); result = status::ok; return true;
+    }
+    return false;
+}
+
+// Поэлементная операция над n значениями; NULL допустим только при n == 0
+template <class Op>
+paradox_status binary(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n, Op op) {
+    if (n != 0 && (!a || !b || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = unwrap(op(wrap(a[k]), wrap(b[k])));
+    return PARADOX_OK;
+}
+
+// Индекс первого элемента, лучшего по better(x, best)
+template <class Better>
+paradox_status select(const paradox_value* x, size_t n, paradox_value* out, size_t* index, Better better) {
+    if (n == 0 || !x || !out) return PARADOX_INVALID_ARGUMENT;
+    size_t found = 0;
+    Impl best = wrap(x[0]);
+    for (size_t k = 1; k < n; ++k) {
+        const Impl candidate = wrap(x[k]);
+        if (better(candidate, best)) {
+            best = candidate;
+            found = k;
+        }
+    }
+    *out = x[found];
+    if (index) *index = found;
+    return PARADOX_OK;
+}
+
+} // namespace
+
+extern "C" {
+
+int32_t paradox_abi_version(void) {
+    return PARADOX_C_ABI_VERSION;
+}
+
+// Скалярные операции
+
+paradox_value paradox_from_double(double value) {
+    return unwrap(Impl(value));
+}
+
+paradox_value paradox_from_level(double value, double level) {
+    return unwrap(Impl(value, level));
+}
+
+double paradox_to_double(paradox_value x) {
+    return wrap(x).toDouble();
+}
+
+paradox_value paradox_neg(paradox_value x) {
+    return unwrap(wrap(x).negate());
+}
+
+paradox_value paradox_add(paradox_value a, paradox_value b) {
+    return unwrap(wrap(a).add(wrap(b)));
+}
+
+paradox_value paradox_sub(paradox_value a, paradox_value b) {
+    return unwrap(wrap(a).subtract(wrap(b)));
+}
+
+paradox_value paradox_mul(paradox_value a, paradox_value b) {
+    return unwrap(wrap(a).multiply(wrap(b)));
+}
+
+paradox_value paradox_div(paradox_value a, paradox_value b) {
+    return unwrap(wrap(a).divide(wrap(b)));
+}
+
+int32_t paradox_compare(paradox_value a, paradox_value b) {
+    return compare(wrap(a), wrap(b));
+}
+
+paradox_status paradox_apply(paradox_function fn, paradox_value x, paradox_value* out) {
+    if (!out) return PARADOX_INVALID_ARGUMENT;
+    dspirit_parts result;
+    status s;
+    if (!apply(fn, parts(x), result, s)) return PARADOX_INVALID_ARGUMENT;
+    *out = (s == status::ok) ? value(result) : FAILED;
+    return code(s);
+}
+
+paradox_status paradox_pow(paradox_value x, double exponent, paradox_value* out) {
+    if (!out) return PARADOX_INVALID_ARGUMENT;
+    dspirit_parts result;
+    const status s = paradox::kernel::pow(parts(x), exponent, result);
+    *out = (s == status::ok) ? value(result) : FAILED;
+    return code(s);
+}
+
+paradox_status paradox_parse(const char* text, size_t length, paradox_value* out) {
+    if (!out || (!text && length != 0) || length == 0) return PARADOX_INVALID_ARGUMENT;
+    Impl result;
+    const std::from_chars_result res = paradox::detail::parseChars(text, text + length, result);
+    if (res.ec != std::errc() || res.ptr != text + length) return PARADOX_INVALID_ARGUMENT;
+    *out = unwrap(result);
+    return PARADOX_OK;
+}
+
+paradox_status paradox_format_value(paradox_value x, paradox_format format, char* buffer, size_t capacity,
+                                    size_t* length) {
+    if (!buffer || capacity == 0) return PARADOX_INVALID_ARGUMENT;
+    if (format < PARADOX_FORMAT_COMPACT || format > PARADOX_FORMAT_LOSSLESS) return PARADOX_INVALID_ARGUMENT;
+    const std::to_chars_result res = paradox::detail::formatChars(buffer, buffer + capacity - 1, wrap(x),
+                                                                  static_cast<paradox::text_format>(format));
+    if (res.ec != std::errc()) {
+        buffer[0] = '\0';
+        return PARADOX_INVALID_ARGUMENT;
+    }
+    *res.ptr = '\0';
+    if (length) *length = static_cast<size_t>(res.ptr - buffer);
+    return PARADOX_OK;
+}
+
+// Пакетные операции
+
+paradox_status paradox_neg_n(const paradox_value* x, paradox_value* out, size_t n) {
+    if (n != 0 && (!x || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = unwrap(wrap(x[k]).negate());
+    return PARADOX_OK;
+}
+
+paradox_status paradox_add_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n) {
+    return binary(a, b, out, n, [](const Impl& x, const Impl& y) { return x.add(y); });
+}
+
+paradox_status paradox_sub_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n) {
+    return binary(a, b, out, n, [](const Impl& x, const Impl& y) { return x.subtract(y); });
+}
+
+paradox_status paradox_mul_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n) {
+    return binary(a, b, out, n, [](const Impl& x, const Impl& y) { return x.multiply(y); });
+}
+
+paradox_status paradox_div_n(const paradox_value* a, const paradox_value* b, paradox_value* out, size_t n) {
+    return binary(a, b, out, n, [](const Impl& x, const Impl& y) { return x.divide(y); });
+}
+
+paradox_status paradox_fma_n(const paradox_value* a, const paradox_value* b, const paradox_value* c,
+                             paradox_value* out, size_t n) {
+    if (n != 0 && (!a || !b || !c || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = unwrap(wrap(a[k]).fma(wrap(b[k]), wrap(c[k])));
+    return PARADOX_OK;
+}
+
+paradox_status paradox_compare_n(const paradox_value* a, const paradox_value* b, int8_t* out, size_t n) {
+    if (n != 0 && (!a || !b || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = static_cast<int8_t>(compare(wrap(a[k]), wrap(b[k])));
+    return PARADOX_OK;
+}
+
+paradox_status paradox_apply_n(paradox_function fn, const paradox_value* x, paradox_value* out, size_t n,
+                               size_t* failed) {
+    if (n != 0 && (!x || !out)) return PARADOX_INVALID_ARGUMENT;
+    dspirit_parts probe;
+    status s;
+    if (!apply(fn, paradox::kernel::make(1.0), probe, s)) return PARADOX_INVALID_ARGUMENT;
+
+    size_t count = 0;
+    for (size_t k = 0; k < n; ++k) {
+        dspirit_parts result;
+        apply(fn, parts(x[k]), result, s);
+        if (s == status::ok) {
+            out[k] = value(result);
+        } else {
+            out[k] = FAILED;
+            ++count;
+        }
+    }
+    if (failed) *failed = count;
+    return count == 0 ? PARADOX_OK : PARADOX_DOMAIN_ERROR;
+}
+
+paradox_status paradox_pow_n(const paradox_value* x, double exponent, paradox_value* out, size_t n,
+                             size_t* failed) {
+    if (n != 0 && (!x || !out)) return PARADOX_INVALID_ARGUMENT;
+    size_t count = 0;
+    for (size_t k = 0; k < n; ++k) {
+        dspirit_parts result;
+        if (paradox::kernel::pow(parts(x[k]), exponent, result) == status::ok) {
+            out[k] = value(result);
+        } else {
+            out[k] = FAILED;
+            ++count;
+        }
+    }
+    if (failed) *failed = count;
+    return count == 0 ? PARADOX_OK : PARADOX_DOMAIN_ERROR;
+}
+
+// Свёртки
+
+paradox_status paradox_sum_n(const paradox_value* x, size_t n, paradox_value* out) {
+    if (!out || (n != 0 && !x)) return PARADOX_INVALID_ARGUMENT;
+    Impl total(0.0);
+    for (size_t k = 0; k < n; ++k) total = total.add(wrap(x[k]));
+    *out = unwrap(total);
+    return PARADOX_OK;
+}
+
+paradox_status paradox_product_n(const paradox_value* x, size_t n, paradox_value* out) {
+    if (!out || (n != 0 && !x)) return PARADOX_INVALID_ARGUMENT;
+    Impl total(1.0);
+    for (size_t k = 0; k < n; ++k) total = total.multiply(wrap(x[k]));
+    *out = unwrap(total);
+    return PARADOX_OK;
+}
+
+paradox_status paradox_min_n(const paradox_value* x, size_t n, paradox_value* out, size_t* index) {
+    return select(x, n, out, index, [](const Impl& a, const Impl& b) { return a.lessThan(b); });
+}
+
+paradox_status paradox_max_n(const paradox_value* x, size_t n, paradox_value* out, size_t* index) {
+    return select(x, n, out, index, [](const Impl& a, const Impl& b) { return b.lessThan(a); });
+}
+
+// Преобразования
+
+paradox_status paradox_from_doubles(const double* x, paradox_value* out, size_t n) {
+    if (n != 0 && (!x || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = unwrap(Impl(x[k]));
+    return PARADOX_OK;
+}
+
+paradox_status paradox_to_doubles(const paradox_value* x, double* out, size_t n) {
+    if (n != 0 && (!x || !out)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) out[k] = wrap(x[k]).toDouble();
+    return PARADOX_OK;
+}
+
+paradox_status paradox_from_planes(const double* r, const double* i, const double* j, const double* level,
+                                   paradox_value* out, size_t n) {
+    if (n != 0 && (!r || !out)) return PARADOX_INVALID_ARGUMENT;
+    const paradox::const_dspirit_view view = {r, i, j, level, n};
+    for (size_t k = 0; k < n; ++k) out[k] = value(view[k]);
+    return PARADOX_OK;
+}
+
+paradox_status paradox_to_planes(const paradox_value* x, double* r, double* i, double* j, double* level,
+                                 size_t n) {
+    if (n != 0 && (!x || !r || !i || !j || !level)) return PARADOX_INVALID_ARGUMENT;
+    for (size_t k = 0; k < n; ++k) {
+        r[k] = x[k].r;
+        i[k] = x[k].i;
+        j[k] = x[k].j;
+        level[k] = x[k].level;
+    }
+    return PARADOX_OK;
+}
+
+} // extern "C"
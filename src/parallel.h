@@ -0,0 +1,69 @@
+#ifndef PARADOX_PARALLEL_H
+#define PARADOX_PARALLEL_H
+
+// Внутренний заголовок: простое распараллеливание циклов на std::thread.
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace paradox {
+namespace detail {
+
+// Число потоков: 0 - по числу аппаратных потоков
+inline unsigned threadCount(unsigned requested) {
+    if (requested != 0) return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+// Делит [0, n) на непрерывные диапазоны и вызывает body(begin, end) в
+// нескольких потоках. Диапазоны короче grain не дробятся. Первое
+// исключение из потоков пробрасывается вызывающему (кроме режима
+// PARADOX_NO_EXCEPTIONS).
+template <class Body>
+void parallelFor(std::size_t n, unsigned threads, std::size_t grain, Body body) {
+    if (n == 0) return;
+    std::size_t parts = std::min<std::size_t>(threadCount(threads), (n + grain - 1) / grain);
+    if (parts <= 1) {
+        body(std::size_t(0), n);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(parts);
+    std::vector<std::thread> pool;
+    pool.reserve(parts - 1);
+
+    const std::size_t step = (n + parts - 1) / parts;
+    auto run = [&](std::size_t part) {
+        const std::size_t begin = part * step;
+        const std::size_t end = std::min(n, begin + step);
+        if (begin >= end) return;
+#ifdef PARADOX_NO_EXCEPTIONS
+        body(begin, end);
+#else
+        try {
+            body(begin, end);
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+#endif
+    };
+
+    for (std::size_t part = 1; part < parts; ++part) pool.emplace_back(run, part);
+    run(0);
+    for (std::thread& t : pool) t.join();
+
+#ifndef PARADOX_NO_EXCEPTIONS
+    for (const std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+#endif
+}
+
+} // namespace detail
+} // namespace paradox
+
+#endif // PARADOX_PARALLEL_H
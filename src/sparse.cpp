@@ -0,0 +1,378 @@
+#include "paradox/sparse.h"
+#include "dspirit_impl.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace paradox {
+
+using detail::Impl;
+
+namespace {
+
+// Строк на поток в spmv
+const std::size_t ROWS_PER_THREAD = 1024;
+
+// Число хранимых элементов, начиная с которого spmv делится между потоками
+const std::size_t PARALLEL_NON_ZEROS = 1 << 16;
+
+const dspirit_parts PARTS_ZERO = {1.0, 0.0, 0.0, -1.0};
+const double SUPER_ZERO = -std::numeric_limits<double>::infinity();
+
+bool isPlainParts(const dspirit_parts& x) {
+    return x.level == 0.0 && x.i == 0.0 && x.j == 0.0 && Impl::isPlainValue(x.r);
+}
+
+// Элемент хранится, если он не ниже нулевого уровня
+bool isStored(const dspirit_parts& x) {
+    return !(x.level < 0.0);
+}
+
+// a + b
+dspirit_parts addParts(const dspirit_parts& a, const dspirit_parts& b) {
+    if (isPlainParts(a) && isPlainParts(b)) {
+        const double r = a.r + b.r;
+        if (Impl::isPlainValue(r)) return {r, 0.0, 0.0, 0.0};
+    }
+    return Impl::fromParts(a).add(Impl::fromParts(b)).parts();
+}
+
+// Сдвиг уровня относительно старшего: 0, 1, 2 или -1 (не выровнен)
+int levelOffset(double top, double level) {
+    const double diff = top - level;
+    for (int k = 0; k < 3; ++k) {
+        if (std::abs(diff - k) < DBL_EPSILON) return k;
+    }
+    return -1;
+}
+
+// Обходит элементы строк [row0, row1): body(i, j, k), k - номер элемента в
+// values(). Внутри строки столбцы идут по возрастанию
+template <class Body>
+void forEachInRows(const sparse_matrix& a, std::size_t row0, std::size_t row1, Body body) {
+    const std::size_t* offsets = a.offsets().data();
+    const std::size_t* indices = a.indices().data();
+    if (a.layout() == matrix_layout::row_major) {
+        for (std::size_t i = row0; i < row1; ++i) {
+            for (std::size_t k = offsets[i]; k < offsets[i + 1]; ++k) body(i, indices[k], k);
+        }
+        return;
+    }
+    for (std::size_t j = 0; j < a.cols(); ++j) {
+        const std::size_t end = offsets[j + 1];
+        std::size_t k = std::lower_bound(indices + offsets[j], indices + end, row0) - indices;
+        for (; k < end && indices[k] < row1; ++k) body(indices[k], j, k);
+    }
+}
+
+// Строка i цепочкой fma
+Impl rowScalar(const sparse_matrix& a, const_dspirit_view x, std::size_t i) {
+    bool first = true;
+    Impl acc;
+    forEachInRows(a, i, i + 1, [&](std::size_t, std::size_t j, std::size_t k) {
+        const Impl product = Impl::fromParts(a.values().parts(k));
+        acc = first ? product.multiply(Impl::fromParts(x[j])) : product.fma(Impl::fromParts(x[j]), acc);
+        first = false;
+    });
+    return first ? Impl::fromParts(PARTS_ZERO) : acc;
+}
+
+// Строки обычной CSR-матрицы при обычном x: одна плоскость, четыре
+// независимые суммы. Строки, сумма которых вышла из обычных чисел,
+// пересчитываются в общем пути
+void multiplyPlainRows(const sparse_matrix& a, const_dspirit_view x, dspirit_view y,
+                       std::size_t row0, std::size_t row1) {
+    const std::size_t* offsets = a.offsets().data();
+    const std::size_t* indices = a.indices().data();
+    const double* values = a.values().r();
+    for (std::size_t i = row0; i < row1; ++i) {
+        const std::size_t begin = offsets[i];
+        const std::size_t end = offsets[i + 1];
+        if (begin == end) {
+            y.store(i, PARTS_ZERO);
+            continue;
+        }
+        double s[4] = {};
+        std::size_t k = begin;
+        for (; k + 4 <= end; k += 4) {
+            s[0] += values[k] * x.r[indices[k]];
+            s[1] += values[k + 1] * x.r[indices[k + 1]];
+            s[2] += values[k + 2] * x.r[indices[k + 2]];
+            s[3] += values[k + 3] * x.r[indices[k + 3]];
+        }
+        for (; k < end; ++k) s[(k - begin) & 3] += values[k] * x.r[indices[k]];
+        const double sum = (s[0] + s[1]) + (s[2] + s[3]);
+        y.store(i, Impl::isPlainValue(sum) ? dspirit_parts{sum, 0.0, 0.0, 0.0} : rowScalar(a, x, i).parts());
+    }
+}
+
+// Строки [row0, row1) в общем случае: первый проход находит старший
+// уровень произведений строки, второй складывает компоненты на уровнях
+// top, top - 1, top - 2
+void multiplyRows(const sparse_matrix& a, const_dspirit_view x, dspirit_view y,
+                  std::size_t row0, std::size_t row1) {
+    enum : unsigned char { empty, aligned, scalar };
+    const std::size_t m = row1 - row0;
+    std::vector<double> top(m, SUPER_ZERO);
+    std::vector<unsigned char> state(m, empty);
+    const dspirit_array& values = a.values();
+
+    forEachInRows(a, row0, row1, [&](std::size_t i, std::size_t j, std::size_t k) {
+        const std::size_t p = i - row0;
+        if (state[p] == empty) state[p] = aligned;
+        const double la = values.level()[k];
+        const double lx = x[j].level;
+        if (lx == SUPER_ZERO && !Impl::isSuperLevel(la)) return;
+        if (Impl::isSuperLevel(la) || Impl::isSuperLevel(lx) || std::isnan(la + lx)) {
+            state[p] = scalar;
+            return;
+        }
+        top[p] = std::max(top[p], la + lx);
+    });
+
+    std::vector<double> r(m, 0.0), ii(m, 0.0), jj(m, 0.0);
+    forEachInRows(a, row0, row1, [&](std::size_t i, std::size_t j, std::size_t k) {
+        const std::size_t p = i - row0;
+        if (state[p] != aligned) return;
+        const dspirit_parts v = values.parts(k);
+        const dspirit_parts u = x[j];
+        if (u.level == SUPER_ZERO) return;
+        const int offset = levelOffset(top[p], v.level + u.level);
+        if (offset < 0) {
+            state[p] = scalar;
+            return;
+        }
+
+        // Компоненты произведения как в Impl::multiply
+        const double c[3] = {v.r * u.r, v.r * u.i + v.i * u.r, v.r * u.j + v.i * u.i + v.j * u.r};
+        double* sum[3] = {&r[p], &ii[p], &jj[p]};
+        for (int q = 0; q + offset < 3; ++q) *sum[q + offset] += c[q];
+    });
+
+    for (std::size_t p = 0; p < m; ++p) {
+        const std::size_t i = row0 + p;
+        if (state[p] == empty) {
+            y.store(i, PARTS_ZERO);
+        } else if (state[p] == aligned && top[p] != SUPER_ZERO &&
+                   std::isfinite(r[p]) && std::isfinite(ii[p]) && std::isfinite(jj[p])) {
+            y.store(i, Impl(r[p], ii[p], jj[p], top[p]).parts());
+        } else {
+            y.store(i, rowScalar(a, x, i).parts());
+        }
+    }
+}
+
+bool isPlainView(const_dspirit_view x) {
+    if (x.isPlain()) {
+        for (std::size_t k = 0; k < x.size; ++k) {
+            if (!Impl::isPlainValue(x.r[k])) return false;
+        }
+        return true;
+    }
+    for (std::size_t k = 0; k < x.size; ++k) {
+        if (!isPlainParts(x[k])) return false;
+    }
+    return true;
+}
+
+void checkSize(std::size_t a, std::size_t b) {
+    if (a != b) {
+        detail::raise(status::size_mismatch, "sparse_matrix: size mismatch");
+    }
+}
+
+} // namespace
+
+// Доступ к элементам
+
+dspirit_parts sparse_matrix::parts(std::size_t i, std::size_t j) const {
+    const bool rowMajor = (layout_ == matrix_layout::row_major);
+    const std::size_t outer = rowMajor ? i : j;
+    const std::size_t inner = rowMajor ? j : i;
+    const std::size_t* begin = indices_.data() + offsets_[outer];
+    const std::size_t* end = indices_.data() + offsets_[outer + 1];
+    const std::size_t* at = std::lower_bound(begin, end, inner);
+    if (at == end || *at != inner) return PARTS_ZERO;
+    return values_.parts(at - indices_.data());
+}
+
+dspirit sparse_matrix::operator()(std::size_t i, std::size_t j) const {
+    return dspirit::fromParts(parts(i, j));
+}
+
+// Преобразования
+
+sparse_matrix sparse_matrix::convert(matrix_layout layout) const {
+    if (layout == layout_) return *this;
+
+    sparse_matrix result;
+    result.rows_ = rows_;
+    result.cols_ = cols_;
+    result.layout_ = layout;
+    result.plain_ = plain_;
+
+    const std::size_t outer = (layout_ == matrix_layout::row_major) ? rows_ : cols_;
+    const std::size_t newOuter = (layout == matrix_layout::row_major) ? rows_ : cols_;
+    result.offsets_.assign(newOuter + 1, 0);
+    for (std::size_t index : indices_) ++result.offsets_[index + 1];
+    for (std::size_t k = 0; k < newOuter; ++k) result.offsets_[k + 1] += result.offsets_[k];
+
+    // Проход по старым строкам по возрастанию сразу даёт упорядоченные индексы
+    std::vector<std::size_t> next(result.offsets_.begin(), result.offsets_.end() - 1);
+    result.indices_.resize(indices_.size());
+    result.values_.resize(indices_.size());
+    for (std::size_t o = 0; o < outer; ++o) {
+        for (std::size_t k = offsets_[o]; k < offsets_[o + 1]; ++k) {
+            const std::size_t at = next[indices_[k]]++;
+            result.indices_[at] = o;
+            result.values_.set(at, values_.parts(k));
+        }
+    }
+    return result;
+}
+
+dspirit_matrix sparse_matrix::toDense(matrix_layout layout) const {
+    dspirit_matrix result(rows_, cols_, layout);
+    const bool rowMajor = (layout_ == matrix_layout::row_major);
+    const std::size_t outer = rowMajor ? rows_ : cols_;
+    for (std::size_t o = 0; o < outer; ++o) {
+        for (std::size_t k = offsets_[o]; k < offsets_[o + 1]; ++k) {
+            const std::size_t i = rowMajor ? o : indices_[k];
+            const std::size_t j = rowMajor ? indices_[k] : o;
+            result.set(i, j, values_.parts(k));
+        }
+    }
+    return result;
+}
+
+sparse_matrix sparse_matrix::fromDense(const dspirit_matrix& a, matrix_layout layout) {
+    sparse_matrix result;
+    result.rows_ = a.rows();
+    result.cols_ = a.cols();
+    result.layout_ = layout;
+
+    const bool rowMajor = (layout == matrix_layout::row_major);
+    const std::size_t outer = rowMajor ? a.rows() : a.cols();
+    const std::size_t inner = rowMajor ? a.cols() : a.rows();
+    result.offsets_.reserve(outer + 1);
+    for (std::size_t o = 0; o < outer; ++o) {
+        for (std::size_t k = 0; k < inner; ++k) {
+            const dspirit_parts x = rowMajor ? a.parts(o, k) : a.parts(k, o);
+            if (!isStored(x)) continue;
+            result.indices_.push_back(k);
+            result.values_.push_back(x);
+            result.plain_ = result.plain_ && isPlainParts(x);
+        }
+        result.offsets_.push_back(result.indices_.size());
+    }
+    return result;
+}
+
+// Построитель
+
+sparse_builder::sparse_builder(std::size_t rows, std::size_t cols) : rows_(rows), cols_(cols) {}
+
+void sparse_builder::reserve(std::size_t n) {
+    rowIndices_.reserve(n);
+    colIndices_.reserve(n);
+    values_.reserve(n);
+}
+
+void sparse_builder::clear() {
+    rowIndices_.clear();
+    colIndices_.clear();
+    values_.clear();
+}
+
+void sparse_builder::add(std::size_t i, std::size_t j, const dspirit& value) {
+    add(i, j, value.toParts());
+}
+
+void sparse_builder::add(std::size_t i, std::size_t j, const dspirit_parts& value) {
+    if (i >= rows_ || j >= cols_) {
+        detail::raise(status::invalid_argument, "sparse_builder: index out of range");
+    }
+    rowIndices_.push_back(i);
+    colIndices_.push_back(j);
+    values_.push_back(value);
+}
+
+sparse_matrix sparse_builder::build(matrix_layout layout) const {
+    const bool rowMajor = (layout == matrix_layout::row_major);
+    const std::vector<std::size_t>& outerIndices = rowMajor ? rowIndices_ : colIndices_;
+    const std::vector<std::size_t>& innerIndices = rowMajor ? colIndices_ : rowIndices_;
+    const std::size_t outer = rowMajor ? rows_ : cols_;
+    const std::size_t inner = rowMajor ? cols_ : rows_;
+    const std::size_t n = size();
+
+    // Две устойчивые сортировки подсчётом: по внутреннему индексу, затем по
+    // внешнему. Повторы остаются в порядке добавления
+    auto countingSort = [n](const std::vector<std::size_t>& keys, std::size_t range,
+                            const std::vector<std::size_t>& order) {
+        std::vector<std::size_t> start(range + 1, 0);
+        for (std::size_t k = 0; k < n; ++k) ++start[keys[k] + 1];
+        for (std::size_t k = 0; k < range; ++k) start[k + 1] += start[k];
+        std::vector<std::size_t> sorted(n);
+        for (std::size_t k : order) sorted[start[keys[k]]++] = k;
+        return sorted;
+    };
+    std::vector<std::size_t> order(n);
+    for (std::size_t k = 0; k < n; ++k) order[k] = k;
+    order = countingSort(innerIndices, inner, order);
+    order = countingSort(outerIndices, outer, order);
+
+    sparse_matrix result;
+    result.rows_ = rows_;
+    result.cols_ = cols_;
+    result.layout_ = layout;
+    result.offsets_.assign(outer + 1, 0);
+    result.indices_.reserve(n);
+    result.values_.reserve(n);
+
+    std::size_t k = 0;
+    for (std::size_t o = 0; o < outer; ++o) {
+        while (k < n && outerIndices[order[k]] == o) {
+            const std::size_t index = innerIndices[order[k]];
+            dspirit_parts sum = values_.parts(order[k]);
+            for (++k; k < n && outerIndices[order[k]] == o && innerIndices[order[k]] == index; ++k) {
+                sum = addParts(sum, values_.parts(order[k]));
+            }
+            if (!isStored(sum)) continue;
+            result.indices_.push_back(index);
+            result.values_.push_back(sum);
+            result.plain_ = result.plain_ && isPlainParts(sum);
+        }
+        result.offsets_[o + 1] = result.indices_.size();
+    }
+    return result;
+}
+
+// Умножение на вектор
+
+void spmv(const sparse_matrix& a, const_dspirit_view x, dspirit_view y, unsigned threads) {
+    checkSize(x.size, a.cols());
+    checkSize(y.size, a.rows());
+
+    const bool plain = a.plain() && a.layout() == matrix_layout::row_major && isPlainView(x);
+    if (a.nonZeros() < PARALLEL_NON_ZEROS) threads = 1;
+
+    detail::parallelFor(a.rows(), threads, ROWS_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        if (plain) {
+            multiplyPlainRows(a, x, y, begin, end);
+        } else {
+            multiplyRows(a, x, y, begin, end);
+        }
+    });
+}
+
+dspirit_array operator*(const sparse_matrix& a, const dspirit_array& x) {
+    dspirit_array result(a.rows());
+    spmv(a, x.view(), result.view());
+    return result;
+}
+
+} // namespace paradox
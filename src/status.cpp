@@ -0,0 +1,42 @@
+#include "paradox/status.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace paradox {
+
+const char* statusMessage(status code) {
+    switch (code) {
+    case status::ok: return "ok";
+    case status::domain_error: return "domain error";
+    case status::invalid_argument: return "invalid argument";
+    case status::size_mismatch: return "size mismatch";
+    case status::corrupt_data: return "corrupt data";
+    case status::io_error: return "i/o error";
+    }
+    return "unknown status";
+}
+
+namespace detail {
+
+void raise(status code, const char* message) {
+#ifdef PARADOX_NO_EXCEPTIONS
+    std::fprintf(stderr, "paradox: %s (%s)\n", message, statusMessage(code));
+    std::abort();
+#else
+    switch (code) {
+    case status::domain_error:
+        throw std::domain_error(message);
+    case status::invalid_argument:
+    case status::size_mismatch:
+        throw std::invalid_argument(message);
+    default:
+        throw std::runtime_error(message);
+    }
+#endif
+}
+
+} // namespace detail
+
+} // namespace paradox